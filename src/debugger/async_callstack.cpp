@@ -0,0 +1,511 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <map>
+#include <unordered_map>
+#include "debugger/async_callstack.h"
+#include "debugger/heapwalker.h"
+#include "debugger/valueprint.h"
+#include "metadata/async_info.h"
+#include "metadata/modules.h"
+#include "metadata/typeprinter.h"
+#include "utils/filesystem.h"
+#include "utils/torelease.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+// Protect from broken (or cyclic) continuation chains.
+static const int MaxAsyncFrames = 100;
+static const int MaxContinuationDepth = 8;
+// Keep only first tasks for group, group could have thousands of tasks.
+static const size_t MaxTasksInGroup = 32;
+
+HRESULT AsyncCallStack::GetTypeFields(ICorDebugClass *pClass, TypeFields &typeFields)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    CORDB_ADDRESS modAddress = 0;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    mdTypeDef typeDef = mdTypeDefNil;
+    IfFailRet(pClass->GetToken(&typeDef));
+
+    const TypeKey key{modAddress, typeDef};
+    {
+        const std::lock_guard<std::mutex> lock(m_typeFieldsCacheMutex);
+        auto find = m_typeFieldsCache.find(key);
+        if (find != m_typeFieldsCache.end())
+        {
+            typeFields = find->second;
+            return S_OK;
+        }
+    }
+
+    // Note, must be in sync with AsyncField enum.
+    static const char *fieldNames[] = {
+        "<>t__builder",
+        "<>1__state",
+        "m_task",
+        "m_builder",
+        "m_continuationObject",
+        "StateMachine",
+        "m_stateMachine",
+        "_target",
+        "_continuation",
+        "m_action",
+        "_items",
+        "m_stateFlags"
+    };
+    static_assert(_countof(fieldNames) == FieldsCount, "fieldNames must be in sync with AsyncField enum");
+
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    ToRelease<IMetaDataImport> pMD;
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+
+    TypeFields newTypeFields;
+    newTypeFields.fields.fill(mdFieldDefNil);
+
+    ULONG numFields = 0;
+    HCORENUM hEnum = NULL;
+    mdFieldDef fieldDef;
+    while(SUCCEEDED(pMD->EnumFields(&hEnum, typeDef, &fieldDef, 1, &numFields)) && numFields != 0)
+    {
+        ULONG nameLen = 0;
+        WCHAR mdName[mdNameLen] = {0};
+        if (FAILED(pMD->GetFieldProps(fieldDef, nullptr, mdName, _countof(mdName), &nameLen,
+                                      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)))
+        {
+            continue;
+        }
+
+        if (starts_with(mdName, W("<>u__")))
+        {
+            newTypeFields.awaiters.push_back(fieldDef);
+            continue;
+        }
+
+        const std::string name = to_utf8(mdName);
+
+        for (int i = 0; i < FieldsCount; i++)
+        {
+            if (name != fieldNames[i])
+                continue;
+
+            newTypeFields.fields[i] = fieldDef;
+            break;
+        }
+    }
+    pMD->CloseEnum(hEnum);
+
+    newTypeFields.moveNext = mdMethodDefNil;
+    if (newTypeFields.fields[FieldBuilder] != mdFieldDefNil && newTypeFields.fields[FieldState] != mdFieldDefNil &&
+        FAILED(pMD->FindMethod(typeDef, W("MoveNext"), nullptr, 0, &newTypeFields.moveNext)))
+    {
+        newTypeFields.moveNext = mdMethodDefNil;
+    }
+
+    const std::lock_guard<std::mutex> lock(m_typeFieldsCacheMutex);
+    m_typeFieldsCache.emplace(key, newTypeFields);
+    typeFields = newTypeFields;
+
+    return S_OK;
+}
+
+// Get field value by cached field token, field could be declared in value's type or in any of base types.
+HRESULT AsyncCallStack::GetFieldValue(ICorDebugValue *pInputValue, AsyncField field, ICorDebugValue **ppFieldValue)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+
+    ToRelease<ICorDebugObjectValue> pObjValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+
+    while (pType != nullptr)
+    {
+        ToRelease<ICorDebugClass> pClass;
+        IfFailRet(pType->GetClass(&pClass));
+        TypeFields typeFields;
+        IfFailRet(GetTypeFields(pClass, typeFields));
+
+        if (typeFields.fields[field] != mdFieldDefNil)
+            return pObjValue->GetFieldValue(pClass, typeFields.fields[field], ppFieldValue);
+
+        ToRelease<ICorDebugType> pBaseType;
+        if (FAILED(pType->GetBase(&pBaseType)))
+            break;
+        pType = pBaseType.Detach();
+    }
+
+    return E_FAIL;
+}
+
+bool AsyncCallStack::IsAsyncMethodFrame(ICorDebugFrame *pFrame)
+{
+    ToRelease<ICorDebugFunction> pFunction;
+    ToRelease<ICorDebugClass> pClass;
+    mdMethodDef methodDef = mdMethodDefNil;
+    TypeFields typeFields;
+
+    return SUCCEEDED(pFrame->GetFunction(&pFunction)) &&
+           SUCCEEDED(pFunction->GetClass(&pClass)) &&
+           SUCCEEDED(pFunction->GetToken(&methodDef)) &&
+           SUCCEEDED(GetTypeFields(pClass, typeFields)) &&
+           typeFields.moveNext != mdMethodDefNil &&
+           typeFields.moveNext == methodDef;
+}
+
+// State machine -> '<>t__builder' -> 'm_task' (task or state machine box, that represent async method's task).
+HRESULT AsyncCallStack::GetStateMachineTask(ICorDebugValue *pStateMachine, ICorDebugValue **ppTask)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> pBuilder;
+    IfFailRet(GetFieldValue(pStateMachine, FieldBuilder, &pBuilder));
+
+    if (SUCCEEDED(GetFieldValue(pBuilder, FieldTask, ppTask)))
+        return S_OK;
+
+    // Non generic builder could wrap generic builder.
+    ToRelease<ICorDebugValue> pInnerBuilder;
+    IfFailRet(GetFieldValue(pBuilder, FieldInnerBuilder, &pInnerBuilder));
+    return GetFieldValue(pInnerBuilder, FieldTask, ppTask);
+}
+
+HRESULT AsyncCallStack::FindAwaitingStateMachine(ICorDebugValue *pTask, ICorDebugValue **ppStateMachine)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> pContinuation;
+    IfFailRet(GetFieldValue(pTask, FieldContinuationObject, &pContinuation));
+    return ResolveContinuation(pContinuation, 0, ppStateMachine);
+}
+
+// Task's continuation object could be state machine box, delegate (with box or MoveNextRunner as target),
+// continuation wrapper or task continuation with delegate inside, or list of continuations (in this case only first is used).
+HRESULT AsyncCallStack::ResolveContinuation(ICorDebugValue *pContinuation, int depth, ICorDebugValue **ppStateMachine)
+{
+    if (depth > MaxContinuationDepth)
+        return E_FAIL;
+
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pContinuation, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+
+    if (SUCCEEDED(GetFieldValue(pValue, FieldStateMachine, ppStateMachine)) ||
+        SUCCEEDED(GetFieldValue(pValue, FieldRunnerStateMachine, ppStateMachine)))
+        return S_OK;
+
+    static const AsyncField wrapperFields[] = { FieldDelegateTarget, FieldContinuation, FieldAction };
+    for (auto field : wrapperFields)
+    {
+        ToRelease<ICorDebugValue> pInnerContinuation;
+        if (SUCCEEDED(GetFieldValue(pValue, field, &pInnerContinuation)))
+            return ResolveContinuation(pInnerContinuation, depth + 1, ppStateMachine);
+    }
+
+    ToRelease<ICorDebugValue> pItemsRef;
+    IfFailRet(GetFieldValue(pValue, FieldListItems, &pItemsRef));
+    ToRelease<ICorDebugValue> pItems;
+    IfFailRet(DereferenceAndUnboxValue(pItemsRef, &pItems, &isNull));
+    if (isNull)
+        return E_FAIL;
+    ToRelease<ICorDebugArrayValue> pArray;
+    IfFailRet(pItems->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &pArray));
+    ULONG32 count = 0;
+    IfFailRet(pArray->GetCount(&count));
+    if (count == 0)
+        return E_FAIL;
+    ToRelease<ICorDebugValue> pFirstItem;
+    IfFailRet(pArray->GetElementAtPosition(0, &pFirstItem));
+    return ResolveContinuation(pFirstItem, depth + 1, ppStateMachine);
+}
+
+// Fill logical frame for suspended async method, location is resume point of await, that state machine wait for now.
+HRESULT AsyncCallStack::GetStateMachineFrame(ICorDebugValue *pStateMachine, StackFrame &stackFrame)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pStateMachine, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    TypeFields typeFields;
+    IfFailRet(GetTypeFields(pClass, typeFields));
+    if (typeFields.moveNext == mdMethodDefNil)
+        return E_FAIL;
+
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    CORDB_ADDRESS modAddress = 0;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    std::string typeName;
+    IfFailRet(TypePrinter::NameForTypeByValue(pValue, typeName));
+    stackFrame.methodName = typeName + ".MoveNext()";
+
+    ULONG32 methodVersion = 1;
+    ToRelease<ICorDebugFunction> pFunction;
+    if (FAILED(pModule->GetFunctionFromToken(typeFields.moveNext, &pFunction)) ||
+        FAILED(pFunction->GetCurrentVersionNumber(&methodVersion)))
+    {
+        methodVersion = 1;
+    }
+
+    IfFailRet(GetModuleId(pModule, stackFrame.moduleId));
+    WCHAR name[mdNameLen];
+    ULONG32 name_len = 0;
+    if (SUCCEEDED(pModule->GetName(_countof(name), &name_len, name)))
+        stackFrame.moduleOrLibName = GetBasename(to_utf8(name));
+
+    stackFrame.clrAddr.methodToken = typeFields.moveNext;
+    stackFrame.clrAddr.methodVersion = methodVersion;
+
+    int32_t state = -1;
+    ToRelease<ICorDebugValue> pStateValue;
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    AsyncInfo::AwaitInfo awaitInfo;
+    Modules::SequencePoint sp;
+    if (SUCCEEDED(GetFieldValue(pValue, FieldState, &pStateValue)) &&
+        SUCCEEDED(pStateValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue)) &&
+        SUCCEEDED(pGenericValue->GetValue(&state)) &&
+        m_sharedAsyncInfo->FindAwaitInfoByState(modAddress, typeFields.moveNext, methodVersion, state, awaitInfo) &&
+        SUCCEEDED(m_sharedModules->GetSequencePointByILOffset(modAddress, typeFields.moveNext, methodVersion, awaitInfo.resume_offset, sp)))
+    {
+        stackFrame.source = Source(sp.document);
+        stackFrame.line = sp.startLine;
+        stackFrame.column = sp.startColumn;
+        stackFrame.endLine = sp.endLine;
+        stackFrame.endColumn = sp.endColumn;
+        stackFrame.clrAddr.ilOffset = awaitInfo.resume_offset;
+    }
+
+    return S_OK;
+}
+
+HRESULT AsyncCallStack::GetAsyncCallStack(ICorDebugFrame *pFrame, ThreadId threadId, FrameLevel firstLevel, std::vector<StackFrame> &stackFrames)
+{
+    HRESULT Status;
+
+    // Note, caller must check frame with IsAsyncMethodFrame(), so, first argument is 'this' (state machine).
+    ToRelease<ICorDebugILFrame> pILFrame;
+    IfFailRet(pFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID*) &pILFrame));
+    ToRelease<ICorDebugValueEnum> pParamEnum;
+    IfFailRet(pILFrame->EnumerateArguments(&pParamEnum));
+    ToRelease<ICorDebugValue> pStateMachine;
+    ULONG fetched = 0;
+    IfFailRet(pParamEnum->Next(1, &pStateMachine, &fetched));
+    if (fetched == 0)
+        return E_FAIL;
+
+    return GetAwaitingFrames(pStateMachine, threadId, int(firstLevel), stackFrames);
+}
+
+// Follow awaiting continuations chain started from state machine.
+// [in] threadId - thread ID for new frames, in case of ThreadId::Invalid frames will not have ID;
+// [in] firstLevel - level for first frame (used with valid threadId only).
+// Note, frames have logical IDs, since there are no physical frames for scopes and evaluation.
+HRESULT AsyncCallStack::GetAwaitingFrames(ICorDebugValue *pInitialStateMachine, ThreadId threadId, int firstLevel, std::vector<StackFrame> &stackFrames)
+{
+    pInitialStateMachine->AddRef();
+    ToRelease<ICorDebugValue> pStateMachine(pInitialStateMachine);
+
+    int level = firstLevel;
+    for (int i = 0; i < MaxAsyncFrames; i++)
+    {
+        ToRelease<ICorDebugValue> pTask;
+        ToRelease<ICorDebugValue> pAwaitingStateMachine;
+        if (FAILED(GetStateMachineTask(pStateMachine, &pTask)) ||
+            FAILED(FindAwaitingStateMachine(pTask, &pAwaitingStateMachine)))
+            break;
+
+        StackFrame stackFrame = threadId ? StackFrame(FrameId::logical(threadId, FrameLevel{level})) : StackFrame();
+        if (FAILED(GetStateMachineFrame(pAwaitingStateMachine, stackFrame)))
+            break;
+
+        stackFrames.push_back(stackFrame);
+        level++;
+        pStateMachine = pAwaitingStateMachine.Detach();
+    }
+
+    return S_OK;
+}
+
+// Awaiter fields are reset by compiler generated code after await completion, so, only current await's awaiter have task.
+HRESULT AsyncCallStack::GetAwaitedTask(ICorDebugValue *pStateMachine, CORDB_ADDRESS &taskAddress)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pStateMachine, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+
+    ToRelease<ICorDebugObjectValue> pObjValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    TypeFields typeFields;
+    IfFailRet(GetTypeFields(pClass, typeFields));
+
+    for (auto fieldDef : typeFields.awaiters)
+    {
+        ToRelease<ICorDebugValue> pAwaiter;
+        ToRelease<ICorDebugValue> pTask;
+        ToRelease<ICorDebugReferenceValue> pTaskRef;
+        if (FAILED(pObjValue->GetFieldValue(pClass, fieldDef, &pAwaiter)) ||
+            FAILED(GetFieldValue(pAwaiter, FieldTask, &pTask)) ||
+            FAILED(pTask->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pTaskRef)) ||
+            FAILED(pTaskRef->IsNull(&isNull)) || isNull)
+            continue;
+
+        return pTaskRef->GetValue(&taskAddress);
+    }
+
+    return E_FAIL;
+}
+
+// Same logic as Task.Status property have.
+static const char *GetTaskStatus(int32_t stateFlags, bool &completed)
+{
+    const int32_t TASK_STATE_STARTED = 0x10000;
+    const int32_t TASK_STATE_DELEGATE_INVOKED = 0x20000;
+    const int32_t TASK_STATE_FAULTED = 0x200000;
+    const int32_t TASK_STATE_CANCELED = 0x400000;
+    const int32_t TASK_STATE_WAITING_ON_CHILDREN = 0x800000;
+    const int32_t TASK_STATE_RAN_TO_COMPLETION = 0x1000000;
+    const int32_t TASK_STATE_WAITING_FOR_ACTIVATION = 0x2000000;
+
+    completed = (stateFlags & (TASK_STATE_FAULTED | TASK_STATE_CANCELED | TASK_STATE_RAN_TO_COMPLETION)) != 0;
+
+    if (stateFlags & TASK_STATE_FAULTED)
+        return "Faulted";
+    else if (stateFlags & TASK_STATE_CANCELED)
+        return "Canceled";
+    else if (stateFlags & TASK_STATE_RAN_TO_COMPLETION)
+        return "RanToCompletion";
+    else if (stateFlags & TASK_STATE_WAITING_ON_CHILDREN)
+        return "WaitingForChildrenToComplete";
+    else if (stateFlags & TASK_STATE_DELEGATE_INVOKED)
+        return "Running";
+    else if (stateFlags & TASK_STATE_STARTED)
+        return "WaitingToRun";
+    else if (stateFlags & TASK_STATE_WAITING_FOR_ACTIVATION)
+        return "WaitingForActivation";
+
+    return "Created";
+}
+
+HRESULT AsyncCallStack::GetAsyncTasks(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker, std::vector<AsyncTaskGroup> &taskGroups)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+
+    // Most of heap objects are not state machine boxes, check each type only once during walk.
+    std::map<std::pair<ULONG64, ULONG64>, bool> boxTypes;
+    // Logical call stack text as key, value is group index.
+    std::unordered_map<std::string, size_t> groupsIndex;
+
+    return pHeapWalker->Walk(pProcess, [&](const COR_HEAPOBJECT &heapObject) -> HRESULT
+    {
+        const auto typeKey = std::make_pair(heapObject.type.token1, heapObject.type.token2);
+        auto findType = boxTypes.find(typeKey);
+        if (findType == boxTypes.end())
+        {
+            ToRelease<ICorDebugType> pType;
+            ToRelease<ICorDebugClass> pClass;
+            TypeFields typeFields;
+            const bool isBox = SUCCEEDED(iCorProcess5->GetTypeForTypeID(heapObject.type, &pType)) &&
+                               SUCCEEDED(pType->GetClass(&pClass)) &&
+                               SUCCEEDED(GetTypeFields(pClass, typeFields)) &&
+                               typeFields.fields[FieldStateMachine] != mdFieldDefNil;
+            findType = boxTypes.emplace(typeKey, isBox).first;
+        }
+        if (!findType->second)
+            return S_OK;
+
+        ToRelease<ICorDebugObjectValue> pBox;
+        ToRelease<ICorDebugValue> pStateFlags;
+        ToRelease<ICorDebugGenericValue> pStateFlagsValue;
+        int32_t stateFlags = 0;
+        if (FAILED(iCorProcess5->GetObject(heapObject.address, &pBox)) ||
+            FAILED(GetFieldValue(pBox, FieldStateFlags, &pStateFlags)) ||
+            FAILED(pStateFlags->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pStateFlagsValue)) ||
+            FAILED(pStateFlagsValue->GetValue(&stateFlags)))
+            return S_OK;
+
+        AsyncTask task;
+        bool completed = false;
+        task.address = heapObject.address;
+        task.status = GetTaskStatus(stateFlags, completed);
+        if (completed)
+            return S_OK;
+
+        ToRelease<ICorDebugValue> pStateMachine;
+        StackFrame stackFrame;
+        if (FAILED(GetFieldValue(pBox, FieldStateMachine, &pStateMachine)) ||
+            FAILED(GetStateMachineFrame(pStateMachine, stackFrame)))
+            return S_OK;
+
+        CORDB_ADDRESS awaitedTask = 0;
+        if (SUCCEEDED(GetAwaitedTask(pStateMachine, awaitedTask)))
+            task.awaitedTask = awaitedTask;
+
+        std::vector<StackFrame> stackFrames;
+        stackFrames.push_back(stackFrame);
+        GetAwaitingFrames(pStateMachine, ThreadId::Invalid, 0, stackFrames);
+
+        std::string stackKey;
+        for (const auto &frame : stackFrames)
+        {
+            stackKey += frame.methodName + ":" + std::to_string(frame.line) + "\n";
+        }
+
+        auto findGroup = groupsIndex.find(stackKey);
+        if (findGroup == groupsIndex.end())
+        {
+            findGroup = groupsIndex.emplace(stackKey, taskGroups.size()).first;
+            taskGroups.emplace_back();
+            taskGroups.back().stackFrames = std::move(stackFrames);
+        }
+
+        AsyncTaskGroup &group = taskGroups[findGroup->second];
+        group.count++;
+        if (group.tasks.size() < MaxTasksInGroup)
+            group.tasks.push_back(task);
+
+        return S_OK;
+    });
+}
+
+void AsyncCallStack::Clear()
+{
+    const std::lock_guard<std::mutex> lock(m_typeFieldsCacheMutex);
+    m_typeFieldsCache.clear();
+}
+
+} // namespace netcoredbg
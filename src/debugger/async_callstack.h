@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <array>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+class Modules;
+class AsyncInfo;
+class HeapWalker;
+
+// Logical (async causality) call stack reconstruction. Started from async method's state machine in physical frame,
+// follow awaiting continuations (builder's task -> task's continuation -> awaiting state machine box) without evaluation.
+class AsyncCallStack
+{
+public:
+
+    AsyncCallStack(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<AsyncInfo> &sharedAsyncInfo) :
+        m_sharedModules(sharedModules),
+        m_sharedAsyncInfo(sharedAsyncInfo)
+    {}
+
+    // Check, that frame is async method's state machine MoveNext() frame.
+    bool IsAsyncMethodFrame(ICorDebugFrame *pFrame);
+
+    // Add logical frames for all async methods, that await (directly or through other async methods) async method in provided frame.
+    // [in] pFrame - async method's state machine MoveNext() frame;
+    // [in] threadId - thread ID for new frames;
+    // [in] firstLevel - level for first logical frame;
+    // [out] stackFrames - logical frames.
+    HRESULT GetAsyncCallStack(ICorDebugFrame *pFrame, ThreadId threadId, FrameLevel firstLevel, std::vector<StackFrame> &stackFrames);
+
+    // Find all not completed async methods' tasks (state machine boxes) in managed heap and group them by logical call stack.
+    HRESULT GetAsyncTasks(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker, std::vector<AsyncTaskGroup> &taskGroups);
+
+    void Clear();
+
+private:
+
+    std::shared_ptr<Modules> m_sharedModules;
+    std::shared_ptr<AsyncInfo> m_sharedAsyncInfo;
+
+    enum AsyncField
+    {
+        FieldBuilder = 0,        // state machine - "<>t__builder"
+        FieldState,              // state machine - "<>1__state"
+        FieldTask,               // method builder - "m_task"
+        FieldInnerBuilder,       // method builder - "m_builder" (AsyncTaskMethodBuilder wrap AsyncTaskMethodBuilder<VoidTaskResult> in old runtimes)
+        FieldContinuationObject, // task - "m_continuationObject"
+        FieldStateMachine,       // state machine box - "StateMachine"
+        FieldRunnerStateMachine, // MoveNextRunner in old runtimes - "m_stateMachine"
+        FieldDelegateTarget,     // delegate - "_target"
+        FieldContinuation,       // continuation wrapper - "_continuation"
+        FieldAction,             // await task continuation - "m_action"
+        FieldListItems,          // continuations list - "_items"
+        FieldStateFlags,         // task - "m_stateFlags"
+        FieldsCount
+    };
+
+    struct TypeFields
+    {
+        std::array<mdFieldDef, FieldsCount> fields;
+        mdMethodDef moveNext; // mdMethodDefNil in case type is not state machine
+        std::vector<mdFieldDef> awaiters; // state machine - "<>u__N"
+    };
+
+    struct TypeKey
+    {
+        CORDB_ADDRESS modAddress;
+        mdTypeDef typeDef;
+
+        bool operator==(const TypeKey &other) const
+        {
+            return modAddress == other.modAddress && typeDef == other.typeDef;
+        }
+    };
+
+    struct TypeKeyHash
+    {
+        size_t operator()(const TypeKey &key) const
+        {
+            return std::hash<CORDB_ADDRESS>()(key.modAddress) ^ (std::hash<mdTypeDef>()(key.typeDef) << 1);
+        }
+    };
+
+    // Fields tokens are resolved by name only once for each type, in this way stack reconstruction could be done at each stop.
+    std::mutex m_typeFieldsCacheMutex;
+    std::unordered_map<TypeKey, TypeFields, TypeKeyHash> m_typeFieldsCache;
+
+    HRESULT GetTypeFields(ICorDebugClass *pClass, TypeFields &typeFields);
+    HRESULT GetFieldValue(ICorDebugValue *pValue, AsyncField field, ICorDebugValue **ppFieldValue);
+    HRESULT GetStateMachineTask(ICorDebugValue *pStateMachine, ICorDebugValue **ppTask);
+    HRESULT FindAwaitingStateMachine(ICorDebugValue *pTask, ICorDebugValue **ppStateMachine);
+    HRESULT ResolveContinuation(ICorDebugValue *pContinuation, int depth, ICorDebugValue **ppStateMachine);
+    HRESULT GetStateMachineFrame(ICorDebugValue *pStateMachine, StackFrame &stackFrame);
+    HRESULT GetAwaitingFrames(ICorDebugValue *pStateMachine, ThreadId threadId, int firstLevel, std::vector<StackFrame> &stackFrames);
+    HRESULT GetAwaitedTask(ICorDebugValue *pStateMachine, CORDB_ADDRESS &taskAddress);
+};
+
+} // namespace netcoredbg
@@ -33,19 +33,23 @@
 namespace netcoredbg
 {
 
-Breakpoints::Breakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Evaluator> &sharedEvaluator, std::shared_ptr<EvalHelpers> &sharedEvalHelpers, std::shared_ptr<Variables> &sharedVariables) :
+Breakpoints::Breakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Evaluator> &sharedEvaluator, std::shared_ptr<EvalHelpers> &sharedEvalHelpers, std::shared_ptr<Variables> &sharedVariables,
+                         std::shared_ptr<Threads> &sharedThreads, std::shared_ptr<TraceRecorder> &sharedTraceRecorder) :
         m_uniqueBreakBreakpoint(new BreakBreakpoint(sharedModules)),
         m_uniqueEntryBreakpoint(new EntryBreakpoint(sharedModules)),
-        m_uniqueExceptionBreakpoints(new ExceptionBreakpoints(sharedEvaluator)),
-        m_uniqueFuncBreakpoints(new FuncBreakpoints(sharedModules, sharedVariables)),
-        m_uniqueLineBreakpoints(new LineBreakpoints(sharedModules, sharedVariables)),
+        m_uniqueExceptionBreakpoints(new ExceptionBreakpoints(sharedModules, sharedEvaluator)),
+        m_uniqueFuncBreakpoints(new FuncBreakpoints(sharedModules, sharedVariables, sharedThreads)),
+        m_uniqueLineBreakpoints(new LineBreakpoints(sharedModules, sharedVariables, sharedThreads, sharedTraceRecorder)),
         m_uniqueHotReloadBreakpoint(new HotReloadBreakpoint(sharedModules, sharedEvaluator, sharedEvalHelpers)),
 #ifdef INTEROP_DEBUGGING
         m_sharedInteropBreakpoints(new InteropDebugging::InteropBreakpoints()),
         m_uniqueInteropRendezvousBreakpoint(new InteropDebugging::InteropRendezvousBreakpoint(m_sharedInteropBreakpoints)),
         m_sharedInteropLineBreakpoints(new InteropDebugging::InteropLineBreakpoints(m_sharedInteropBreakpoints)),
 #endif // INTEROP_DEBUGGING
-        m_nextBreakpointId(1)
+        m_nextBreakpointId(1),
+        m_rejectedHits(0),
+        m_rejectedHitsTotalNs(0),
+        m_rejectedHitsMaxNs(0)
     {}
 
 void Breakpoints::SetJustMyCode(bool enable)
@@ -72,6 +76,19 @@ HRESULT Breakpoints::ManagedCallbackBreak(ICorDebugThread *pThread, const Thread
 
 void Breakpoints::DeleteAllManaged()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_rejectedHitsMutex);
+        if (m_rejectedHits)
+        {
+            LOGI("Breakpoints filters: %llu hits rejected in callback thread, latency avg %llu ns, max %llu ns",
+                 (unsigned long long)m_rejectedHits, (unsigned long long)(m_rejectedHitsTotalNs / m_rejectedHits),
+                 (unsigned long long)m_rejectedHitsMaxNs);
+        }
+        m_rejectedHits = 0;
+        m_rejectedHitsTotalNs = 0;
+        m_rejectedHitsMaxNs = 0;
+    }
+
     m_uniqueEntryBreakpoint->Delete();
     m_uniqueFuncBreakpoints->DeleteAll();
     m_uniqueLineBreakpoints->DeleteAll();
@@ -145,9 +162,14 @@ HRESULT Breakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std:
     return S_OK;
 }
 
-HRESULT Breakpoints::GetExceptionInfo(ICorDebugThread *pThread, ExceptionInfo &exceptionInfo)
+HRESULT Breakpoints::GetExceptionInfo(ICorDebugThread *pThread, bool extendedDetails, ExceptionInfo &exceptionInfo)
 {
-    return m_uniqueExceptionBreakpoints->GetExceptionInfo(pThread, exceptionInfo);
+    return m_uniqueExceptionBreakpoints->GetExceptionInfo(pThread, extendedDetails, exceptionInfo);
+}
+
+HRESULT Breakpoints::GetExceptionStackTrace(ICorDebugThread *pThread, std::string &stackTrace)
+{
+    return m_uniqueExceptionBreakpoints->GetExceptionStackTrace(pThread, stackTrace);
 }
 
 HRESULT Breakpoints::ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, std::vector<BreakpointEvent> &bpChangeEvents, bool &atEntry)
@@ -198,6 +220,21 @@ HRESULT Breakpoints::ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDeb
     return S_OK; // no breakpoints hit, forced to interrupt this callback
 }
 
+HRESULT Breakpoints::ManagedCallbackBreakpointFilter(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
+{
+    // Function breakpoints have no cheap filters for now, only line breakpoints could be rejected here.
+    return m_uniqueLineBreakpoints->CheckBreakpointFilters(pThread, pBreakpoint);
+}
+
+void Breakpoints::AddRejectedHitLatency(std::chrono::steady_clock::duration latency)
+{
+    const uint64_t latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+    std::lock_guard<std::mutex> lock(m_rejectedHitsMutex);
+    m_rejectedHits++;
+    m_rejectedHitsTotalNs += latencyNs;
+    m_rejectedHitsMaxNs = std::max(m_rejectedHitsMaxNs, latencyNs);
+}
+
 HRESULT Breakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std::vector<BreakpointEvent> &events)
 {
     m_uniqueEntryBreakpoint->ManagedCallbackLoadModule(pModule);
@@ -209,12 +246,18 @@ HRESULT Breakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std::ve
 HRESULT Breakpoints::ManagedCallbackLoadModuleAll(ICorDebugModule *pModule)
 {
     m_uniqueHotReloadBreakpoint->ManagedCallbackLoadModuleAll(pModule);
+    m_uniqueExceptionBreakpoints->ManagedCallbackLoadModuleAll(pModule);
     return S_OK;
 }
 
-HRESULT Breakpoints::ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule, StoppedEvent &event)
+HRESULT Breakpoints::ManagedCallbackUnloadModule(ICorDebugModule *pModule)
+{
+    return m_uniqueExceptionBreakpoints->ManagedCallbackUnloadModule(pModule);
+}
+
+HRESULT Breakpoints::ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, ICorDebugModule *pExcModule, StoppedEvent &event)
 {
-    return m_uniqueExceptionBreakpoints->ManagedCallbackException(pThread, eventType, excModule, event);
+    return m_uniqueExceptionBreakpoints->ManagedCallbackException(pThread, eventType, pExcModule, event);
 }
 
 HRESULT Breakpoints::AllBreakpointsActivate(bool act)
@@ -7,6 +7,7 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <chrono>
 #include <string>
 #include <mutex>
 #include <memory>
@@ -21,6 +22,8 @@ class Evaluator;
 class EvalHelpers;
 class Variables;
 class Modules;
+class Threads;
+class TraceRecorder;
 class BreakBreakpoint;
 class EntryBreakpoint;
 class ExceptionBreakpoints;
@@ -41,7 +44,8 @@ class Breakpoints
 {
 public:
 
-    Breakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Evaluator> &sharedEvaluator, std::shared_ptr<EvalHelpers> &sharedEvalHelpers, std::shared_ptr<Variables> &sharedVariables);
+    Breakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Evaluator> &sharedEvaluator, std::shared_ptr<EvalHelpers> &sharedEvalHelpers, std::shared_ptr<Variables> &sharedVariables,
+                std::shared_ptr<Threads> &sharedThreads, std::shared_ptr<TraceRecorder> &sharedTraceRecorder);
 
     void SetJustMyCode(bool enable);
     void SetLastStoppedIlOffset(ICorDebugProcess *pProcess, const ThreadId &lastStoppedThreadId);
@@ -56,7 +60,8 @@ public:
     HRESULT SetHotReloadBreakpoint(const std::string &updatedDLL, const std::unordered_set<mdTypeDef> &updatedTypeTokens);
     HRESULT UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::vector<BreakpointEvent> &events);
 
-    HRESULT GetExceptionInfo(ICorDebugThread *pThread, ExceptionInfo &exceptionInfo);
+    HRESULT GetExceptionInfo(ICorDebugThread *pThread, bool extendedDetails, ExceptionInfo &exceptionInfo);
+    HRESULT GetExceptionStackTrace(ICorDebugThread *pThread, std::string &stackTrace);
 
     void EnumerateBreakpoints(std::function<bool (const IDebugger::BreakpointInfo&)>&& callback);
     HRESULT BreakpointActivate(uint32_t id, bool act);
@@ -71,9 +76,16 @@ public:
     //     return S_OK;
     HRESULT ManagedCallbackBreak(ICorDebugThread *pThread, const ThreadId &lastStoppedThreadId);
     HRESULT ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, std::vector<BreakpointEvent> &bpChangeEvents, bool &atEntry);
-    HRESULT ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule, StoppedEvent &event);
+    // Called by runtime callback thread before callback queued, must be fast and must not use evaluation.
+    // S_OK - breakpoint hit rejected by cheap filters (thread, hit count), process should be continued without queue
+    // S_FALSE - callback should be queued
+    HRESULT ManagedCallbackBreakpointFilter(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
+    // Time from callback start till process continue for rejected by filters hit.
+    void AddRejectedHitLatency(std::chrono::steady_clock::duration latency);
+    HRESULT ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, ICorDebugModule *pExcModule, StoppedEvent &event);
     HRESULT ManagedCallbackLoadModule(ICorDebugModule *pModule, std::vector<BreakpointEvent> &events);
     HRESULT ManagedCallbackLoadModuleAll(ICorDebugModule *pModule);
+    HRESULT ManagedCallbackUnloadModule(ICorDebugModule *pModule);
     HRESULT ManagedCallbackExitThread(ICorDebugThread *pThread);
 
     // S_OK - internal HotReload breakpoint hit
@@ -133,6 +145,11 @@ private:
     std::mutex m_nextBreakpointIdMutex;
     uint32_t m_nextBreakpointId;
 
+    std::mutex m_rejectedHitsMutex;
+    uint64_t m_rejectedHits;
+    uint64_t m_rejectedHitsTotalNs;
+    uint64_t m_rejectedHitsMaxNs;
+
 };
 
 } // namespace netcoredbg
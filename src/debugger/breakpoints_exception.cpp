@@ -5,7 +5,10 @@
 #include "debugger/breakpoints_exception.h"
 #include "debugger/evaluator.h"
 #include "debugger/valueprint.h"
+#include "metadata/modules.h"
 #include "metadata/typeprinter.h"
+#include "utils/utf.h"
+#include <algorithm>
 #include <sstream>
 
 namespace netcoredbg
@@ -17,6 +20,43 @@ void ExceptionBreakpoints::ManagedExceptionBreakpoint::ToBreakpoint(Breakpoint &
     breakpoint.verified = true;
 }
 
+// Type name could be provided with '+' or '.' as nested types delimiter ("Namespace.Outer+Inner" or "Namespace.Outer.Inner").
+static HRESULT FindTypeDef(IMetaDataImport *pMD, const std::string &name, mdTypeDef &typeDef)
+{
+    if (SUCCEEDED(pMD->FindTypeDefByName(reinterpret_cast<LPCWSTR>(to_utf16(name).c_str()), mdTypeDefNil, &typeDef)))
+        return S_OK;
+
+    std::size_t i = name.find_last_of("+.");
+    if (i == std::string::npos || i == 0 || i + 1 == name.size())
+        return E_FAIL;
+
+    HRESULT Status;
+    mdTypeDef enclosingTypeDef;
+    IfFailRet(FindTypeDef(pMD, name.substr(0, i), enclosingTypeDef));
+    return pMD->FindTypeDefByName(reinterpret_cast<LPCWSTR>(to_utf16(name.substr(i + 1)).c_str()), enclosingTypeDef, &typeDef);
+}
+
+void ExceptionBreakpoints::ManagedExceptionBreakpoint::ResolveConditionTypes(ICorDebugModule *pModule)
+{
+    if (condition.empty())
+        return;
+
+    CORDB_ADDRESS modAddress;
+    ToRelease<IUnknown> iUnknown;
+    ToRelease<IMetaDataImport> iMD;
+    if (FAILED(pModule->GetBaseAddress(&modAddress)) ||
+        FAILED(pModule->GetMetaDataInterface(IID_IMetaDataImport, &iUnknown)) ||
+        FAILED(iUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &iMD)))
+        return;
+
+    for (const auto &typeName : condition)
+    {
+        mdTypeDef typeDef;
+        if (SUCCEEDED(FindTypeDef(iMD, typeName, typeDef)))
+            conditionTypes.insert(TypeToken{modAddress, typeDef});
+    }
+}
+
 void ExceptionBreakpoints::DeleteAll()
 {
     m_breakpointsMutex.lock();
@@ -85,6 +125,12 @@ HRESULT ExceptionBreakpoints::SetExceptionBreakpoints(const std::vector<Exceptio
             bp.categoryHint = expb.categoryHint;
             bp.condition = expb.condition;
             bp.negativeCondition = expb.negativeCondition;
+            if (!bp.condition.empty())
+                m_sharedModules->ForEachModule([&](ICorDebugModule *pModule) -> HRESULT
+                {
+                    bp.ResolveConditionTypes(pModule);
+                    return S_OK;
+                });
 
             bp.ToBreakpoint(breakpoint);
             m_exceptionBreakpoints[(size_t)expb.filterId].insert(std::make_pair(expHash, std::move(bp)));
@@ -104,7 +150,7 @@ HRESULT ExceptionBreakpoints::SetExceptionBreakpoints(const std::vector<Exceptio
 // Return:
 // true - covered by filter, need emit exception event
 // false - not covered by filter, ignore exception
-bool ExceptionBreakpoints::CoveredByFilter(ExceptionBreakpointFilter filterId, const std::string &excType, ExceptionCategory excCategory)
+bool ExceptionBreakpoints::CoveredByFilter(ExceptionBreakpointFilter filterId, const std::vector<TypeToken> &excTypeHierarchy, ExceptionCategory excCategory)
 {
     assert(excCategory != ExceptionCategory::ANY); // caller must know category: CLR = Exception() callback, MDA = MDANotification() callback
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
@@ -115,18 +161,92 @@ bool ExceptionBreakpoints::CoveredByFilter(ExceptionBreakpointFilter filterId, c
             expb.second.categoryHint != ExceptionCategory::ANY)
             continue;
 
-        if (expb.second.condition.empty())
-            return true;
-
-        bool isCoveredByCondition = expb.second.condition.find(excType) == expb.second.condition.end() ?
-                                    expb.second.negativeCondition : !expb.second.negativeCondition;
+        bool isCoveredByCondition = true;
+        if (!expb.second.condition.empty())
+        {
+            // Condition with exception type also cover all derived exception types. Negative condition excludes exact
+            // types only, since all exceptions are derived from System.Exception ("!System.Exception" must not exclude all).
+            const auto &conditionTypes = expb.second.conditionTypes;
+            const bool inCondition = expb.second.negativeCondition
+                ? !excTypeHierarchy.empty() && conditionTypes.find(excTypeHierarchy.front()) != conditionTypes.end()
+                : std::any_of(excTypeHierarchy.begin(), excTypeHierarchy.end(), [&](const TypeToken &token)
+                  {
+                      return conditionTypes.find(token) != conditionTypes.end();
+                  });
+            isCoveredByCondition = inCondition != expb.second.negativeCondition;
+        }
         if (isCoveredByCondition)
+        {
+            expb.second.times++;
             return true;
+        }
     }
 
     return false;
 }
 
+// Get exception type and all base types tokens, no names resolve here.
+static HRESULT GetTypeHierarchy(ICorDebugValue *pValue, std::vector<ExceptionBreakpoints::TypeToken> &hierarchy)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorValue;
+    IfFailRet(DereferenceAndUnboxValue(pValue, &iCorValue));
+    ToRelease<ICorDebugValue2> iCorValue2;
+    IfFailRet(iCorValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2));
+    ToRelease<ICorDebugType> iCorType;
+    IfFailRet(iCorValue2->GetExactType(&iCorType));
+
+    while (iCorType != nullptr)
+    {
+        CorElementType corElemType;
+        IfFailRet(iCorType->GetType(&corElemType));
+        if (corElemType != ELEMENT_TYPE_CLASS)
+            break;
+
+        ToRelease<ICorDebugClass> iCorClass;
+        ToRelease<ICorDebugModule> iCorModule;
+        ExceptionBreakpoints::TypeToken token;
+        IfFailRet(iCorType->GetClass(&iCorClass));
+        IfFailRet(iCorClass->GetToken(&token.typeDef));
+        IfFailRet(iCorClass->GetModule(&iCorModule));
+        IfFailRet(iCorModule->GetBaseAddress(&token.modAddress));
+        hierarchy.push_back(token);
+
+        ToRelease<ICorDebugType> iCorBaseType;
+        IfFailRet(iCorType->GetBase(&iCorBaseType));
+        iCorType = iCorBaseType.Detach();
+    }
+
+    return S_OK;
+}
+
+static void GetExceptionModuleName(ICorDebugModule *pModule, std::string &excModule)
+{
+    excModule = "<unknown module>";
+
+    // Exception was thrown outside of managed code (for example, by runtime).
+    if (pModule == nullptr)
+        return;
+
+    ToRelease<IUnknown> pMDUnknown;
+    ToRelease<IMetaDataImport> pMDImport;
+    WCHAR mdName[mdNameLen];
+    ULONG nameLen;
+    if (SUCCEEDED(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown)) &&
+        SUCCEEDED(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport)) &&
+        SUCCEEDED(pMDImport->GetScopeProps(mdName, _countof(mdName), &nameLen, nullptr)))
+    {
+        excModule = to_utf8(mdName);
+    }
+}
+
+static void SetExceptionModule(ToRelease<ICorDebugModule> &iCorExcModule, ICorDebugModule *pExcModule)
+{
+    if (pExcModule != nullptr)
+        pExcModule->AddRef();
+    iCorExcModule = pExcModule;
+}
+
 static void GetExceptionShorDescription(ExceptionBreakMode breakMode, const std::string &excType, const std::string &excModule, std::string &result)
 {
     switch(breakMode)
@@ -193,12 +313,26 @@ static void GetExceptionBreakModeName(ExceptionBreakMode breakMode, std::string
     }
 }
 
-HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details)
+// Return not empty result for not null reference value only.
+static HRESULT PrintNotNullValue(ICorDebugValue *pValue, std::string &result)
+{
+    const bool escape = false;
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugReferenceValue> iCorReferenceValue;
+    if (SUCCEEDED(pValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorReferenceValue)) &&
+        SUCCEEDED(iCorReferenceValue->IsNull(&isNull)) &&
+        isNull == FALSE)
+    {
+        return PrintValue(pValue, result, escape);
+    }
+    return S_OK;
+}
+
+HRESULT ExceptionBreakpoints::GetExceptionBasicDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details, unsigned depth)
 {
-    std::string excType;
     if (FAILED(TypePrinter::GetTypeOfValue(pExceptionValue, details.fullTypeName)))
     {
-        excType = "<unknown exception>";
+        details.fullTypeName = "<unknown exception>";
     }
 
     auto lastDotPosition = details.fullTypeName.find_last_of(".");
@@ -209,9 +343,8 @@ HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICor
 
     details.evaluateName = "$exception";
 
-    HRESULT Status;
+    // Note, only fields are read here, getValue() don't use func-eval. HResult and message are optional for details, ignore errors here.
     ToRelease<ICorDebugValue> iCorInnerExceptionValue;
-    const bool escape = false;
     m_sharedEvaluator->WalkMembers(pExceptionValue, pThread, FrameLevel{0}, false, [&](
         ICorDebugType*,
         bool,
@@ -219,50 +352,36 @@ HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICor
         Evaluator::GetValueCallback getValue,
         Evaluator::SetterData*)
     {
-        auto getMemberWithName = [&](const std::string &name, std::string &result) -> HRESULT
+        ToRelease<ICorDebugValue> iCorResultValue;
+        if (memberName == "_HResult")
         {
-            if (memberName != name)
-                return S_FALSE;
-
-            ToRelease<ICorDebugValue> iCorResultValue;
-            IfFailRet(getValue(&iCorResultValue, defaultEvalFlags));
-
-            BOOL isNull = TRUE;
-            ToRelease<ICorDebugReferenceValue> iCorReferenceValue;
-            if (SUCCEEDED(iCorResultValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorReferenceValue)) &&
-                SUCCEEDED(iCorReferenceValue->IsNull(&isNull)) &&
-                isNull == FALSE)
+            ToRelease<ICorDebugValue> iCorValue;
+            ToRelease<ICorDebugGenericValue> iCorGenericValue;
+            if (SUCCEEDED(getValue(&iCorResultValue, defaultEvalFlags)) &&
+                SUCCEEDED(DereferenceAndUnboxValue(iCorResultValue, &iCorValue)) &&
+                SUCCEEDED(iCorValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue)))
             {
-                PrintValue(iCorResultValue, result, escape);
+                iCorGenericValue->GetValue(&details.hResult);
             }
-            return S_OK;
-        };
-
-        IfFailRet(Status = getMemberWithName("_message", details.message));
-        if (Status == S_OK)
-            return S_OK;
-
-        IfFailRet(Status = getMemberWithName("StackTrace", details.stackTrace));
-        if (Status == S_OK)
-            return S_OK;
-
-        IfFailRet(Status = getMemberWithName("Source", details.source));
-        if (Status == S_OK)
-            return S_OK;
-
-        if (memberName == "InnerException")
+        }
+        else if (memberName == "_message")
         {
-            IfFailRet(getValue(&iCorInnerExceptionValue, defaultEvalFlags));
-            BOOL isNull = FALSE;
+            if (SUCCEEDED(getValue(&iCorResultValue, defaultEvalFlags)))
+                PrintNotNullValue(iCorResultValue, details.message);
+        }
+        // Note, field used instead of "InnerException" property, no func-eval needed for each inner exception.
+        else if (memberName == "_innerException" && depth < MaxInnerExceptionDepth)
+        {
+            BOOL isNull = TRUE;
             ToRelease<ICorDebugReferenceValue> iCorReferenceValue;
-            if (SUCCEEDED(iCorInnerExceptionValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorReferenceValue)) &&
+            if (SUCCEEDED(getValue(&iCorResultValue, defaultEvalFlags)) &&
+                SUCCEEDED(iCorResultValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorReferenceValue)) &&
                 SUCCEEDED(iCorReferenceValue->IsNull(&isNull)) &&
-                isNull == TRUE)
+                isNull == FALSE)
             {
-                iCorInnerExceptionValue.Free();
+                iCorInnerExceptionValue = iCorResultValue.Detach();
             }
         }
-
         return S_OK;
     });
 
@@ -273,38 +392,92 @@ HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICor
     if (iCorInnerExceptionValue != nullptr)
     {
         details.innerException.reset(new ExceptionDetails);
-        GetExceptionDetails(pThread, iCorInnerExceptionValue, *details.innerException.get());
+        GetExceptionBasicDetails(pThread, iCorInnerExceptionValue, *details.innerException.get(), depth + 1);
     }
 
     return S_OK;
 }
 
-HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, ExceptionInfo &exceptionInfo)
+// Note, details must have basic tier already collected (inner exceptions chain is not extended here).
+HRESULT ExceptionBreakpoints::GetExceptionExtendedDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details)
+{
+    ToRelease<ICorDebugValue> iCorInnerExceptionValue;
+    m_sharedEvaluator->WalkMembers(pExceptionValue, pThread, FrameLevel{0}, false, [&](
+        ICorDebugType*,
+        bool,
+        const std::string &memberName,
+        Evaluator::GetValueCallback getValue,
+        Evaluator::SetterData*)
+    {
+        HRESULT Status;
+        ToRelease<ICorDebugValue> iCorResultValue;
+        // Note, "StackTrace" and "Source" are properties, getValue() use func-eval.
+        if (memberName == "StackTrace" || memberName == "Source")
+        {
+            IfFailRet(getValue(&iCorResultValue, defaultEvalFlags));
+            return PrintNotNullValue(iCorResultValue, memberName == "StackTrace" ? details.stackTrace : details.source);
+        }
+        else if (memberName == "_innerException" && details.innerException != nullptr)
+        {
+            IfFailRet(getValue(&iCorResultValue, defaultEvalFlags));
+            iCorInnerExceptionValue = iCorResultValue.Detach();
+        }
+        return S_OK;
+    });
+
+    if (iCorInnerExceptionValue != nullptr)
+        GetExceptionExtendedDetails(pThread, iCorInnerExceptionValue, *details.innerException.get());
+
+    return S_OK;
+}
+
+// Caller must care about m_threadsExceptionMutex.
+HRESULT ExceptionBreakpoints::GetStoppedException(ICorDebugThread *pThread, ICorDebugValue **ppExceptionValue, ExceptionBreakMode &breakMode)
 {
     HRESULT Status;
-    ToRelease<ICorDebugValue> iCorExceptionValue;
-    IfFailRet(pThread->GetCurrentException(&iCorExceptionValue));
-    if (iCorExceptionValue == nullptr)
+    DWORD tid = 0;
+    IfFailRet(pThread->GetID(&tid));
+
+    auto findBreakMode = m_threadsExceptionBreakMode.find(tid);
+    if (findBreakMode == m_threadsExceptionBreakMode.end() || findBreakMode->second == ExceptionBreakMode::NEVER)
         return E_FAIL;
 
+    breakMode = findBreakMode->second;
+
+    IfFailRet(pThread->GetCurrentException(ppExceptionValue));
+    if (*ppExceptionValue == nullptr)
+        return E_FAIL;
+
+    return S_OK;
+}
+
+HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, bool extendedDetails, ExceptionInfo &exceptionInfo)
+{
+    HRESULT Status;
     DWORD tid = 0;
     IfFailRet(pThread->GetID(&tid));
 
     std::lock_guard<std::mutex> lock(m_threadsExceptionMutex);
 
-    auto findBreakMode = m_threadsExceptionBreakMode.find(tid);
-    if (findBreakMode == m_threadsExceptionBreakMode.end() || findBreakMode->second == ExceptionBreakMode::NEVER)
-        return E_FAIL;
+    ToRelease<ICorDebugValue> iCorExceptionValue;
+    ExceptionBreakMode breakMode;
+    IfFailRet(GetStoppedException(pThread, &iCorExceptionValue, breakMode));
 
-    IfFailRet(GetExceptionDetails(pThread, iCorExceptionValue, exceptionInfo.details));
+    IfFailRet(GetExceptionBasicDetails(pThread, iCorExceptionValue, exceptionInfo.details, 0));
+    if (extendedDetails)
+        IfFailRet(GetExceptionExtendedDetails(pThread, iCorExceptionValue, exceptionInfo.details));
 
+    // Module name stored at stop, so, "Source" property evaluation not needed for description.
     std::string excModule;
-    if (exceptionInfo.details.source.empty())
-        excModule = "<unknown module>";
-    else
+    auto findModule = m_threadsExceptionModuleName.find(tid);
+    if (findModule != m_threadsExceptionModuleName.end())
+        excModule = findModule->second;
+    else if (!exceptionInfo.details.source.empty())
         excModule = exceptionInfo.details.source + ".dll";
+    else
+        excModule = "<unknown module>";
 
-    GetExceptionShorDescription(findBreakMode->second, exceptionInfo.details.fullTypeName, excModule, exceptionInfo.description);
+    GetExceptionShorDescription(breakMode, exceptionInfo.details.fullTypeName, excModule, exceptionInfo.description);
 
     if (!exceptionInfo.details.message.empty())
         exceptionInfo.description += ": '" + exceptionInfo.details.message + "'";
@@ -315,7 +488,7 @@ HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, Excepti
                                      exceptionInfo.details.innerException->fullTypeName;
     }
 
-    GetExceptionBreakModeName(findBreakMode->second, exceptionInfo.breakMode);
+    GetExceptionBreakModeName(breakMode, exceptionInfo.breakMode);
     // CLR only for now, MDA not implemented
     // TODO need store info about category too (not only BreakMode) during Exception() (CLR) and MDANotification() (MDA) callbacks.
     exceptionInfo.exceptionId = "CLR/" + exceptionInfo.details.fullTypeName;
@@ -323,6 +496,36 @@ HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, Excepti
     return S_OK;
 }
 
+
+HRESULT ExceptionBreakpoints::GetExceptionStackTrace(ICorDebugThread *pThread, std::string &stackTrace)
+{
+    HRESULT Status;
+    std::lock_guard<std::mutex> lock(m_threadsExceptionMutex);
+
+    ToRelease<ICorDebugValue> iCorExceptionValue;
+    ExceptionBreakMode breakMode;
+    IfFailRet(GetStoppedException(pThread, &iCorExceptionValue, breakMode));
+
+    stackTrace.clear();
+    Status = m_sharedEvaluator->WalkMembers(iCorExceptionValue, pThread, FrameLevel{0}, false, [&](
+        ICorDebugType*,
+        bool,
+        const std::string &memberName,
+        Evaluator::GetValueCallback getValue,
+        Evaluator::SetterData*)
+    {
+        if (memberName != "StackTrace")
+            return S_OK;
+
+        ToRelease<ICorDebugValue> iCorResultValue;
+        IfFailRet(getValue(&iCorResultValue, defaultEvalFlags));
+        PrintNotNullValue(iCorResultValue, stackTrace);
+        return E_ABORT; // Fast exit from cycle.
+    });
+
+    return Status == E_ABORT ? S_OK : Status;
+}
+
 /*
     Implemented exception callback logic by dwEventType (CorDebugExceptionCallbackType):
 
@@ -366,7 +569,7 @@ HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, Excepti
     https://github.com/OmniSharp/omnisharp-vscode/blob/master/debugger.md#exception-settings
     https://docs.microsoft.com/en-us/visualstudio/debugger/managing-exceptions-with-the-debugger
 */
-HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string excModule, StoppedEvent &event)
+HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, ICorDebugModule *pExcModule, StoppedEvent &event)
 {
     HRESULT Status;
     DWORD tid = 0;
@@ -377,11 +580,14 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
     if (iCorExceptionValue == nullptr)
         return E_FAIL;
 
-    std::string excType;
-    if (FAILED(TypePrinter::GetTypeOfValue(iCorExceptionValue, excType)))
-    {
-        excType = "<unknown exception>";
-    }
+    // Note, exception type name and module name are resolved only in case we really stop, throw-heavy code
+    // generate a lot of first chance exceptions, that are filtered out by type tokens.
+    std::vector<TypeToken> excTypeHierarchy;
+    if (FAILED(GetTypeHierarchy(iCorExceptionValue, excTypeHierarchy)))
+        excTypeHierarchy.clear();
+
+    ToRelease<ICorDebugModule> iCorExcModule;
+    SetExceptionModule(iCorExcModule, pExcModule);
 
     std::lock_guard<std::mutex> lock(m_threadsExceptionMutex);
 
@@ -393,10 +599,10 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
             m_threadsExceptionBreakMode[tid] = ExceptionBreakMode::NEVER;
 
             m_threadsExceptionStatus[tid].m_lastEvent = ExceptionCallbackType::FIRST_CHANCE;
-            m_threadsExceptionStatus[tid].m_excModule = excModule;
+            SetExceptionModule(m_threadsExceptionStatus[tid].m_iCorExcModule, pExcModule);
 
-            if (!CoveredByFilter(ExceptionBreakpointFilter::THROW, excType, ExceptionCategory::CLR) &&
-                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excType, ExceptionCategory::CLR))
+            if (!CoveredByFilter(ExceptionBreakpointFilter::THROW, excTypeHierarchy, ExceptionCategory::CLR) &&
+                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excTypeHierarchy, ExceptionCategory::CLR))
                 return S_OK;
 
             m_threadsExceptionBreakMode[tid] = ExceptionBreakMode::THROW;
@@ -410,17 +616,17 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
             if (find != m_threadsExceptionStatus.end())
             {
                 m_threadsExceptionStatus[tid].m_lastEvent = ExceptionCallbackType::USER_FIRST_CHANCE;
-                if (find->second.m_excModule.empty())
-                    find->second.m_excModule = excModule;
+                if (find->second.m_iCorExcModule == nullptr)
+                    SetExceptionModule(find->second.m_iCorExcModule, pExcModule);
 
                 return S_OK;
             }
 
             m_threadsExceptionStatus[tid].m_lastEvent = ExceptionCallbackType::USER_FIRST_CHANCE;
-            m_threadsExceptionStatus[tid].m_excModule = excModule;
+            SetExceptionModule(m_threadsExceptionStatus[tid].m_iCorExcModule, pExcModule);
 
-            if (!CoveredByFilter(ExceptionBreakpointFilter::THROW, excType, ExceptionCategory::CLR) &&
-                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excType, ExceptionCategory::CLR))
+            if (!CoveredByFilter(ExceptionBreakpointFilter::THROW, excTypeHierarchy, ExceptionCategory::CLR) &&
+                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excTypeHierarchy, ExceptionCategory::CLR))
                 return S_OK;
 
             m_threadsExceptionBreakMode[tid] = ExceptionBreakMode::THROW;
@@ -437,14 +643,14 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
                 return S_OK;
             }
 
-            if (!CoveredByFilter(ExceptionBreakpointFilter::USER_UNHANDLED, excType, ExceptionCategory::CLR) &&
-                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excType, ExceptionCategory::CLR))
+            if (!CoveredByFilter(ExceptionBreakpointFilter::USER_UNHANDLED, excTypeHierarchy, ExceptionCategory::CLR) &&
+                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excTypeHierarchy, ExceptionCategory::CLR))
             {
                 m_threadsExceptionStatus.erase(tid);
                 return S_OK;
             }
 
-            excModule = m_threadsExceptionStatus[tid].m_excModule;
+            iCorExcModule = m_threadsExceptionStatus[tid].m_iCorExcModule.Detach();
             m_threadsExceptionStatus.erase(tid);
 
             m_threadsExceptionBreakMode[tid] = ExceptionBreakMode::USER_UNHANDLED;
@@ -465,12 +671,12 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
             // By current logic, debugger must stop at all unhandled exception (that will crash application), no matter what user has configured.
             // TODO some exception like System.AppDomainUnloadedException or System.Threading.ThreadAbortException, could be ignored at unhandled,
             // since they don't crash application, in this case:
-            //     if (CoveredByFilter(ExceptionBreakpointFilter::UNHANDLED, excType, ExceptionCategory::CLR)) - forced to emit event
+            //     if (CoveredByFilter(ExceptionBreakpointFilter::UNHANDLED, excTypeHierarchy, ExceptionCategory::CLR)) - forced to emit event
 
             auto find = m_threadsExceptionStatus.find(tid);
             if (find != m_threadsExceptionStatus.end())
             {
-                excModule = find->second.m_excModule;
+                iCorExcModule = find->second.m_iCorExcModule.Detach();
                 m_threadsExceptionStatus.erase(find);
             }
 
@@ -482,8 +688,14 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
             return E_INVALIDARG;
     }
 
-    if (excModule.empty())
-        excModule = "<unknown module>";
+    std::string excType;
+    if (FAILED(TypePrinter::GetTypeOfValue(iCorExceptionValue, excType)))
+    {
+        excType = "<unknown exception>";
+    }
+
+    std::string excModule;
+    GetExceptionModuleName(iCorExcModule, excModule);
 
     // Custom message, provided by runtime (in case internal runtime exception) or directly by user as exception constructor argument on throw.
     // Note, this is optional field in exception object that could have nulled reference.
@@ -517,6 +729,7 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
     });
 
     GetExceptionShorDescription(m_threadsExceptionBreakMode[tid], excType, excModule, event.text);
+    m_threadsExceptionModuleName[tid] = excModule;
     GetExceptionStageName(m_threadsExceptionBreakMode[tid], event.exception_stage);
     event.exception_category = "clr"; // ManagedCallbackException() called for CLR exceptions only
     event.exception_name = excType;
@@ -533,12 +746,55 @@ HRESULT ExceptionBreakpoints::ManagedCallbackExitThread(ICorDebugThread *pThread
 
     m_threadsExceptionMutex.lock();
     m_threadsExceptionBreakMode.erase(tid);
+    m_threadsExceptionModuleName.erase(tid);
     m_threadsExceptionStatus.erase(tid);
     m_threadsExceptionMutex.unlock();
 
     return S_OK;
 }
 
+HRESULT ExceptionBreakpoints::ManagedCallbackLoadModuleAll(ICorDebugModule *pModule)
+{
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
+    for (auto &filterMap : m_exceptionBreakpoints)
+    {
+        for (auto &expb : filterMap)
+        {
+            expb.second.ResolveConditionTypes(pModule);
+        }
+    }
+
+    return S_OK;
+}
+
+HRESULT ExceptionBreakpoints::ManagedCallbackUnloadModule(ICorDebugModule *pModule)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
+    // Module base address could be reused by next loaded module, remove resolved condition types of unloaded module.
+    for (auto &filterMap : m_exceptionBreakpoints)
+    {
+        for (auto &expb : filterMap)
+        {
+            auto &conditionTypes = expb.second.conditionTypes;
+            for (auto it = conditionTypes.begin(); it != conditionTypes.end();)
+            {
+                if (it->modAddress == modAddress)
+                    it = conditionTypes.erase(it);
+                else
+                    ++it;
+            }
+        }
+    }
+
+    return S_OK;
+}
+
 void ExceptionBreakpoints::AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list)
 {
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
@@ -563,7 +819,7 @@ void ExceptionBreakpoints::AddAllBreakpointsInfo(std::vector<IDebugger::Breakpoi
                 ss += " ";
                 ss += entry;
             }
-            list.emplace_back(IDebugger::BreakpointInfo{ bp.id, true, true, 0, "",
+            list.emplace_back(IDebugger::BreakpointInfo{ bp.id, true, true, bp.times, "",
                                                      "exception ", 0, 0, "", ss});
             ++it;
         }
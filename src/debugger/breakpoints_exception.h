@@ -9,7 +9,9 @@
 
 #include "interfaces/types.h"
 #include "interfaces/idebugger.h"
+#include "utils/torelease.h"
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <memory>
 #include <mutex>
@@ -19,13 +21,15 @@ namespace netcoredbg
 {
 
 class Evaluator;
+class Modules;
 class IDebugger;
 
 class ExceptionBreakpoints
 {
 public:
 
-    ExceptionBreakpoints(std::shared_ptr<Evaluator> &sharedEvaluator) :
+    ExceptionBreakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Evaluator> &sharedEvaluator) :
+        m_sharedModules(sharedModules),
         m_sharedEvaluator(sharedEvaluator),
         m_justMyCode(true),
         m_exceptionBreakpoints((size_t)ExceptionBreakpointFilter::Size)
@@ -35,8 +39,25 @@ public:
     void DeleteAll();
     HRESULT SetExceptionBreakpoints(const std::vector<ExceptionBreakpoint> &exceptionBreakpoints, std::vector<Breakpoint> &breakpoints,
                                     std::function<uint32_t()> getId);
-    HRESULT GetExceptionInfo(ICorDebugThread *pThread, ExceptionInfo &exceptionInfo);
-    bool CoveredByFilter(ExceptionBreakpointFilter filterId, const std::string &excType, ExceptionCategory excCategory);
+    // extendedDetails - collect extended tier of exception details (see GetExceptionExtendedDetails()), func-eval used.
+    HRESULT GetExceptionInfo(ICorDebugThread *pThread, bool extendedDetails, ExceptionInfo &exceptionInfo);
+    // Same as GetExceptionInfo(), but provide only exception stack trace (for stack frames with unknown source).
+    HRESULT GetExceptionStackTrace(ICorDebugThread *pThread, std::string &stackTrace);
+
+    // Exception type (or base type), that identified by module and TypeDef token.
+    struct TypeToken
+    {
+        CORDB_ADDRESS modAddress;
+        mdTypeDef typeDef;
+
+        bool operator==(const TypeToken &that) const { return modAddress == that.modAddress && typeDef == that.typeDef; }
+    };
+    struct TypeTokenHash
+    {
+        size_t operator()(const TypeToken &token) const { return std::hash<CORDB_ADDRESS>()(token.modAddress) ^ (size_t(token.typeDef) << 1); }
+    };
+    // excTypeHierarchy - exception type and all its base types.
+    bool CoveredByFilter(ExceptionBreakpointFilter filterId, const std::vector<TypeToken> &excTypeHierarchy, ExceptionCategory excCategory);
 
     // Important! Callbacks related methods must control return for succeeded return code.
     // Do not allow debugger API return succeeded (uncontrolled) return code.
@@ -45,19 +66,22 @@ public:
     // Good:
     //     IfFailRet(pThread->GetID(&threadId));
     //     return S_OK;
-    HRESULT ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string excModule, StoppedEvent &event);
+    HRESULT ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, ICorDebugModule *pExcModule, StoppedEvent &event);
     HRESULT ManagedCallbackExitThread(ICorDebugThread *pThread);
+    HRESULT ManagedCallbackLoadModuleAll(ICorDebugModule *pModule);
+    HRESULT ManagedCallbackUnloadModule(ICorDebugModule *pModule);
     void AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list);
 
 private:
 
+    std::shared_ptr<Modules> m_sharedModules;
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     bool m_justMyCode;
 
     struct ExceptionStatus
     {
         ExceptionCallbackType m_lastEvent;
-        std::string m_excModule;
+        ToRelease<ICorDebugModule> m_iCorExcModule;
 
         ExceptionStatus() :
             m_lastEvent(ExceptionCallbackType::FIRST_CHANCE)
@@ -68,20 +92,34 @@ private:
     std::unordered_map<DWORD, ExceptionStatus> m_threadsExceptionStatus;
     // Note, we have Exception callback called with different exception callback type, and we need know exception type that related to current stop event.
     std::unordered_map<DWORD, ExceptionBreakMode> m_threadsExceptionBreakMode;
-
-    HRESULT GetExceptionDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details);
+    // Module name of exception related to current stop event.
+    std::unordered_map<DWORD, std::string> m_threadsExceptionModuleName;
+
+    // Exception details are collected in two tiers:
+    // basic - type names, HResult, message and inner exceptions chain, read from exception object fields, no evaluation needed,
+    //         inner exceptions chain is limited by MaxInnerExceptionDepth;
+    // extended - stack trace and source ("StackTrace" and "Source" are properties, func-eval used), collected on demand only.
+    static const unsigned MaxInnerExceptionDepth = 8;
+    HRESULT GetExceptionBasicDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details, unsigned depth);
+    HRESULT GetExceptionExtendedDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details);
+    HRESULT GetStoppedException(ICorDebugThread *pThread, ICorDebugValue **ppExceptionValue, ExceptionBreakMode &breakMode);
 
     struct ManagedExceptionBreakpoint
     {
         uint32_t id;
         ExceptionCategory categoryHint;
         std::unordered_set<std::string> condition; // Note, only exception type related conditions allowed for now.
+        // Condition types resolved in all loaded modules, so, exception filtering don't need type names.
+        std::unordered_set<TypeToken, TypeTokenHash> conditionTypes;
         bool negativeCondition;
+        ULONG32 times;
 
         ManagedExceptionBreakpoint() :
-            id(0), categoryHint(ExceptionCategory::ANY), negativeCondition(false)
+            id(0), categoryHint(ExceptionCategory::ANY), negativeCondition(false), times(0)
         {}
 
+        void ResolveConditionTypes(ICorDebugModule *pModule);
+
         void ToBreakpoint(Breakpoint &breakpoint) const;
 
         ManagedExceptionBreakpoint(ManagedExceptionBreakpoint &&that) = default;
@@ -6,6 +6,7 @@
 #include "debugger/breakpointutils.h"
 #include "metadata/typeprinter.h"
 #include "metadata/modules.h"
+#include "utils/logger.h"
 #include <sstream>
 #include <unordered_set>
 #include <algorithm>
@@ -89,6 +90,13 @@ HRESULT FuncBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
             if (Status == S_FALSE)
                 continue;
 
+            // Filters don't use evaluation, check them first, so, other threads/callers hits cost nothing.
+            // Failed check (for example, caller frame can't be inspected) rejects hit for this breakpoint only.
+            if (FAILED(Status = BreakpointUtils::IsEnableByFilters(fbp.filters, m_sharedThreads.get(), pThread)))
+                LOGW("Can't check filters of function breakpoint %u, %0x", fbp.id, Status);
+            if (Status != S_OK)
+                continue;
+
             std::string output;
             if (FAILED(Status = BreakpointUtils::IsEnableByCondition(fbp.condition, m_sharedVariables.get(), pThread, output)))
             {
@@ -187,6 +195,7 @@ HRESULT FuncBreakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<
             fbp.name = fb.func;
             fbp.params = fb.params;
             fbp.condition = fb.condition;
+            fbp.filters.Set(fb.filters);
 
             if (haveProcess)
                 ResolveFuncBreakpoint(fbp);
@@ -199,6 +208,7 @@ HRESULT FuncBreakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<
             ManagedFuncBreakpoint &fbp = b->second;
 
             fbp.condition = fb.condition;
+            fbp.filters.Set(fb.filters);
             fbp.ToBreakpoint(breakpoint);
         }
 
@@ -15,6 +15,7 @@
 #include <string>
 #include <unordered_map>
 #include "interfaces/idebugger.h"
+#include "debugger/breakpointutils.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -22,14 +23,17 @@ namespace netcoredbg
 
 class Variables;
 class Modules;
+class Threads;
 
 class FuncBreakpoints
 {
 public:
 
-    FuncBreakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Variables> &sharedVariables) :
+    FuncBreakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Variables> &sharedVariables,
+                    std::shared_ptr<Threads> &sharedThreads) :
         m_sharedModules(sharedModules),
         m_sharedVariables(sharedVariables),
+        m_sharedThreads(sharedThreads),
         m_justMyCode(true)
     {}
 
@@ -60,6 +64,7 @@ private:
 
     std::shared_ptr<Modules> m_sharedModules;
     std::shared_ptr<Variables> m_sharedVariables;
+    std::shared_ptr<Threads> m_sharedThreads;
     bool m_justMyCode;
 
     struct ManagedFuncBreakpoint
@@ -88,6 +93,7 @@ private:
         ULONG32 times;
         bool enabled;
         std::string condition;
+        BreakpointUtils::HitFilters filters;
         std::list<internalFuncBreakpoint> funcBreakpoints;
 
         bool IsResolved() const { return module_checked; }
@@ -4,8 +4,11 @@
 
 #include "debugger/breakpoints_line.h"
 #include "debugger/breakpointutils.h"
+#include "debugger/tracerecorder.h"
+#include "debugger/variables.h"
 #include "metadata/modules.h"
 #include "utils/filesystem.h"
+#include "utils/logger.h"
 #include <unordered_set>
 #include <algorithm>
 
@@ -23,10 +26,20 @@ void LineBreakpoints::ManagedLineBreakpoint::ToBreakpoint(Breakpoint &breakpoint
     breakpoint.hitCount = this->times;
 }
 
+void LineBreakpoints::ManagedLineBreakpoint::SetFilters(const LineBreakpoint &lineBreakpoint)
+{
+    this->condition = lineBreakpoint.condition;
+    this->traceExpressions = lineBreakpoint.traceExpressions;
+    this->filters.Set(lineBreakpoint.filters);
+    // Note, hit condition was validated at breakpoint setup, see SetLineBreakpoints().
+    BreakpointUtils::ParseHitCondition(lineBreakpoint.hitCondition, this->hitCondition);
+}
+
 void LineBreakpoints::DeleteAll()
 {
     m_breakpointsMutex.lock();
     m_lineResolvedBreakpoints.clear();
+    m_funcBreakpointsIndex.clear();
     m_lineBreakpointMapping.clear();
     m_breakpointsMutex.unlock();
 }
@@ -77,6 +90,13 @@ HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
             if (Status == S_FALSE)
                 continue;
 
+            // Filters don't use evaluation, check them first, so, other threads/callers hits cost nothing.
+            // Failed check (for example, caller frame can't be inspected) rejects hit for this breakpoint only.
+            if (FAILED(Status = BreakpointUtils::IsEnableByFilters(b.filters, m_sharedThreads.get(), pThread)))
+                LOGW("Can't check filters of line breakpoint %u, %0x", b.id, Status);
+            if (Status != S_OK)
+                continue;
+
             std::string output;
             if (FAILED(Status = BreakpointUtils::IsEnableByCondition(b.condition, m_sharedVariables.get(), pThread, output)))
             {
@@ -87,6 +107,16 @@ HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
                 continue;
 
             ++b.times;
+
+            if (!b.hitCondition.IsEnabled(b.times))
+                continue;
+
+            if (!b.traceExpressions.empty())
+            {
+                RecordTracepointHit(pThread, b, sp.document);
+                return S_FALSE; // tracepoint don't stop debuggee
+            }
+
             b.ToBreakpoint(breakpoint, sp.document);
 
             if (!output.empty())
@@ -102,6 +132,93 @@ HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
     return S_FALSE; // Stopped at break, but breakpoint not found.
 }
 
+// Called by runtime callback thread, so, must not block and must not use evaluation (process can't be continued for
+// evaluation in callback). Same as CheckBreakpointHit(), but only for breakpoints with cheap filters (thread id, hit count).
+// In case all breakpoints for this line rejected, hit counters are updated. In case decision can't be made here,
+// nothing changed and hit will be processed again by CheckBreakpointHit() in callbacks queue.
+HRESULT LineBreakpoints::CheckBreakpointFilters(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
+{
+    std::unique_lock<std::mutex> lock(m_breakpointsMutex, std::try_to_lock);
+    if (!lock.owns_lock() || m_lineResolvedBreakpoints.empty())
+        return S_FALSE;
+
+    ToRelease<ICorDebugFunctionBreakpoint> iCorFuncBreakpoint;
+    if (FAILED(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID*) &iCorFuncBreakpoint)))
+        return S_FALSE;
+
+    auto index = m_funcBreakpointsIndex.find(iCorFuncBreakpoint.GetPtr());
+    if (index == m_funcBreakpointsIndex.end())
+        return S_FALSE;
+
+    auto breakpointsInSource = m_lineResolvedBreakpoints.find(index->second.first);
+    if (breakpointsInSource == m_lineResolvedBreakpoints.end())
+        return S_FALSE;
+
+    auto breakpointsInLine = breakpointsInSource->second.find(index->second.second);
+    if (breakpointsInLine == breakpointsInSource->second.end())
+        return S_FALSE;
+
+    std::list<ManagedLineBreakpoint> *bList = &breakpointsInLine->second;
+
+    DWORD threadId = 0;
+    if (FAILED(pThread->GetID(&threadId)))
+        return S_FALSE;
+
+    std::vector<ManagedLineBreakpoint*> counted;
+    for (auto &b : *bList)
+    {
+        if (!b.enabled)
+            continue;
+
+        if (!b.filters.HaveOnlyThreadIds())
+            return S_FALSE; // thread name and caller module filters need debuggee memory access
+
+        if (!b.filters.threadIds.empty() && b.filters.threadIds.find(threadId) == b.filters.threadIds.end())
+            continue;
+
+        if (!b.condition.empty() || b.hitCondition.IsEnabled(b.times + 1))
+            return S_FALSE; // condition need evaluation or breakpoint hit
+
+        counted.push_back(&b);
+    }
+
+    for (auto b : counted)
+    {
+        ++b->times;
+    }
+
+    return S_OK;
+}
+
+void LineBreakpoints::RecordTracepointHit(ICorDebugThread *pThread, const ManagedLineBreakpoint &bp, const std::string &fullname)
+{
+    // Don't waste time for evaluation, if hit can't be recorded.
+    if (!m_sharedTraceRecorder->IsRecording())
+        return;
+
+    const TraceRecorder::Clock::time_point hitTime = TraceRecorder::Clock::now();
+
+    DWORD threadId = 0;
+    ToRelease<ICorDebugProcess> iCorProcess;
+    if (FAILED(pThread->GetID(&threadId)) || FAILED(pThread->GetProcess(&iCorProcess)))
+        return;
+
+    FrameId frameId(ThreadId{threadId}, FrameLevel{0});
+    std::vector<std::string> values;
+    values.reserve(bp.traceExpressions.size());
+    for (const auto &expression : bp.traceExpressions)
+    {
+        Variable variable;
+        std::string output;
+        if (SUCCEEDED(m_sharedVariables->Evaluate(iCorProcess, frameId, expression, variable, output)))
+            values.emplace_back(std::move(variable.value));
+        else
+            values.emplace_back("<error: " + (output.empty() ? std::string("unknown error") : output) + ">");
+    }
+
+    m_sharedTraceRecorder->Record(bp.id, fullname + ":" + std::to_string(bp.linenum), bp.traceExpressions, threadId, hitTime, values);
+}
+
 static HRESULT EnableOneICorBreakpointForLine(std::list<LineBreakpoints::ManagedLineBreakpoint> &bList)
 {
     // Same logic as provide vsdbg - only one breakpoint is active for one line.
@@ -132,6 +249,27 @@ static HRESULT EnableOneICorBreakpointForLine(std::list<LineBreakpoints::Managed
     return Status;
 }
 
+void LineBreakpoints::AddResolvedBreakpoint(unsigned resolved_fullname_index, int resolved_linenum, ManagedLineBreakpoint &&bp)
+{
+    // Note, ICorDebugFunctionBreakpoint address could be reused by new object after release, so, always overwrite.
+    for (const auto &iCorFuncBreakpoint : bp.iCorFuncBreakpoints)
+    {
+        m_funcBreakpointsIndex[iCorFuncBreakpoint.GetPtr()] = std::make_pair(resolved_fullname_index, resolved_linenum);
+    }
+
+    std::list<ManagedLineBreakpoint> &bList = m_lineResolvedBreakpoints[resolved_fullname_index][resolved_linenum];
+    bList.push_back(std::move(bp));
+    EnableOneICorBreakpointForLine(bList);
+}
+
+void LineBreakpoints::RemoveFromIndex(const ManagedLineBreakpoint &bp)
+{
+    for (const auto &iCorFuncBreakpoint : bp.iCorFuncBreakpoints)
+    {
+        m_funcBreakpointsIndex.erase(iCorFuncBreakpoint.GetPtr());
+    }
+}
+
 // [in] pModule - optional, provide filter by module during resolve
 // [in,out] bp - breakpoint data for resolve
 static HRESULT ResolveLineBreakpoint(Modules *pModules, ICorDebugModule *pModule, LineBreakpoints::ManagedLineBreakpoint &bp, const std::string &bp_fullname,
@@ -246,7 +384,7 @@ HRESULT LineBreakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std
             bp.enabled = initialBreakpoint.enabled;
             bp.linenum = initialBreakpoint.breakpoint.line;
             bp.endLine = initialBreakpoint.breakpoint.line;
-            bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.SetFilters(initialBreakpoint.breakpoint);
             unsigned resolved_fullname_index = 0;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
 
@@ -264,8 +402,7 @@ HRESULT LineBreakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std
             initialBreakpoint.resolved_fullname_index = resolved_fullname_index;
             initialBreakpoint.resolved_linenum = bp.linenum;
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, initialBreakpoint.resolved_linenum, std::move(bp));
         }
     }
 
@@ -308,6 +445,7 @@ HRESULT LineBreakpoints::UpdateLineBreakpoint(bool haveProcess, int id, int line
                     {
                         modAddress = (*itList).modAddress;
 
+                        RemoveFromIndex(*itList);
                         bList_it->second.erase(itList);
                         initialBreakpoint.resolved_linenum = 0;
                         initialBreakpoint.resolved_fullname_index = 0;
@@ -325,7 +463,7 @@ HRESULT LineBreakpoints::UpdateLineBreakpoint(bool haveProcess, int id, int line
             bp.enabled = initialBreakpoint.enabled;
             bp.linenum = initialBreakpoint.breakpoint.line;
             bp.endLine = initialBreakpoint.breakpoint.line;
-            bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.SetFilters(initialBreakpoint.breakpoint);
 
             unsigned resolved_fullname_index = 0;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
@@ -343,8 +481,7 @@ HRESULT LineBreakpoints::UpdateLineBreakpoint(bool haveProcess, int id, int line
 
             bp.ToBreakpoint(breakpoint, resolved_fullname);
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, initialBreakpoint.resolved_linenum, std::move(bp));
             return S_OK;
         }
     }
@@ -375,6 +512,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
         {
             if ((*itList).id == initialBreakpoint.id)
             {
+                RemoveFromIndex(*itList);
                 itList = bList_it->second.erase(itList);
                 EnableOneICorBreakpointForLine(bList_it->second);
                 break;
@@ -407,11 +545,19 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
     auto &breakpointsInSource = m_lineBreakpointMapping[filename];
     std::unordered_map<int, ManagedLineBreakpointMapping*> breakpointsInSourceMap;
 
+    // Breakpoints with wrong hit condition are not created (and previously created for this line are removed).
+    auto IsHitConditionValid = [](const LineBreakpoint &sb) -> bool
+    {
+        BreakpointUtils::HitCondition hitCondition;
+        return SUCCEEDED(BreakpointUtils::ParseHitCondition(sb.hitCondition, hitCondition));
+    };
+
     // Remove old breakpoints
     std::unordered_set<int> funcBreakpointLines;
     for (const auto &sb : lineBreakpoints)
     {
-        funcBreakpointLines.insert(sb.line);
+        if (IsHitConditionValid(sb))
+            funcBreakpointLines.insert(sb.line);
     }
     for (auto it = breakpointsInSource.begin(); it != breakpointsInSource.end();)
     {
@@ -436,6 +582,18 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
         int line = sb.line;
         Breakpoint breakpoint;
 
+        if (!IsHitConditionValid(sb))
+        {
+            breakpoint.verified = false;
+            breakpoint.source = Source(filename);
+            breakpoint.line = line;
+            breakpoint.endLine = line;
+            breakpoint.condition = sb.condition;
+            breakpoint.message = "The hit count condition '" + sb.hitCondition + "' is not valid. Use 'N', '==N', '>=N', '>N' or '%N' form.";
+            breakpoints.push_back(breakpoint);
+            continue;
+        }
+
         auto b = breakpointsInSourceMap.find(line);
         if (b == breakpointsInSourceMap.end())
         {
@@ -449,7 +607,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
             bp.module = initialBreakpoint.breakpoint.module;
             bp.linenum = line;
             bp.endLine = line;
-            bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.SetFilters(initialBreakpoint.breakpoint);
             unsigned resolved_fullname_index = 0;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
 
@@ -462,8 +620,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
                 std::string resolved_fullname;
                 m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, resolved_fullname);
                 bp.ToBreakpoint(breakpoint, resolved_fullname);
-                m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-                EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+                AddResolvedBreakpoint(resolved_fullname_index, initialBreakpoint.resolved_linenum, std::move(bp));
             }
             else
             {
@@ -480,6 +637,9 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
         {
             ManagedLineBreakpointMapping &initialBreakpoint = *b->second;
             initialBreakpoint.breakpoint.condition = sb.condition;
+            initialBreakpoint.breakpoint.traceExpressions = sb.traceExpressions;
+            initialBreakpoint.breakpoint.hitCondition = sb.hitCondition;
+            initialBreakpoint.breakpoint.filters = sb.filters;
 
             if (initialBreakpoint.resolved_linenum)
             {
@@ -497,7 +657,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
                         continue;
 
                     // Existing breakpoint
-                    bp.condition = initialBreakpoint.breakpoint.condition;
+                    bp.SetFilters(initialBreakpoint.breakpoint);
                     std::string resolved_fullname;
                     m_sharedModules->GetSourceFullPathByIndex(initialBreakpoint.resolved_fullname_index, resolved_fullname);
                     bp.ToBreakpoint(breakpoint, resolved_fullname);
@@ -512,7 +672,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
                 bp.module = initialBreakpoint.breakpoint.module;
                 bp.linenum = line;
                 bp.endLine = line;
-                bp.condition = initialBreakpoint.breakpoint.condition;
+                bp.SetFilters(initialBreakpoint.breakpoint);
                 bp.ToBreakpoint(breakpoint, filename);
                 if (!haveProcess)
                     breakpoint.message = "The breakpoint is pending and will be resolved when debugging starts.";
@@ -555,6 +715,7 @@ HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
                     if ((*itList).id == initialBreakpoint.id && (*itList).modAddress == modAddress)
                     {
                         // Remove related resolved breakpoint and reset initial breakpoint to "unresolved" state.
+                        RemoveFromIndex(*itList);
                         bList_it->second.erase(itList);
                         initialBreakpoint.resolved_linenum = 0;
                         initialBreakpoint.resolved_fullname_index = 0;
@@ -574,7 +735,7 @@ HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
             bp.enabled = initialBreakpoint.enabled;
             bp.linenum = initialBreakpoint.breakpoint.line;
             bp.endLine = initialBreakpoint.breakpoint.line;
-            bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.SetFilters(initialBreakpoint.breakpoint);
             unsigned resolved_fullname_index = 0;
             Breakpoint breakpoint;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
@@ -603,8 +764,7 @@ HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
                 events.emplace_back(BreakpointChanged, breakpoint);
             }
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, initialBreakpoint.resolved_linenum, std::move(bp));
         }
     }
 
@@ -14,6 +14,7 @@
 #include <string>
 #include <unordered_map>
 #include "interfaces/idebugger.h"
+#include "debugger/breakpointutils.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -21,14 +22,19 @@ namespace netcoredbg
 
 class Variables;
 class Modules;
+class Threads;
+class TraceRecorder;
 
 class LineBreakpoints
 {
 public:
 
-    LineBreakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Variables> &sharedVariables) :
+    LineBreakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Variables> &sharedVariables,
+                    std::shared_ptr<Threads> &sharedThreads, std::shared_ptr<TraceRecorder> &sharedTraceRecorder) :
         m_sharedModules(sharedModules),
         m_sharedVariables(sharedVariables),
+        m_sharedThreads(sharedThreads),
+        m_sharedTraceRecorder(sharedTraceRecorder),
         m_justMyCode(true)
     {}
 
@@ -46,6 +52,10 @@ public:
     // S_OK - breakpoint hit
     // S_FALSE - no breakpoint hit
     HRESULT CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, std::vector<BreakpointEvent> &bpChangeEvents);
+    // Early check in runtime callback thread:
+    // S_OK - breakpoint hit rejected by thread id or hit count filters, process could be continued
+    // S_FALSE - breakpoint hit must be checked by CheckBreakpointHit()
+    HRESULT CheckBreakpointFilters(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
 
     // Important! Callbacks related methods must control return for succeeded return code.
     // Do not allow debugger API return succeeded (uncontrolled) return code.
@@ -66,6 +76,9 @@ public:
         bool enabled;
         ULONG32 times;
         std::string condition;
+        std::vector<std::string> traceExpressions;
+        BreakpointUtils::HitCondition hitCondition;
+        BreakpointUtils::HitFilters filters;
         // In case of code line in constructor, we could resolve multiple methods for breakpoints.
         // For example, `MyType obj = new MyType(1);` code will be added to all class constructors).
         std::vector<ToRelease<ICorDebugFunctionBreakpoint> > iCorFuncBreakpoints;
@@ -86,6 +99,7 @@ public:
         }
 
         void ToBreakpoint(Breakpoint &breakpoint, const std::string &fullname);
+        void SetFilters(const LineBreakpoint &lineBreakpoint);
 
         ManagedLineBreakpoint(ManagedLineBreakpoint &&that) = default;
         ManagedLineBreakpoint(const ManagedLineBreakpoint &that) = delete;
@@ -97,8 +111,15 @@ private:
 
     std::shared_ptr<Modules> m_sharedModules;
     std::shared_ptr<Variables> m_sharedVariables;
+    std::shared_ptr<Threads> m_sharedThreads;
+    std::shared_ptr<TraceRecorder> m_sharedTraceRecorder;
     bool m_justMyCode;
 
+    void RecordTracepointHit(ICorDebugThread *pThread, const ManagedLineBreakpoint &bp, const std::string &fullname);
+    // Caller must care about m_breakpointsMutex.
+    void AddResolvedBreakpoint(unsigned resolved_fullname_index, int resolved_linenum, ManagedLineBreakpoint &&bp);
+    void RemoveFromIndex(const ManagedLineBreakpoint &bp);
+
     struct ManagedLineBreakpointMapping
     {
         LineBreakpoint breakpoint;
@@ -116,6 +137,9 @@ private:
     // Mapped in order to fast search with mapping data (see container below):
     // resolved source full path index -> resolved line number -> list of all ManagedLineBreakpoint resolved to this line.
     std::unordered_map<unsigned, std::unordered_map<int, std::list<ManagedLineBreakpoint> > > m_lineResolvedBreakpoints;
+    // Index for fast search in runtime callback (see CheckBreakpointFilters()):
+    // ICorDebugFunctionBreakpoint of resolved breakpoint -> resolved source full path index and resolved line number.
+    std::unordered_map<ICorDebugFunctionBreakpoint*, std::pair<unsigned, int> > m_funcBreakpointsIndex;
     // Mapping for input LineBreakpoint array (input from protocol) to ManagedLineBreakpoint or unresolved breakpoint.
     // Note, instead of FuncBreakpoint for resolved breakpoint we could have changed source path and/or line number.
     // In this way we could connect new input data with previous data and properly add/remove resolved and unresolved breakpoints.
@@ -3,9 +3,16 @@
 // See the LICENSE file in the project root for more information.
 
 #include "debugger/breakpointutils.h"
+#include "debugger/threads.h"
 #include "debugger/variables.h"
 #include "metadata/attributes.h"
+#include "metadata/modules.h"
+#include "utils/filesystem.h"
 #include "utils/torelease.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 namespace netcoredbg
 {
@@ -13,6 +20,60 @@ namespace netcoredbg
 namespace BreakpointUtils
 {
 
+namespace
+{
+
+    // "/path/to/Module.dll" -> "Module", so, user could provide module with or without path and extension.
+    std::string GetModuleFilterName(const std::string &path)
+    {
+        std::string name = GetBasename(path);
+        std::string::size_type i = name.rfind('.');
+        if (i == std::string::npos)
+            return name;
+
+        // Extension could be in any case ("Module.DLL" on Windows).
+        std::string ext = name.substr(i);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (ext == ".dll" || ext == ".exe")
+            name.erase(i);
+        return name;
+    }
+
+    HRESULT GetCallerModuleFilterName(ICorDebugThread *pThread, std::string &name)
+    {
+        HRESULT Status;
+        ToRelease<ICorDebugFrame> iCorFrame;
+        IfFailRet(pThread->GetActiveFrame(&iCorFrame));
+        if (iCorFrame == nullptr)
+            return E_FAIL;
+
+        ToRelease<ICorDebugFrame> iCorCallerFrame;
+        IfFailRet(iCorFrame->GetCaller(&iCorCallerFrame));
+        if (iCorCallerFrame == nullptr)
+        {
+            // First frame in chain, caller could be in previous managed chain (for example, after native code).
+            ToRelease<ICorDebugChain> iCorChain;
+            ToRelease<ICorDebugChain> iCorCallerChain;
+            IfFailRet(iCorFrame->GetChain(&iCorChain));
+            IfFailRet(iCorChain->GetCaller(&iCorCallerChain));
+            if (iCorCallerChain == nullptr)
+                return S_FALSE;
+            IfFailRet(iCorCallerChain->GetActiveFrame(&iCorCallerFrame));
+            if (iCorCallerFrame == nullptr)
+                return S_FALSE;
+        }
+
+        ToRelease<ICorDebugFunction> iCorFunction;
+        ToRelease<ICorDebugModule> iCorModule;
+        IfFailRet(iCorCallerFrame->GetFunction(&iCorFunction));
+        IfFailRet(iCorFunction->GetModule(&iCorModule));
+
+        name = GetModuleFilterName(GetModuleFileName(iCorModule));
+        return S_OK;
+    }
+
+} // unnamed namespace
+
 HRESULT IsSameFunctionBreakpoint(ICorDebugFunctionBreakpoint *pBreakpoint1, ICorDebugFunctionBreakpoint *pBreakpoint2)
 {
     HRESULT Status;
@@ -140,6 +201,107 @@ HRESULT SkipBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, bool j
     return S_FALSE; // don't skip breakpoint
 }
 
+bool HitCondition::IsEnabled(ULONG32 hitCount) const
+{
+    switch (kind)
+    {
+        case Kind::None:           return true;
+        case Kind::Equal:          return hitCount == value;
+        case Kind::GreaterOrEqual: return hitCount >= value;
+        case Kind::Greater:        return hitCount > value;
+        case Kind::Multiple:       return value != 0 && hitCount % value == 0;
+    }
+    return true;
+}
+
+void HitFilters::Set(const BreakpointFilters &filters)
+{
+    threadIds.clear();
+    threadNames.clear();
+    callerModules.clear();
+
+    for (int threadId : filters.threadIds)
+        threadIds.insert(DWORD(threadId));
+    threadNames.insert(filters.threadNames.begin(), filters.threadNames.end());
+    for (const auto &module : filters.callerModules)
+        callerModules.insert(GetModuleFilterName(module));
+}
+
+HRESULT IsEnableByFilters(const HitFilters &filters, Threads *pThreads, ICorDebugThread *pThread)
+{
+    if (filters.IsEmpty())
+        return S_OK;
+
+    HRESULT Status;
+    if (!filters.threadIds.empty() || !filters.threadNames.empty())
+    {
+        DWORD threadId = 0;
+        IfFailRet(pThread->GetID(&threadId));
+        if (filters.threadIds.find(threadId) == filters.threadIds.end())
+        {
+            // Thread name is not cached, since it could be changed by debuggee at any time.
+            if (filters.threadNames.empty())
+                return S_FALSE;
+
+            ToRelease<ICorDebugProcess> iCorProcess;
+            IfFailRet(pThread->GetProcess(&iCorProcess));
+            if (filters.threadNames.find(pThreads->GetThreadName(iCorProcess, ThreadId{threadId})) == filters.threadNames.end())
+                return S_FALSE;
+        }
+    }
+
+    if (!filters.callerModules.empty())
+    {
+        std::string callerModule;
+        IfFailRet(GetCallerModuleFilterName(pThread, callerModule));
+        if (Status == S_FALSE || filters.callerModules.find(callerModule) == filters.callerModules.end())
+            return S_FALSE;
+    }
+
+    return S_OK;
+}
+
+HRESULT ParseHitCondition(const std::string &str, HitCondition &hitCondition)
+{
+    hitCondition = HitCondition();
+
+    std::string::size_type pos = str.find_first_not_of(" \t");
+    if (pos == std::string::npos)
+        return S_OK;
+
+    static const std::pair<const char*, HitCondition::Kind> operators[] = {
+        {"==", HitCondition::Kind::Equal},
+        {">=", HitCondition::Kind::GreaterOrEqual},
+        {">",  HitCondition::Kind::Greater},
+        {"%",  HitCondition::Kind::Multiple}
+    };
+    HitCondition::Kind kind = HitCondition::Kind::Equal;
+    for (const auto &op : operators)
+    {
+        if (str.compare(pos, strlen(op.first), op.first) == 0)
+        {
+            kind = op.second;
+            pos += strlen(op.first);
+            break;
+        }
+    }
+
+    pos = str.find_first_not_of(" \t", pos);
+    if (pos == std::string::npos || !isdigit((unsigned char)str[pos]))
+        return E_INVALIDARG;
+
+    char *end = nullptr;
+    unsigned long value = strtoul(str.c_str() + pos, &end, 10);
+    while (*end == ' ' || *end == '\t')
+        end++;
+    if (*end != '\0' || value > ULONG32(-1) || (kind == HitCondition::Kind::Multiple && value == 0))
+        return E_INVALIDARG;
+
+    hitCondition.kind = kind;
+    hitCondition.value = ULONG32(value);
+    return S_OK;
+}
+
 } // namespace BreakpointUtils
 
 } // namespace netcoredbg
@@ -8,17 +8,56 @@
 #include "cordebug.h"
 
 #include <string>
+#include <unordered_set>
+#include "interfaces/types.h"
 
 namespace netcoredbg
 {
 
 class Variables;
+class Threads;
 
 namespace BreakpointUtils
 {
     HRESULT IsSameFunctionBreakpoint(ICorDebugFunctionBreakpoint *pBreakpoint1, ICorDebugFunctionBreakpoint *pBreakpoint2);
     HRESULT IsEnableByCondition(const std::string &condition, Variables *pVariables, ICorDebugThread *pThread, std::string &output);
     HRESULT SkipBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, bool justMyCode);
+
+    // Hit count condition, parsed once at breakpoint setup, so, check at breakpoint hit is cheap.
+    struct HitCondition
+    {
+        enum class Kind
+        {
+            None,
+            Equal,
+            GreaterOrEqual,
+            Greater,
+            Multiple
+        };
+
+        Kind kind = Kind::None;
+        ULONG32 value = 0;
+
+        bool IsEmpty() const { return kind == Kind::None; }
+        bool IsEnabled(ULONG32 hitCount) const;
+    };
+    // Supported forms: "N" or "==N", ">=N", ">N", "%N". Empty string - no hit condition.
+    HRESULT ParseHitCondition(const std::string &str, HitCondition &hitCondition);
+
+    // Thread and caller module filters, sets are prepared once at breakpoint setup.
+    struct HitFilters
+    {
+        std::unordered_set<DWORD> threadIds;
+        std::unordered_set<std::string> threadNames;
+        std::unordered_set<std::string> callerModules; // module file names without extension
+
+        void Set(const BreakpointFilters &filters);
+        bool IsEmpty() const { return threadIds.empty() && threadNames.empty() && callerModules.empty(); }
+        // Filters, that could be checked without debuggee memory access.
+        bool HaveOnlyThreadIds() const { return threadNames.empty() && callerModules.empty(); }
+    };
+    // S_OK - hit pass filters, S_FALSE - hit rejected.
+    HRESULT IsEnableByFilters(const HitFilters &filters, Threads *pThreads, ICorDebugThread *pThread);
 }
 
 } // namespace netcoredbg
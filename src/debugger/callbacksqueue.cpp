@@ -13,6 +13,7 @@
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
+#include "debugger/outputaggregator.h"
 #include "interfaces/iprotocol.h"
 
 #include <algorithm>
@@ -21,6 +22,13 @@
 namespace netcoredbg
 {
 
+void CallbacksQueue::EmitStoppedEvent(const StoppedEvent &event)
+{
+    // Debuggee output produced before stop must be delivered before stopped event.
+    m_debugger.m_uniqueOutputAggregator->Flush();
+    m_debugger.pProtocol->EmitStoppedEvent(event);
+}
+
 bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
 {
     // S_FALSE or error - continue callback.
@@ -66,7 +74,7 @@ bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, I
         m_debugger.pProtocol->EmitOutputEvent(OutputStdErr, ss.str());
         m_debugger.pProtocol->EmitBreakpointEvent(changeEvent);
     }
-    m_debugger.pProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -93,7 +101,7 @@ bool CallbacksQueue::CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain,
 #endif // INTEROP_DEBUGGING
 
     m_debugger.SetLastStoppedThread(pThread);
-    m_debugger.pProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -123,12 +131,12 @@ bool CallbacksQueue::CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDe
 
     StoppedEvent event(StopPause, threadId);
     event.frame = stackFrame;
-    m_debugger.pProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
 
-bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule)
+bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ExceptionCallbackType eventType, ICorDebugModule *pExcModule)
 {
     m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread);
 
@@ -136,7 +144,7 @@ bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, IC
     StoppedEvent event(StopException, threadId);
 
     // S_FALSE - not error and not affect on callback (callback will emit stop event)
-    if (S_FALSE != m_debugger.m_sharedBreakpoints->ManagedCallbackException(pThread, eventType, excModule, event))
+    if (S_FALSE != m_debugger.m_sharedBreakpoints->ManagedCallbackException(pThread, eventType, pExcModule, event))
         return false;
 
     ToRelease<ICorDebugFrame> pActiveFrame;
@@ -151,7 +159,7 @@ bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, IC
 #endif // INTEROP_DEBUGGING
 
     m_debugger.SetLastStoppedThread(pThread);
-    m_debugger.pProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -189,7 +197,7 @@ void CallbacksQueue::CallbacksWorker()
             m_stopEventInProcess = CallbacksWorkerBreak(c.iCorAppDomain, c.iCorThread);
             break;
         case CallbackQueueCall::Exception:
-            m_stopEventInProcess = CallbacksWorkerException(c.iCorAppDomain, c.iCorThread, c.EventType, c.ExcModule);
+            m_stopEventInProcess = CallbacksWorkerException(c.iCorAppDomain, c.iCorThread, c.EventType, c.iCorExcModule);
             break;
         case CallbackQueueCall::CreateProcess:
             m_stopEventInProcess = CallbacksWorkerCreateProcess();
@@ -372,6 +380,23 @@ HRESULT CallbacksQueue::Stop(ICorDebugProcess *pProcess)
     return InternalStop(pProcess, m_stopEventInProcess);
 }
 
+HRESULT CallbacksQueue::Sample(ICorDebugProcess *pProcess, std::function<void()> cb)
+{
+    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+
+    if (m_stopEventInProcess || !m_callbacksQueue.empty())
+        return S_FALSE;
+
+    // Note, we don't log errors here, since this is called by timer and process could exit at any moment.
+    HRESULT Status;
+    if (FAILED(Status = pProcess->Stop(0)))
+        return Status;
+
+    cb();
+
+    return pProcess->Continue(0);
+}
+
 // Stop process and set last stopped thread. If `lastStoppedThread` not passed value from protocol, find best thread.
 HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedThread, EventFormat eventFormat)
 {
@@ -408,7 +433,7 @@ HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedTh
         {
             // VSCode protocol event must provide thread only (VSCode count on this), even if this thread don't have user code.
             m_debugger.SetLastStoppedThreadId(lastStoppedThread);
-            m_debugger.pProtocol->EmitStoppedEvent(StoppedEvent(StopPause, lastStoppedThread));
+            EmitStoppedEvent(StoppedEvent(StopPause, lastStoppedThread));
             m_debugger.m_ioredirect.async_cancel();
             return S_OK;
         }
@@ -437,7 +462,7 @@ HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedTh
         {
             event.frame = stackFrames[0];
         }
-        m_debugger.pProtocol->EmitStoppedEvent(event);
+        EmitStoppedEvent(event);
         m_debugger.m_ioredirect.async_cancel();
         return S_OK;
     }
@@ -475,7 +500,7 @@ HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedTh
                 StoppedEvent event(StopPause, thread.id);
                 event.frame = stackFrame;
                 m_debugger.SetLastStoppedThreadId(thread.id);
-                m_debugger.pProtocol->EmitStoppedEvent(event);
+                EmitStoppedEvent(event);
                 m_debugger.m_ioredirect.async_cancel();
                 return S_OK;
             }
@@ -503,9 +528,9 @@ CallbacksQueue::~CallbacksQueue()
 
 // NOTE caller must care about m_callbacksMutex.
 void CallbacksQueue::EmplaceBack(CallbackQueueCall Call, ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint,
-                                 CorDebugStepReason Reason, ExceptionCallbackType EventType, const std::string &ExcModule)
+                                 CorDebugStepReason Reason, ExceptionCallbackType EventType, ICorDebugModule *pExcModule)
 {
-    m_callbacksQueue.emplace_back(Call, pAppDomain, pThread, pBreakpoint, Reason, EventType, ExcModule);
+    m_callbacksQueue.emplace_back(Call, pAppDomain, pThread, pBreakpoint, Reason, EventType, pExcModule);
 }
 
 #ifdef INTEROP_DEBUGGING
@@ -532,7 +557,7 @@ bool CallbacksQueue::CallbacksWorkerInteropBreakpoint(pid_t pid, std::uintptr_t
         event.frame.line = event.breakpoint.line;
     }
 
-    m_debugger.pProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -559,7 +584,7 @@ bool CallbacksQueue::CallbacksWorkerInteropSignal(pid_t pid, std::uintptr_t brea
     }
 
     event.signal_name = signal;
-    m_debugger.pProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -51,12 +51,15 @@ public:
     HRESULT Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedThread, EventFormat eventFormat);
     // Analog of "pProcess->Stop(0)" call that also care about callbacks.
     HRESULT Stop(ICorDebugProcess *pProcess);
+    // Stop process for short time without stop event, call `cb` and continue process (sampling profiler).
+    // Return S_FALSE in case process is already stopped by debugger or have callbacks in queue, `cb` is not called in this case.
+    HRESULT Sample(ICorDebugProcess *pProcess, std::function<void()> cb);
 
     HRESULT ContinueProcess(ICorDebugProcess *pProcess);
     HRESULT ContinueAppDomain(ICorDebugAppDomain *pAppDomain);
     HRESULT AddCallbackToQueue(ICorDebugAppDomain *pAppDomain, std::function<void()> callback);
     void EmplaceBack(CallbackQueueCall Call, ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint,
-                     CorDebugStepReason Reason, ExceptionCallbackType EventType, const std::string &ExcModule = std::string{});
+                     CorDebugStepReason Reason, ExceptionCallbackType EventType, ICorDebugModule *pExcModule = nullptr);
 #ifdef INTEROP_DEBUGGING
     HRESULT AddInteropCallbackToQueue(std::function<void()> callback);
     void EmplaceBackInterop(CallbackQueueCall Call, pid_t pid, std::uintptr_t addr, const std::string &signal);
@@ -78,7 +81,7 @@ private:
         ToRelease<ICorDebugBreakpoint> iCorBreakpoint;
         CorDebugStepReason Reason = CorDebugStepReason::STEP_NORMAL; // Initial value in order to suppress static analyzer warnings.
         ExceptionCallbackType EventType = ExceptionCallbackType::FIRST_CHANCE; // Initial value in order to suppress static analyzer warnings.
-        std::string ExcModule;
+        ToRelease<ICorDebugModule> iCorExcModule; // module of method, that throw exception (name is resolved only for stop event)
 
         CallbackQueueEntry(CallbackQueueCall call,
                            ICorDebugAppDomain *pAppDomain,
@@ -86,14 +89,14 @@ private:
                            ICorDebugBreakpoint *pBreakpoint,
                            CorDebugStepReason reason,
                            ExceptionCallbackType eventType,
-                           const std::string &excModule = "") :
+                           ICorDebugModule *pExcModule = nullptr) :
             Call(call),
             iCorAppDomain(pAppDomain),
             iCorThread(pThread),
             iCorBreakpoint(pBreakpoint),
             Reason(reason),
             EventType(eventType),
-            ExcModule(excModule)
+            iCorExcModule(pExcModule)
         {}
 
 #ifdef INTEROP_DEBUGGING
@@ -123,9 +126,10 @@ private:
     bool CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
     bool CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason);
     bool CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread);
-    bool CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule);
+    bool CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ExceptionCallbackType eventType, ICorDebugModule *pExcModule);
     bool CallbacksWorkerCreateProcess();
     bool HasQueuedCallbacks(ICorDebugProcess *pProcess);
+    void EmitStoppedEvent(const StoppedEvent &event);
 
 #ifdef INTEROP_DEBUGGING
     bool CallbacksWorkerInteropBreakpoint(pid_t pid, std::uintptr_t brkAddr);
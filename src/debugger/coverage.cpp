@@ -0,0 +1,287 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "debugger/coverage.h"
+#include "metadata/modules.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    bool IsXmlFile(const std::string &path)
+    {
+        static const std::string ext(".xml");
+        if (path.size() < ext.size())
+            return false;
+
+        std::string pathExt = path.substr(path.size() - ext.size());
+        std::transform(pathExt.begin(), pathExt.end(), pathExt.begin(), [](unsigned char c) { return std::tolower(c); });
+        return pathExt == ext;
+    }
+
+    std::string EscapeXml(const std::string &str)
+    {
+        std::string result;
+        result.reserve(str.size());
+        for (char c : str)
+        {
+            switch (c)
+            {
+                case '&':  result += "&amp;";  break;
+                case '<':  result += "&lt;";   break;
+                case '>':  result += "&gt;";   break;
+                case '"':  result += "&quot;"; break;
+                case '\'': result += "&apos;"; break;
+                default:   result += c;        break;
+            }
+        }
+        return result;
+    }
+
+    std::string GetFileName(const std::string &path)
+    {
+        std::size_t i = path.find_last_of("/\\");
+        return i == std::string::npos ? path : path.substr(i + 1);
+    }
+
+    double Rate(size_t covered, size_t total)
+    {
+        return total == 0 ? 1.0 : double(covered) / double(total);
+    }
+
+} // unnamed namespace
+
+void CodeCoverage::SetOutputFile(const std::string &outputFile)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_outputFile = outputFile;
+}
+
+bool CodeCoverage::IsEnabled()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_outputFile.empty();
+}
+
+// Note, ICorDebug don't provide API for breakpoints creation in batch, so, all we could do is resolve function and IL code
+// only once per method (not per breakpoint). Also, breakpoint is created in active state, no need in Activate() call.
+HRESULT CodeCoverage::ManagedCallbackLoadModule(ICorDebugModule *pModule)
+{
+    if (!IsEnabled())
+        return S_OK;
+
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    std::vector<ModulesSources::module_sp_t> sequencePoints;
+    IfFailRet(m_sharedModules->GetModuleSequencePoints(modAddress, sequencePoints));
+    if (sequencePoints.empty())
+        return S_OK;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t armedCount = 0;
+    mdMethodDef currentToken = mdMethodDefNil;
+    ToRelease<ICorDebugCode> iCorCode;
+    for (const auto &sp : sequencePoints)
+    {
+        if (sp.methodToken != currentToken)
+        {
+            currentToken = sp.methodToken;
+            iCorCode.Free();
+
+            ToRelease<ICorDebugFunction> iCorFunction;
+            if (FAILED(pModule->GetFunctionFromToken(sp.methodToken, &iCorFunction)) ||
+                FAILED(iCorFunction->GetILCode(&iCorCode)))
+            {
+                iCorCode.Free();
+            }
+        }
+        if (iCorCode == nullptr)
+            continue;
+
+        auto findFile = m_files.find(sp.fullPathIndex);
+        if (findFile == m_files.end())
+        {
+            findFile = m_files.emplace(sp.fullPathIndex, FileData{}).first;
+            if (FAILED(m_sharedModules->GetSourceFullPathByIndex(sp.fullPathIndex, findFile->second.fullPath)))
+                LOGW("Can't get source full path for index %u", sp.fullPathIndex);
+        }
+
+        auto insertLine = findFile->second.lines.emplace(sp.startLine, LineData{});
+        LineData &line = insertLine.first->second;
+        if (insertLine.second)
+            m_linesCount++;
+        else if (line.covered) // same source compiled into few modules and line already covered
+            continue;
+
+        ToRelease<ICorDebugFunctionBreakpoint> iCorFuncBreakpoint;
+        if (FAILED(iCorCode->CreateBreakpoint(sp.ilOffset, &iCorFuncBreakpoint)))
+            continue;
+
+        m_breakpoints.emplace(iCorFuncBreakpoint.GetPtr(), &line);
+        line.breakpoints.emplace_back(iCorFuncBreakpoint.Detach());
+        armedCount++;
+    }
+
+    LOGI("Coverage: %u breakpoints armed for module, %u lines total", (unsigned)armedCount, (unsigned)m_linesCount);
+    return S_OK;
+}
+
+HRESULT CodeCoverage::ManagedCallbackBreakpoint(ICorDebugBreakpoint *pBreakpoint)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_breakpoints.empty())
+        return S_FALSE;
+
+    ToRelease<ICorDebugFunctionBreakpoint> iCorFuncBreakpoint;
+    if (FAILED(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID*) &iCorFuncBreakpoint)))
+        return S_FALSE;
+
+    auto find = m_breakpoints.find(iCorFuncBreakpoint.GetPtr());
+    if (find == m_breakpoints.end())
+        return S_FALSE;
+
+    LineData &line = *find->second;
+    line.covered = true;
+    m_coveredCount++;
+
+    // Note, callbacks for this line breakpoints, that already queued by runtime for other threads, will be ignored
+    // by Breakpoints class, since breakpoints don't belong to any user breakpoint.
+    for (auto &iCorBreakpoint : line.breakpoints)
+    {
+        iCorBreakpoint->Activate(FALSE);
+        m_breakpoints.erase(iCorBreakpoint.GetPtr());
+    }
+    line.breakpoints.clear();
+    line.breakpoints.shrink_to_fit();
+
+    return S_OK;
+}
+
+HRESULT CodeCoverage::WriteLcov(std::ostream &out, const std::vector<const FileData*> &files)
+{
+    out << "TN:\n";
+    for (const FileData *file : files)
+    {
+        size_t covered = 0;
+        out << "SF:" << file->fullPath << "\n";
+        for (const auto &line : file->lines)
+        {
+            out << "DA:" << line.first << "," << (line.second.covered ? 1 : 0) << "\n";
+            if (line.second.covered)
+                covered++;
+        }
+        out << "LF:" << file->lines.size() << "\n"
+            << "LH:" << covered << "\n"
+            << "end_of_record\n";
+    }
+    return out.good() ? S_OK : E_FAIL;
+}
+
+HRESULT CodeCoverage::WriteCobertura(std::ostream &out, const std::vector<const FileData*> &files)
+{
+    const double lineRate = Rate(m_coveredCount, m_linesCount);
+    out << std::fixed << std::setprecision(4);
+    out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        << "<coverage line-rate=\"" << lineRate << "\" branch-rate=\"0\" lines-covered=\"" << m_coveredCount
+        << "\" lines-valid=\"" << m_linesCount << "\" branches-covered=\"0\" branches-valid=\"0\" complexity=\"0\""
+        << " version=\"1.9\" timestamp=\"" << std::time(nullptr) << "\">\n"
+        << "  <sources/>\n"
+        << "  <packages>\n"
+        << "    <package name=\"netcoredbg\" line-rate=\"" << lineRate << "\" branch-rate=\"0\" complexity=\"0\">\n"
+        << "      <classes>\n";
+
+    for (const FileData *file : files)
+    {
+        size_t covered = std::count_if(file->lines.begin(), file->lines.end(), [](const std::pair<const int32_t, LineData> &line)
+        {
+            return line.second.covered;
+        });
+        const std::string fullPath = EscapeXml(file->fullPath);
+        out << "        <class name=\"" << EscapeXml(GetFileName(file->fullPath)) << "\" filename=\"" << fullPath
+            << "\" line-rate=\"" << Rate(covered, file->lines.size()) << "\" branch-rate=\"0\" complexity=\"0\">\n"
+            << "          <methods/>\n"
+            << "          <lines>\n";
+        for (const auto &line : file->lines)
+        {
+            out << "            <line number=\"" << line.first << "\" hits=\"" << (line.second.covered ? 1 : 0) << "\" branch=\"false\"/>\n";
+        }
+        out << "          </lines>\n"
+            << "        </class>\n";
+    }
+
+    out << "      </classes>\n"
+        << "    </package>\n"
+        << "  </packages>\n"
+        << "</coverage>\n";
+    return out.good() ? S_OK : E_FAIL;
+}
+
+HRESULT CodeCoverage::WriteReport(std::string &summary)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    summary.clear();
+    if (m_outputFile.empty() || m_files.empty())
+    {
+        Clear();
+        return S_FALSE;
+    }
+
+    std::vector<const FileData*> files;
+    files.reserve(m_files.size());
+    for (const auto &entry : m_files)
+    {
+        files.emplace_back(&entry.second);
+    }
+    std::sort(files.begin(), files.end(), [](const FileData *left, const FileData *right)
+    {
+        return left->fullPath < right->fullPath;
+    });
+
+    HRESULT Status = E_FAIL;
+    std::ofstream out(m_outputFile, std::ios::out | std::ios::trunc);
+    if (out.is_open())
+        Status = IsXmlFile(m_outputFile) ? WriteCobertura(out, files) : WriteLcov(out, files);
+
+    if (FAILED(Status))
+    {
+        LOGE("Can't write coverage report to '%s'", m_outputFile.c_str());
+        summary = "Can't write coverage report to '" + m_outputFile + "'\n";
+    }
+    else
+    {
+        std::ostringstream ss;
+        ss << "Coverage report written to '" << m_outputFile << "': " << m_coveredCount << " of " << m_linesCount
+           << " lines covered (" << std::fixed << std::setprecision(1) << Rate(m_coveredCount, m_linesCount) * 100 << "%)\n";
+        summary = ss.str();
+        LOGI("%s", summary.c_str());
+    }
+
+    Clear();
+    return Status;
+}
+
+// Caller must care about m_mutex.
+void CodeCoverage::Clear()
+{
+    m_breakpoints.clear();
+    m_files.clear(); // release all not hit breakpoints
+    m_linesCount = 0;
+    m_coveredCount = 0;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,76 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+class Modules;
+
+// Line coverage collected by internal one-shot breakpoints. At module load, breakpoint is created for each sequence point
+// of all methods with source data (modules with symbols). At first hit, all breakpoints of source line are removed and
+// process continued without stop event, so, code executed in cycle slow down only for first iteration.
+// Report (lcov or Cobertura XML, chosen by output file extension) is written at debug session end.
+class CodeCoverage
+{
+public:
+
+    CodeCoverage(std::shared_ptr<Modules> &sharedModules) :
+        m_sharedModules(sharedModules)
+    {}
+
+    // Empty outputFile disable coverage.
+    void SetOutputFile(const std::string &outputFile);
+    bool IsEnabled();
+
+    HRESULT ManagedCallbackLoadModule(ICorDebugModule *pModule);
+    // Return S_OK in case pBreakpoint is coverage breakpoint (process must be continued), S_FALSE otherwise.
+    HRESULT ManagedCallbackBreakpoint(ICorDebugBreakpoint *pBreakpoint);
+    // Write report (in case coverage was collected) and free all data.
+    // [out] summary - message for user, empty in case report was not written.
+    HRESULT WriteReport(std::string &summary);
+
+private:
+
+    struct LineData
+    {
+        bool covered = false;
+        std::vector<ToRelease<ICorDebugFunctionBreakpoint>> breakpoints;
+    };
+
+    struct FileData
+    {
+        std::string fullPath;
+        std::map<int32_t, LineData> lines; // ordered by line number for report
+    };
+
+    std::shared_ptr<Modules> m_sharedModules;
+
+    std::mutex m_mutex;
+    std::string m_outputFile;
+    // Note, std::map/std::unordered_map don't invalidate references to elements at insert, LineData pointers are stable.
+    std::unordered_map<unsigned, FileData> m_files; // source full path index -> lines
+    std::unordered_map<ICorDebugFunctionBreakpoint*, LineData*> m_breakpoints; // armed (not hit yet) breakpoints
+    size_t m_linesCount = 0;
+    size_t m_coveredCount = 0;
+
+    void Clear();
+    HRESULT WriteLcov(std::ostream &out, const std::vector<const FileData*> &files);
+    HRESULT WriteCobertura(std::ostream &out, const std::vector<const FileData*> &files);
+};
+
+} // namespace netcoredbg
@@ -3,7 +3,6 @@
 // See the LICENSE file in the project root for more information.
 
 #include <vector>
-#include <algorithm>
 #include "debugger/evalhelpers.h"
 #include "debugger/evalwaiter.h"
 #include "debugger/evalutils.h"
@@ -248,23 +247,24 @@ HRESULT EvalHelpers::TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebug
     COR_TYPEID typeID;
     IfFailRet(iCorType2->GetTypeID(&typeID));
 
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it == m_typeObjectCache.end())
+    auto find = m_typeObjectCache.find(std::make_pair(typeID.token1, typeID.token2));
+    if (find == m_typeObjectCache.end())
         return E_FAIL;
 
-    // Move data to begin, so, last used will be on front.
-    if (it != m_typeObjectCache.begin())
-        m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, it);
-
-    if (ppTypeObjectResult)
+    // We don't check handle's status here, since we store only strong handles.
+    // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/cordebughandletype-enumeration
+    // The handle is strong, which prevents an object from being reclaimed by garbage collection.
+    ToRelease<ICorDebugValue> iCorTypeObject;
+    IfFailRet(m_sharedHandlePool->Get(find->second, &iCorTypeObject));
+    if (Status == S_FALSE) // Handle was evicted from handle pool.
     {
-        // We don't check handle's status here, since we store only strong handles.
-        // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/cordebughandletype-enumeration
-        // The handle is strong, which prevents an object from being reclaimed by garbage collection.
-        return m_typeObjectCache.front().typeObject->QueryInterface(IID_ICorDebugValue, (LPVOID *)ppTypeObjectResult);
+        m_typeObjectCache.erase(find);
+        return E_FAIL;
     }
 
+    if (ppTypeObjectResult)
+        *ppTypeObjectResult = iCorTypeObject.Detach();
+
     return S_OK;
 }
 
@@ -279,9 +279,9 @@ HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *
     COR_TYPEID typeID;
     IfFailRet(iCorType2->GetTypeID(&typeID));
 
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it != m_typeObjectCache.end())
+    auto key = std::make_pair(typeID.token1, typeID.token2);
+    auto find = m_typeObjectCache.find(key);
+    if (find != m_typeObjectCache.end() && m_sharedHandlePool->IsAlive(find->second))
         return S_OK;
 
     ToRelease<ICorDebugHandleValue> iCorHandleValue;
@@ -292,17 +292,21 @@ HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *
         handleType != HANDLE_STRONG)
         return E_FAIL;
 
-    if (m_typeObjectCache.size() == m_typeObjectCacheSize)
+    HandlePool::HandleId handleId;
+    IfFailRet(m_sharedHandlePool->Add(pTypeObject, HandlePool::Lifetime::Session, handleId));
+    m_typeObjectCache[key] = handleId;
+
+    // Drop entries for handles, that was evicted from handle pool, so cache size is limited by handle pool budget.
+    if (m_typeObjectCache.size() > HandlePool::DefaultBudget)
     {
-        // Re-use last list entry.
-        m_typeObjectCache.back().id = typeID;
-        m_typeObjectCache.back().typeObject.Free();
-        m_typeObjectCache.back().typeObject = iCorHandleValue.Detach();
-        assert(m_typeObjectCacheSize >= 2);
-        m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, std::prev(m_typeObjectCache.end()));
+        for (auto it = m_typeObjectCache.begin(); it != m_typeObjectCache.end();)
+        {
+            if (m_sharedHandlePool->IsAlive(it->second))
+                ++it;
+            else
+                it = m_typeObjectCache.erase(it);
+        }
     }
-    else
-        m_typeObjectCache.emplace_front(type_object_t{typeID, iCorHandleValue.Detach()});
 
     return S_OK;
 }
@@ -8,9 +8,10 @@
 #include "cordebug.h"
 
 #include <string>
-#include <list>
+#include <map>
 #include <mutex>
 #include <memory>
+#include "debugger/handlepool.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -26,9 +27,11 @@ class EvalHelpers
 public:
 
     EvalHelpers(std::shared_ptr<Modules> &sharedModules,
-                std::shared_ptr<EvalWaiter> &sharedEvalWaiter) :
+                std::shared_ptr<EvalWaiter> &sharedEvalWaiter,
+                std::shared_ptr<HandlePool> &sharedHandlePool) :
         m_sharedModules(sharedModules),
-        m_sharedEvalWaiter(sharedEvalWaiter)
+        m_sharedEvalWaiter(sharedEvalWaiter),
+        m_sharedHandlePool(sharedHandlePool)
     {}
 
     HRESULT CreatTypeObjectStaticConstructor(
@@ -81,22 +84,13 @@ private:
     std::mutex m_pSuppressFinalizeMutex;
     ToRelease<ICorDebugFunction> m_pSuppressFinalize;
 
-    struct type_object_t
-    {
-        COR_TYPEID id;
-        ToRelease<ICorDebugHandleValue> typeObject;
-    };
+    std::shared_ptr<HandlePool> m_sharedHandlePool;
 
     std::mutex m_typeObjectCacheMutex;
-    // Because handles affect the performance of the garbage collector, the debugger should limit itself to a relatively
-    // small number of handles (about 256) that are active at a time.
-    // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/icordebugheapvalue2-createhandle-method
-    // Note, we also use handles (results of eval) in var refs during brake (cleared at 'Continue').
-    // Warning! Since we use `std::prev(m_typeObjectCache.end())` without any check in code, make sure cache size is `2` or bigger.
-    static const size_t m_typeObjectCacheSize = 100;
     // The idea of cache is not hold all type objects, but prevent numerous times same type objects creation during eval.
-    // At access, element moved to front of list, new element also add to front. In this way, not used elements displaced from cache.
-    std::list<type_object_t> m_typeObjectCache;
+    // Type objects handles are owned by handle pool, so, cache size is limited by handle pool budget and
+    // not used type objects handles are displaced by handle pool LRU.
+    std::map<std::pair<ULONG64, ULONG64>, HandlePool::HandleId> m_typeObjectCache;
 
     HRESULT TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebugValue **ppTypeObjectResult);
     HRESULT AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *pTypeObject);
@@ -4,6 +4,7 @@
 
 #include <sstream>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include "debugger/evalhelpers.h"
@@ -21,6 +22,47 @@
 namespace netcoredbg
 {
 
+namespace
+{
+    struct FrameScopeCache
+    {
+        bool userCode = false;
+        ULONG32 ilOffset = 0;
+        bool haveLocals = false;
+        std::vector<std::pair<ULONG, WSTRING>> locals; // local index -> name, visible at ilOffset only
+    };
+
+    struct MethodClassCache
+    {
+        std::string methodClass;
+        bool haveThis;
+    };
+
+    struct BatchCache
+    {
+        std::unordered_map<int, FrameScopeCache> scopes; // frame level -> scope data
+        std::unordered_map<int, MethodClassCache> methodClasses; // frame level -> method class
+    };
+
+    thread_local BatchCache *g_batchCache = nullptr;
+} // unnamed namespace
+
+Evaluator::BatchCacheScope::BatchCacheScope() :
+    m_owner(g_batchCache == nullptr)
+{
+    if (m_owner)
+        g_batchCache = new BatchCache;
+}
+
+Evaluator::BatchCacheScope::~BatchCacheScope()
+{
+    if (!m_owner)
+        return;
+
+    delete g_batchCache;
+    g_batchCache = nullptr;
+}
+
 bool Evaluator::ArgElementType::isAlias(const CorElementType type1, const CorElementType type2, const std::string& name2)
 {
     static const std::unordered_map<CorElementType, ArgElementType> aliases = {
@@ -1122,7 +1164,7 @@ static HRESULT FindThisProxyFieldValue(IMetaDataImport *pMD, ICorDebugClass *pCl
 }
 
 // Note, this method return Class name, not Type name (will not provide generic initialization types if any).
-static HRESULT InternalGetMethodClass(ICorDebugThread *pThread, FrameLevel frameLevel, std::string &methodClass, bool &haveThis)
+static HRESULT InternalGetMethodClassNoCache(ICorDebugThread *pThread, FrameLevel frameLevel, std::string &methodClass, bool &haveThis)
 {
     HRESULT Status;
     ToRelease<ICorDebugFrame> pFrame;
@@ -1196,6 +1238,25 @@ static HRESULT InternalGetMethodClass(ICorDebugThread *pThread, FrameLevel frame
     return TypePrinter::NameForTypeDef(typeDef, pMD, methodClass, nullptr);
 }
 
+static HRESULT InternalGetMethodClass(ICorDebugThread *pThread, FrameLevel frameLevel, std::string &methodClass, bool &haveThis)
+{
+    if (g_batchCache == nullptr)
+        return InternalGetMethodClassNoCache(pThread, frameLevel, methodClass, haveThis);
+
+    auto find = g_batchCache->methodClasses.find(int(frameLevel));
+    if (find == g_batchCache->methodClasses.end())
+    {
+        HRESULT Status;
+        MethodClassCache data;
+        IfFailRet(InternalGetMethodClassNoCache(pThread, frameLevel, data.methodClass, data.haveThis));
+        find = g_batchCache->methodClasses.emplace(int(frameLevel), std::move(data)).first;
+    }
+
+    methodClass = find->second.methodClass;
+    haveThis = find->second.haveThis;
+    return S_OK;
+}
+
 HRESULT Evaluator::GetMethodClass(ICorDebugThread *pThread, FrameLevel frameLevel, std::string &methodClass, bool &haveThis)
 {
     return InternalGetMethodClass(pThread, frameLevel, methodClass, haveThis);
@@ -1359,13 +1420,34 @@ static HRESULT InternalWalkStackVars(Modules *pModules, ICorDebugThread *pThread
     if (pFrame == nullptr)
         return E_FAIL;
 
+    FrameScopeCache *scopeCache = nullptr;
+    if (g_batchCache != nullptr)
+    {
+        auto insert = g_batchCache->scopes.emplace(int(frameLevel), FrameScopeCache());
+        scopeCache = &insert.first->second;
+        if (insert.second)
+        {
+            Modules::SequencePoint sp;
+            scopeCache->userCode = SUCCEEDED(pModules->GetFrameILAndSequencePoint(pFrame, scopeCache->ilOffset, sp));
+        }
+    }
+
     ULONG32 currentIlOffset;
-    Modules::SequencePoint sp;
-    // GetFrameILAndSequencePoint() return "success" code only in case it found sequence point
-    // for current IP, that mean we stop inside user code.
-    // Note, we could have request for not user code, we ignore it and this is OK.
-    if (FAILED(pModules->GetFrameILAndSequencePoint(pFrame, currentIlOffset, sp)))
-        return S_OK;
+    if (scopeCache != nullptr)
+    {
+        if (!scopeCache->userCode)
+            return S_OK;
+        currentIlOffset = scopeCache->ilOffset;
+    }
+    else
+    {
+        Modules::SequencePoint sp;
+        // GetFrameILAndSequencePoint() return "success" code only in case it found sequence point
+        // for current IP, that mean we stop inside user code.
+        // Note, we could have request for not user code, we ignore it and this is OK.
+        if (FAILED(pModules->GetFrameILAndSequencePoint(pFrame, currentIlOffset, sp)))
+            return S_OK;
+    }
 
     ToRelease<ICorDebugFunction> pFunction;
     IfFailRet(pFrame->GetFunction(&pFunction));
@@ -1487,16 +1569,39 @@ static HRESULT InternalWalkStackVars(Modules *pModules, ICorDebugThread *pThread
         pILFrame.Free();
     }
 
-    for (ULONG i = 0; i < cLocals; i++)
+    // Local names are read from symbols, this is expensive, so, visible locals could be cached for batch.
+    std::vector<std::pair<ULONG, WSTRING>> localsStorage;
+    const std::vector<std::pair<ULONG, WSTRING>> *visibleLocals = &localsStorage;
+    if (scopeCache == nullptr || !scopeCache->haveLocals)
     {
-        WSTRING wLocalName;
-        ULONG32 ilStart;
-        ULONG32 ilEnd;
-        if (FAILED(pModules->GetFrameNamedLocalVariable(pModule, methodDef, methodVersion, i, wLocalName, &ilStart, &ilEnd)))
-            continue;
+        for (ULONG i = 0; i < cLocals; i++)
+        {
+            WSTRING wLocalName;
+            ULONG32 ilStart;
+            ULONG32 ilEnd;
+            if (FAILED(pModules->GetFrameNamedLocalVariable(pModule, methodDef, methodVersion, i, wLocalName, &ilStart, &ilEnd)))
+                continue;
 
-        if (currentIlOffset < ilStart || currentIlOffset >= ilEnd)
-            continue;
+            if (currentIlOffset < ilStart || currentIlOffset >= ilEnd)
+                continue;
+
+            localsStorage.emplace_back(i, std::move(wLocalName));
+        }
+
+        if (scopeCache != nullptr)
+        {
+            scopeCache->locals = std::move(localsStorage);
+            scopeCache->haveLocals = true;
+            visibleLocals = &scopeCache->locals;
+        }
+    }
+    else
+        visibleLocals = &scopeCache->locals;
+
+    for (const auto &local : *visibleLocals)
+    {
+        const ULONG i = local.first;
+        const WSTRING &wLocalName = local.second;
 
         auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
         {
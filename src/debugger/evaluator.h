@@ -125,6 +125,22 @@ public:
         FrameLevel frameLevel,
         WalkStackVarsCallback cb);
 
+    // Share scope (visible locals) and method class data of frames between evaluations on current thread while object
+    // exist, for batch of evaluations in same stopped state (see Variables::EvaluateBatch()). Nested objects share outer cache.
+    // Note, cached data don't include any debuggee values, so, cache is not affected by func-eval.
+    class BatchCacheScope
+    {
+    public:
+        BatchCacheScope();
+        ~BatchCacheScope();
+
+    private:
+        BatchCacheScope(const BatchCacheScope&) = delete;
+        BatchCacheScope& operator=(const BatchCacheScope&) = delete;
+
+        bool m_owner;
+    };
+
     HRESULT Evaluator::GetMethodClass(
         ICorDebugThread *pThread,
         FrameLevel frameLevel,
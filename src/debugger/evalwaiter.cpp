@@ -5,6 +5,7 @@
 #include "debugger/evalwaiter.h"
 #include "utils/platform.h"
 #include "debugger/threads.h"
+#include "debugger/frames.h"
 #ifdef INTEROP_DEBUGGING
 #include "debugger/interop_debugging.h"
 #endif // INTEROP_DEBUGGING
@@ -112,6 +113,10 @@ std::future<std::unique_ptr<EvalWaiter::evalResultData_t> > EvalWaiter::RunEval(
         LOGE("Continue() failed, %0x", Status);
         m_evalResult.reset(nullptr);
     }
+    else
+    {
+        m_evalsCount++;
+    }
 
     return f;
 }
@@ -133,6 +138,7 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread,
 {
     // Important! Evaluation should be proceed only for 1 thread.
     std::lock_guard<std::mutex> lock(m_waitEvalResultMutex);
+    std::lock_guard<Utility::RWLock::Writer> guardInspectionRWLock(m_inspectionRWLock.writer);
 
     // During evaluation could be implicitly executing user code, that could provoke callback calls like - breakpoints, exceptions, etc.
     // Make sure, that all managed callbacks ignore standard logic during evaluation and don't pause/interrupt managed code execution.
@@ -145,6 +151,9 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread,
     DWORD evalThreadId = 0;
     IfFailRet(pThread->GetID(&evalThreadId));
 
+    // Process will be continued for evaluation, all frames will be neutered.
+    FramesCacheScope::Invalidate();
+
 #ifdef INTEROP_DEBUGGING
     assert(!!m_sharedInteropDebugger);
     if (m_sharedInteropDebugger->IsManagedThreadWasStoppedInNativeCode((pid_t)evalThreadId))
@@ -7,8 +7,10 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <atomic>
 #include <functional>
 #include <future>
+#include "utils/rwlock.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -29,9 +31,15 @@ public:
 
     typedef std::function<HRESULT(ICorDebugEval*)> WaitEvalResultCallback;
 
-    EvalWaiter() : m_evalCanceled(false), m_evalCrossThreadDependency(false) {}
+    EvalWaiter() : m_evalCanceled(false), m_evalCrossThreadDependency(false), m_evalsCount(0) {}
 
     bool IsEvalRunning();
+    // Reader lock for process state inspection from threads, that run in parallel with commands queue (stack trace,
+    // heap walk). Evaluation don't start during inspection and inspection wait for running evaluation end.
+    // Note, must be acquired after m_debugProcessRWLock reader lock (same order as evaluation do).
+    Utility::RWLock::Reader &GetInspectionLock() { return m_inspectionRWLock.reader; }
+    // Count of evals run during session, debuggee could change managed heap at each eval.
+    uint64_t GetEvalsCount() { return m_evalsCount; }
 #ifdef INTEROP_DEBUGGING
     DWORD GetEvalRunningThreadID();
     void SetInteropDebugger(std::shared_ptr<InteropDebugging::InteropDebugger> &sharedInteropDebugger);
@@ -53,6 +61,7 @@ private:
 
     bool m_evalCanceled;
     bool m_evalCrossThreadDependency;
+    std::atomic<uint64_t> m_evalsCount;
 
     ToRelease<ICorDebugClass> m_iCorCrossThreadDependencyNotification;
     HRESULT SetEnableCustomNotification(ICorDebugProcess *pProcess, BOOL fEnable);
@@ -93,6 +102,7 @@ private:
     };
 
     std::mutex m_waitEvalResultMutex;
+    Utility::RWLock m_inspectionRWLock;
     std::mutex m_evalResultMutex;
     std::unique_ptr<evalResult_t> m_evalResult;
 
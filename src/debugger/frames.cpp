@@ -2,6 +2,7 @@
 // Distributed under the MIT License.
 // See the LICENSE file in the project root for more information.
 
+#include <map>
 #include <sstream>
 #include "debugger/frames.h"
 #include "metadata/typeprinter.h"
@@ -21,6 +22,13 @@
 namespace netcoredbg
 {
 
+namespace
+{
+    // thread id + frame level -> frame
+    typedef std::map<std::pair<DWORD, int>, ToRelease<ICorDebugFrame>> FramesCache;
+    thread_local FramesCache *g_framesCache = nullptr;
+} // unnamed namespace
+
 #ifdef INTEROP_DEBUGGING
 namespace
 {
@@ -395,7 +403,7 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
     return S_OK;
 }
 
-HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame)
+static HRESULT GetFrameAtNoCache(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame)
 {
     // Try get 0 (current active) frame in fast way, if possible.
     if (int(level) == 0 &&
@@ -429,6 +437,49 @@ HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **
     return *ppFrame != nullptr ? S_OK : E_FAIL;
 }
 
+HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame)
+{
+    DWORD threadId = 0;
+    if (g_framesCache == nullptr || FAILED(pThread->GetID(&threadId)))
+        return GetFrameAtNoCache(pThread, level, ppFrame);
+
+    const auto key = std::make_pair(threadId, int(level));
+    auto find = g_framesCache->find(key);
+    if (find == g_framesCache->end())
+    {
+        HRESULT Status;
+        ToRelease<ICorDebugFrame> iCorFrame;
+        IfFailRet(GetFrameAtNoCache(pThread, level, &iCorFrame));
+        find = g_framesCache->emplace(key, std::move(iCorFrame)).first;
+    }
+
+    find->second->AddRef();
+    *ppFrame = find->second.GetPtr();
+    return S_OK;
+}
+
+FramesCacheScope::FramesCacheScope() :
+    m_owner(g_framesCache == nullptr)
+{
+    if (m_owner)
+        g_framesCache = new FramesCache;
+}
+
+FramesCacheScope::~FramesCacheScope()
+{
+    if (!m_owner)
+        return;
+
+    delete g_framesCache;
+    g_framesCache = nullptr;
+}
+
+void FramesCacheScope::Invalidate()
+{
+    if (g_framesCache != nullptr)
+        g_framesCache->clear();
+}
+
 const char *GetInternalTypeName(CorDebugInternalFrameType frameType)
 {
     switch(frameType)
@@ -36,6 +36,23 @@ typedef std::function<HRESULT(FrameType,std::uintptr_t,ICorDebugFrame*,NativeFra
 struct Thread;
 
 HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame);
+
+// Cache GetFrameAt() results on current thread while object exist, for batch of requests to same stopped state
+// (see Variables::EvaluateBatch()). Nested objects share outer cache. Note, frames are neutered by process continue,
+// so, cache must be dropped by Invalidate() call at func-eval.
+class FramesCacheScope
+{
+public:
+    FramesCacheScope();
+    ~FramesCacheScope();
+    static void Invalidate();
+
+private:
+    FramesCacheScope(const FramesCacheScope&) = delete;
+    FramesCacheScope& operator=(const FramesCacheScope&) = delete;
+
+    bool m_owner;
+};
 const char *GetInternalTypeName(CorDebugInternalFrameType frameType);
 HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb);
 
@@ -0,0 +1,532 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "debugger/gcrootpaths.h"
+#include "metadata/typeprinter.h"
+#include "utils/logger.h"
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Struct could contain struct fields, limit recursion for broken metadata.
+static const int MaxValueTypeDepth = 16;
+// Objects (with references) located close to each other are read from debuggee by one ReadMemory() call.
+static const size_t ReadBatchSize = 64 * 1024;
+// Memory for each heap object: address in m_objects, m_parentsStart element, next object and queue element for search.
+static const size_t ObjectMemory = sizeof(CORDB_ADDRESS) + 3 * sizeof(uint32_t);
+// Each edge is stored as (child, parent) pair during build and packed into m_parents after walk.
+static const size_t EdgeMemory = sizeof(std::pair<uint32_t, uint32_t>) + sizeof(uint32_t);
+// Object index value for not visited object during search.
+static const uint32_t NoObject = std::numeric_limits<uint32_t>::max();
+
+static bool IsReferenceElementType(CorElementType elementType)
+{
+    return elementType == ELEMENT_TYPE_CLASS ||
+           elementType == ELEMENT_TYPE_OBJECT ||
+           elementType == ELEMENT_TYPE_STRING ||
+           elementType == ELEMENT_TYPE_SZARRAY ||
+           elementType == ELEMENT_TYPE_ARRAY;
+}
+
+static bool IsEmptyTypeId(const COR_TYPEID &typeId)
+{
+    return typeId.token1 == 0 && typeId.token2 == 0;
+}
+
+enum RootKind
+{
+    RootStack            = 1 << 0,
+    RootFinalizer        = 1 << 1,
+    RootStrongHandle     = 1 << 2,
+    RootPinnedHandle     = 1 << 3,
+    RootAsyncPinned      = 1 << 4,
+    RootRefCountHandle   = 1 << 5,
+    RootDependentHandle  = 1 << 6,
+    RootSizedRefHandle   = 1 << 7
+};
+
+static uint32_t GetRootKind(CorGCReferenceType type)
+{
+    switch (type)
+    {
+        case CorReferenceStack:          return RootStack;
+        case CorReferenceFinalizer:      return RootFinalizer;
+        case CorHandleStrong:            return RootStrongHandle;
+        case CorHandleStrongPinning:     return RootPinnedHandle;
+        case CorHandleStrongAsyncPinned: return RootAsyncPinned;
+        case CorHandleStrongRefCount:    return RootRefCountHandle;
+        case CorHandleStrongDependent:   return RootDependentHandle;
+        case CorHandleStrongSizedByref:  return RootSizedRefHandle;
+        default:                         return 0; // weak handles don't keep object alive
+    }
+}
+
+static std::string GetRootKindName(uint32_t rootKinds)
+{
+    static const std::pair<uint32_t, const char*> rootKindNames[] = {
+        {RootStack, "stack"},
+        {RootFinalizer, "finalizer queue"},
+        {RootStrongHandle, "strong handle"},
+        {RootPinnedHandle, "pinned handle"},
+        {RootAsyncPinned, "async pinned handle"},
+        {RootRefCountHandle, "ref count handle"},
+        {RootDependentHandle, "dependent handle"},
+        {RootSizedRefHandle, "sized ref handle"}
+    };
+
+    std::string result;
+    for (const auto &entry : rootKindNames)
+    {
+        if ((rootKinds & entry.first) == 0)
+            continue;
+
+        if (!result.empty())
+            result += ", ";
+        result += entry.second;
+    }
+    return result;
+}
+
+CORDB_ADDRESS GCRootPaths::ReadPointer(const BYTE *pData)
+{
+    if (m_pointerSize == sizeof(uint32_t))
+    {
+        uint32_t pointer;
+        memcpy(&pointer, pData, sizeof(pointer));
+        return pointer;
+    }
+
+    uint64_t pointer;
+    memcpy(&pointer, pData, sizeof(pointer));
+    return pointer;
+}
+
+bool GCRootPaths::FindObject(CORDB_ADDRESS address, uint32_t &index)
+{
+    // Note, interior pointers (stack roots only) are not resolved, since index don't store objects size.
+    auto find = std::lower_bound(m_objects.begin(), m_objects.end(), address);
+    if (find == m_objects.end() || *find != address)
+        return false;
+
+    index = uint32_t(find - m_objects.begin());
+    return true;
+}
+
+// Add offsets of reference fields for type and all its base types (in case of class).
+// Runtime provide class fields offsets from object start and struct fields offsets from struct data start.
+HRESULT GCRootPaths::AddFieldsRefOffsets(ICorDebugProcess5 *pProcess5, const COR_TYPEID &typeId, ULONG32 baseOffset, int depth,
+                                         std::vector<ULONG32> &refOffsets)
+{
+    if (depth > MaxValueTypeDepth)
+        return E_FAIL;
+
+    HRESULT Status;
+    COR_TYPEID currentId = typeId;
+    std::vector<COR_FIELD> fields;
+    while (!IsEmptyTypeId(currentId))
+    {
+        COR_TYPE_LAYOUT layout;
+        IfFailRet(pProcess5->GetTypeLayout(currentId, &layout));
+
+        if (layout.numFields > 0)
+        {
+            fields.resize(layout.numFields);
+            ULONG32 fetched = 0;
+            IfFailRet(pProcess5->GetTypeFields(currentId, layout.numFields, fields.data(), &fetched));
+
+            for (ULONG32 i = 0; i < fetched; i++)
+            {
+                if (IsReferenceElementType(fields[i].fieldType))
+                    refOffsets.push_back(baseOffset + fields[i].offset);
+                else if (fields[i].fieldType == ELEMENT_TYPE_VALUETYPE)
+                    IfFailRet(AddFieldsRefOffsets(pProcess5, fields[i].id, baseOffset + fields[i].offset, depth + 1, refOffsets));
+            }
+        }
+
+        currentId = layout.parentID;
+    }
+
+    return S_OK;
+}
+
+HRESULT GCRootPaths::GetTypeLayout(ICorDebugProcess5 *pProcess5, const COR_TYPEID &typeId, TypeLayouts &typeLayouts,
+                                   const TypeLayout *&pTypeLayout)
+{
+    auto find = typeLayouts.find(typeId);
+    if (find != typeLayouts.end())
+    {
+        pTypeLayout = &find->second;
+        return S_OK;
+    }
+
+    // Note, type without layout is stored as type without references, so, we don't request runtime for it again.
+    TypeLayout &typeLayout = typeLayouts[typeId];
+    pTypeLayout = &typeLayout;
+
+    HRESULT Status;
+    COR_TYPE_LAYOUT layout;
+    IfFailRet(pProcess5->GetTypeLayout(typeId, &layout));
+
+    if (layout.type == ELEMENT_TYPE_STRING)
+        return S_OK;
+
+    if (layout.type != ELEMENT_TYPE_SZARRAY && layout.type != ELEMENT_TYPE_ARRAY)
+        return AddFieldsRefOffsets(pProcess5, typeId, 0, 0, typeLayout.refOffsets);
+
+    COR_ARRAY_LAYOUT arrayLayout;
+    IfFailRet(pProcess5->GetArrayLayout(typeId, &arrayLayout));
+
+    typeLayout.isArray = true;
+    typeLayout.countOffset = arrayLayout.countOffset;
+    typeLayout.firstElementOffset = arrayLayout.firstElementOffset;
+    typeLayout.elementSize = arrayLayout.elementSize;
+    if (IsReferenceElementType(arrayLayout.componentType))
+        typeLayout.elementRefOffsets.push_back(0);
+    else if (arrayLayout.componentType == ELEMENT_TYPE_VALUETYPE)
+        IfFailRet(AddFieldsRefOffsets(pProcess5, arrayLayout.componentID, 0, 0, typeLayout.elementRefOffsets));
+
+    return S_OK;
+}
+
+HRESULT GCRootPaths::AddRoots(ICorDebugProcess5 *pProcess5)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugGCReferenceEnum> iCorRefEnum;
+    IfFailRet(pProcess5->EnumerateGCReferences(FALSE, &iCorRefEnum));
+
+    static const ULONG RefsBatch = 256;
+    COR_GC_REFERENCE refs[RefsBatch];
+    ULONG fetched = 0;
+    do
+    {
+        IfFailRet(iCorRefEnum->Next(RefsBatch, refs, &fetched));
+
+        for (ULONG i = 0; i < fetched; i++)
+        {
+            ToRelease<ICorDebugAppDomain> iCorDomain(refs[i].Domain);
+            ToRelease<ICorDebugValue> iCorValue(refs[i].Location);
+
+            const uint32_t rootKind = GetRootKind(refs[i].Type);
+            ToRelease<ICorDebugReferenceValue> iCorRefValue;
+            if (rootKind == 0 || iCorValue == nullptr ||
+                FAILED(iCorValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorRefValue)))
+                continue;
+
+            BOOL isNull = TRUE;
+            CORDB_ADDRESS address = 0;
+            uint32_t index;
+            if (FAILED(iCorRefValue->IsNull(&isNull)) || isNull ||
+                FAILED(iCorRefValue->GetValue(&address)) ||
+                !FindObject(address, index))
+                continue;
+
+            m_roots[index] |= rootKind;
+        }
+    }
+    while (fetched == RefsBatch);
+
+    return S_OK;
+}
+
+void GCRootPaths::FreeIndex()
+{
+    m_indexValid = false;
+    // Note, clear() don't free vector's memory.
+    std::vector<CORDB_ADDRESS>().swap(m_objects);
+    std::vector<uint32_t>().swap(m_parentsStart);
+    std::vector<uint32_t>().swap(m_parents);
+    std::unordered_map<uint32_t, uint32_t>().swap(m_roots);
+}
+
+// Caller must care about m_mutex.
+HRESULT GCRootPaths::BuildIndex(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+
+    COR_HEAPINFO heapInfo;
+    IfFailRet(iCorProcess5->GetGCHeapInformation(&heapInfo));
+    m_pointerSize = heapInfo.pointerSize;
+
+    // First walk, object addresses. Object index is 32-bit (NoObject value is reserved), memory for edges will be
+    // checked at second walk. Note, memory for search (next object and queue) is also reserved here.
+    const size_t maxObjects = std::min<size_t>(m_memoryLimit / ObjectMemory, NoObject);
+    IfFailRet(pHeapWalker->Walk(pProcess, [&](const COR_HEAPOBJECT &heapObject) -> HRESULT
+    {
+        if (m_objects.size() == maxObjects)
+        {
+            LOGW("Heap objects count exceed GC root paths index memory limit.");
+            return E_OUTOFMEMORY;
+        }
+
+        m_objects.push_back(heapObject.address);
+        return S_OK;
+    }));
+    m_objects.shrink_to_fit();
+    // Objects are walked in address order inside each segment, but segments order is not guaranteed.
+    if (!std::is_sorted(m_objects.begin(), m_objects.end()))
+        std::sort(m_objects.begin(), m_objects.end());
+
+    // Second walk, references. Memory for objects, edges, type layouts and read buffers is checked against limit.
+    const size_t objectsMemory = m_objects.size() * ObjectMemory;
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    TypeLayouts typeLayouts;
+    size_t typeLayoutsMemory = 0;
+    std::vector<BYTE> data;
+    std::vector<BYTE> objectData;
+    auto IsMemoryLimitReached = [&](size_t additionalMemory) -> bool
+    {
+        return objectsMemory + typeLayoutsMemory + edges.size() * EdgeMemory + data.capacity() + objectData.capacity() +
+               additionalMemory > m_memoryLimit;
+    };
+
+    // Objects with references, that wait for batched read.
+    struct PendingObject
+    {
+        CORDB_ADDRESS address;
+        size_t size;
+        uint32_t index;
+        const TypeLayout *pTypeLayout; // Note, unordered_map don't invalidate pointers to elements on insert.
+    };
+    std::vector<PendingObject> pending;
+    CORDB_ADDRESS batchStart = 0;
+    CORDB_ADDRESS batchEnd = 0;
+
+    auto AddObjectEdges = [&](const PendingObject &object, const BYTE *pData) -> HRESULT
+    {
+        auto addEdge = [&](size_t offset) -> HRESULT
+        {
+            uint32_t child;
+            if (offset + m_pointerSize > object.size ||
+                !FindObject(ReadPointer(&pData[offset]), child) ||
+                child == object.index)
+                return S_OK;
+
+            if (edges.size() == NoObject || IsMemoryLimitReached(EdgeMemory))
+            {
+                LOGW("Heap references count exceed GC root paths index memory limit.");
+                return E_OUTOFMEMORY;
+            }
+
+            edges.emplace_back(child, object.index);
+            return S_OK;
+        };
+
+        HRESULT Status;
+        const TypeLayout *pTypeLayout = object.pTypeLayout;
+        for (ULONG32 offset : pTypeLayout->refOffsets)
+        {
+            IfFailRet(addEdge(offset));
+        }
+
+        if (pTypeLayout->elementRefOffsets.empty() || size_t(pTypeLayout->countOffset) + sizeof(ULONG32) > object.size)
+            return S_OK;
+
+        ULONG32 count;
+        memcpy(&count, &pData[pTypeLayout->countOffset], sizeof(count));
+        for (size_t i = 0; i < count; i++)
+        {
+            const size_t elementOffset = size_t(pTypeLayout->firstElementOffset) + i * pTypeLayout->elementSize;
+            for (ULONG32 offset : pTypeLayout->elementRefOffsets)
+            {
+                IfFailRet(addEdge(elementOffset + offset));
+            }
+        }
+        return S_OK;
+    };
+
+    auto FlushPending = [&]() -> HRESULT
+    {
+        if (pending.empty())
+            return S_OK;
+
+        HRESULT Status;
+        const size_t batchSize = size_t(batchEnd - batchStart);
+        if (batchSize > data.capacity() && IsMemoryLimitReached(batchSize - data.capacity()))
+        {
+            LOGW("Heap object size exceed GC root paths index memory limit.");
+            return E_OUTOFMEMORY;
+        }
+        data.resize(batchSize);
+        SIZE_T read = 0;
+        const bool batchRead = SUCCEEDED(pProcess->ReadMemory(batchStart, DWORD(batchSize), data.data(), &read)) && read == batchSize;
+
+        for (const auto &object : pending)
+        {
+            if (batchRead)
+            {
+                IfFailRet(AddObjectEdges(object, &data[size_t(object.address - batchStart)]));
+                continue;
+            }
+
+            // Batch could include unreadable memory between objects, read objects one by one.
+            if (pending.size() == 1)
+                break;
+            objectData.resize(object.size);
+            if (SUCCEEDED(pProcess->ReadMemory(object.address, DWORD(object.size), objectData.data(), &read)) && read == object.size)
+                IfFailRet(AddObjectEdges(object, objectData.data()));
+        }
+
+        pending.clear();
+        return S_OK;
+    };
+
+    IfFailRet(pHeapWalker->Walk(pProcess, [&](const COR_HEAPOBJECT &heapObject) -> HRESULT
+    {
+        const TypeLayout *pTypeLayout = nullptr;
+        uint32_t parent;
+        const size_t typeLayoutsCount = typeLayouts.size();
+        const HRESULT layoutStatus = GetTypeLayout(iCorProcess5, heapObject.type, typeLayouts, pTypeLayout);
+        if (typeLayouts.size() != typeLayoutsCount)
+        {
+            // Approximate memory for hash map node (with next pointer and hash) and offsets vectors data.
+            typeLayoutsMemory += sizeof(TypeLayouts::value_type) + 2 * sizeof(void*) +
+                (pTypeLayout->refOffsets.size() + pTypeLayout->elementRefOffsets.size()) * sizeof(ULONG32);
+        }
+
+        if (FAILED(layoutStatus) ||
+            !pTypeLayout->HasReferences() ||
+            heapObject.size > std::numeric_limits<DWORD>::max() ||
+            !FindObject(heapObject.address, parent))
+            return S_OK;
+
+        HRESULT Status;
+        // Heap objects are walked in address order inside segment, batch contain objects from one memory range.
+        if (!pending.empty() &&
+            (heapObject.address < batchEnd || heapObject.address + heapObject.size - batchStart > ReadBatchSize))
+            IfFailRet(FlushPending());
+
+        if (pending.empty())
+            batchStart = heapObject.address;
+        batchEnd = heapObject.address + heapObject.size;
+        pending.push_back(PendingObject{heapObject.address, size_t(heapObject.size), parent, pTypeLayout});
+        return S_OK;
+    }));
+    IfFailRet(FlushPending());
+
+    // Pack edges, object's parents are stored in m_parents from m_parentsStart[index] to m_parentsStart[index + 1].
+    m_parentsStart.assign(m_objects.size() + 1, 0);
+    for (const auto &edge : edges)
+    {
+        m_parentsStart[edge.first]++;
+    }
+    for (size_t i = 1; i < m_objects.size(); i++)
+    {
+        m_parentsStart[i] += m_parentsStart[i - 1];
+    }
+    m_parentsStart[m_objects.size()] = uint32_t(edges.size());
+    m_parents.resize(edges.size());
+    for (const auto &edge : edges)
+    {
+        m_parents[--m_parentsStart[edge.first]] = edge.second;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>>().swap(edges);
+
+    IfFailRet(AddRoots(iCorProcess5));
+
+    LOGI("GC root paths index: %u objects, %u references, %u roots",
+         (unsigned)m_objects.size(), (unsigned)m_parents.size(), (unsigned)m_roots.size());
+
+    m_indexValid = true;
+    return S_OK;
+}
+
+static std::string GetObjectTypeName(ICorDebugProcess5 *pProcess5, CORDB_ADDRESS address)
+{
+    std::string typeName;
+    ToRelease<ICorDebugObjectValue> iCorObjectValue;
+    ToRelease<ICorDebugValue2> iCorValue2;
+    ToRelease<ICorDebugType> iCorType;
+    if (FAILED(pProcess5->GetObject(address, &iCorObjectValue)) ||
+        FAILED(iCorObjectValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2)) ||
+        FAILED(iCorValue2->GetExactType(&iCorType)) ||
+        FAILED(TypePrinter::NameForTypeByType(iCorType, typeName)))
+    {
+        typeName = "<unknown type>";
+    }
+
+    return typeName;
+}
+
+HRESULT GCRootPaths::FindRootPaths(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker, uint64_t stateId,
+                                   CORDB_ADDRESS objectAddress, unsigned maxPaths, std::vector<GCRootPath> &paths)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_indexValid || m_indexStateId != stateId)
+    {
+        FreeIndex();
+        if (FAILED(Status = BuildIndex(pProcess, pHeapWalker)))
+        {
+            FreeIndex();
+            return Status;
+        }
+        m_indexStateId = stateId;
+    }
+
+    uint32_t target;
+    if (!FindObject(objectAddress, target))
+        return E_INVALIDARG;
+
+    // Backward breadth-first search from target object, so, first found roots have shortest paths.
+    // Visited object is mapped to next object on path to target. Note, memory for search is counted in index build,
+    // each object could be added into queue only once.
+    std::vector<uint32_t> nextObject(m_objects.size(), NoObject);
+    std::vector<uint32_t> queue;
+    queue.reserve(m_objects.size());
+    size_t queueHead = 0;
+    nextObject[target] = target;
+    queue.push_back(target);
+    paths.clear();
+    while (queueHead < queue.size() && paths.size() < maxPaths)
+    {
+        const uint32_t current = queue[queueHead++];
+
+        auto findRoot = m_roots.find(current);
+        if (findRoot != m_roots.end())
+        {
+            paths.emplace_back();
+            GCRootPath &path = paths.back();
+            path.rootKind = GetRootKindName(findRoot->second);
+            uint32_t index = current;
+            while (true)
+            {
+                path.objects.emplace_back();
+                path.objects.back().address = m_objects[index];
+                path.objects.back().typeName = GetObjectTypeName(iCorProcess5, m_objects[index]);
+                if (index == target)
+                    break;
+                index = nextObject[index];
+            }
+        }
+
+        for (uint32_t i = m_parentsStart[current]; i < m_parentsStart[current + 1]; i++)
+        {
+            if (nextObject[m_parents[i]] != NoObject)
+                continue;
+
+            nextObject[m_parents[i]] = current;
+            queue.push_back(m_parents[i]);
+        }
+    }
+
+    return S_OK;
+}
+
+void GCRootPaths::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FreeIndex();
+}
+
+} // namespace netcoredbg
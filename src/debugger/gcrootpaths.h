@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/types.h"
+#include "debugger/heapwalker.h"
+
+namespace netcoredbg
+{
+
+// Find shortest chains of references from GC roots to object (what keep object alive).
+// Reverse references graph (object -> objects that reference it) is built from managed heap at first request after stop
+// and reused by next requests until process continue (or eval, since eval could change heap). Graph is stored as compact
+// index (sorted object addresses and 32-bit object indexes for edges), build fails in case index don't fit into memory limit.
+class GCRootPaths
+{
+public:
+
+    static const size_t DefaultMemoryLimit = size_t(1024) * 1024 * 1024;
+
+    GCRootPaths(size_t memoryLimit = DefaultMemoryLimit) :
+        m_memoryLimit(memoryLimit),
+        m_indexValid(false),
+        m_indexStateId(0),
+        m_pointerSize(0)
+    {}
+
+    // [in] stateId - process state, index built for another state is rebuilt;
+    // [in] objectAddress - object to find root paths for;
+    // [in] maxPaths - max paths count, each path start from different root object;
+    // [out] paths - shortest paths first.
+    HRESULT FindRootPaths(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker, uint64_t stateId,
+                          CORDB_ADDRESS objectAddress, unsigned maxPaths, std::vector<GCRootPath> &paths);
+    // Free index memory, called at process continue.
+    void Invalidate();
+
+private:
+
+    // Offsets of fields with references for object's type.
+    struct TypeLayout
+    {
+        std::vector<ULONG32> refOffsets;        // from object start
+        bool isArray;
+        ULONG32 countOffset;
+        ULONG32 firstElementOffset;
+        ULONG32 elementSize;
+        std::vector<ULONG32> elementRefOffsets; // from element start
+
+        TypeLayout() : isArray(false), countOffset(0), firstElementOffset(0), elementSize(0) {}
+        bool HasReferences() const { return !refOffsets.empty() || !elementRefOffsets.empty(); }
+    };
+
+    typedef std::unordered_map<COR_TYPEID, TypeLayout, TypeIdHash, TypeIdEqual> TypeLayouts;
+
+    const size_t m_memoryLimit;
+
+    std::mutex m_mutex;
+    bool m_indexValid;
+    uint64_t m_indexStateId;
+    ULONG32 m_pointerSize;
+    std::vector<CORDB_ADDRESS> m_objects;           // sorted, object index is position in this vector
+    std::vector<uint32_t> m_parentsStart;           // m_objects.size() + 1 elements, start of object's parents in m_parents
+    std::vector<uint32_t> m_parents;                // indexes of objects, that reference object
+    std::unordered_map<uint32_t, uint32_t> m_roots; // object index -> RootKind flags
+
+    void FreeIndex();
+    HRESULT BuildIndex(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker);
+    HRESULT AddRoots(ICorDebugProcess5 *pProcess5);
+    bool FindObject(CORDB_ADDRESS address, uint32_t &index);
+    HRESULT GetTypeLayout(ICorDebugProcess5 *pProcess5, const COR_TYPEID &typeId, TypeLayouts &typeLayouts, const TypeLayout *&pTypeLayout);
+    HRESULT AddFieldsRefOffsets(ICorDebugProcess5 *pProcess5, const COR_TYPEID &typeId, ULONG32 baseOffset, int depth, std::vector<ULONG32> &refOffsets);
+    CORDB_ADDRESS ReadPointer(const BYTE *pData);
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <cassert>
+#include "debugger/handlepool.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+const HandlePool::HandleId HandlePool::InvalidHandleId;
+const size_t HandlePool::DefaultBudget;
+
+HandlePool::HandlePool(size_t budget) :
+    m_budget(budget),
+    m_nextId(InvalidHandleId + 1),
+    m_counters()
+{
+    assert(m_budget > 0);
+}
+
+bool HandlePool::IsHandle(ICorDebugValue *pValue)
+{
+    ToRelease<ICorDebugHandleValue> iCorHandleValue;
+    return pValue != nullptr &&
+           SUCCEEDED(pValue->QueryInterface(IID_ICorDebugHandleValue, (LPVOID *) &iCorHandleValue));
+}
+
+HRESULT HandlePool::Add(ICorDebugValue *pValue, Lifetime lifetime, HandleId &id)
+{
+    if (!IsHandle(pValue))
+        return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_lru.size() + m_pinned.size() >= m_budget)
+    {
+        if (!m_lru.empty())
+        {
+            m_index.erase(m_lru.back().id);
+            m_lru.pop_back();
+            m_counters.evicted++;
+        }
+        else
+        {
+            if (m_counters.overBudget == 0)
+                LOGW("Handles budget exceeded, all handles are used by variables references");
+            m_counters.overBudget++;
+        }
+    }
+
+    pValue->AddRef();
+    id = m_nextId++;
+    std::list<HandleEntry> &entries = lifetime == Lifetime::Break ? m_pinned : m_lru;
+    entries.emplace_front(id, lifetime, pValue);
+    m_index.emplace(id, entries.begin());
+
+    m_counters.added++;
+    m_counters.active = m_lru.size() + m_pinned.size();
+    if (m_counters.active > m_counters.peak)
+        m_counters.peak = m_counters.active;
+
+    return S_OK;
+}
+
+HRESULT HandlePool::Get(HandleId id, ICorDebugValue **ppValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    *ppValue = nullptr;
+    auto find = m_index.find(id);
+    if (find == m_index.end())
+    {
+        m_counters.misses++;
+        return S_FALSE;
+    }
+
+    // Move data to begin, so, last used will be on front.
+    if (find->second->lifetime == Lifetime::Session && find->second != m_lru.begin())
+        m_lru.splice(m_lru.begin(), m_lru, find->second);
+
+    find->second->iCorValue->AddRef();
+    *ppValue = find->second->iCorValue.GetPtr();
+    return S_OK;
+}
+
+bool HandlePool::IsAlive(HandleId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.find(id) != m_index.end();
+}
+
+void HandlePool::ReleaseBreakHandles()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto &entry : m_pinned)
+    {
+        m_index.erase(entry.id);
+    }
+    m_counters.released += m_pinned.size();
+    m_pinned.clear();
+    m_counters.active = m_lru.size();
+}
+
+void HandlePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    LOGI("Handles: peak %u, added %llu, evicted %llu, over budget %llu, released %llu, misses %llu",
+         (unsigned)m_counters.peak, (unsigned long long)m_counters.added, (unsigned long long)m_counters.evicted,
+         (unsigned long long)m_counters.overBudget, (unsigned long long)(m_counters.released + m_lru.size() + m_pinned.size()),
+         (unsigned long long)m_counters.misses);
+
+    m_index.clear();
+    m_lru.clear();
+    m_pinned.clear();
+    m_counters = Counters();
+}
+
+HandlePool::Counters HandlePool::GetCounters()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counters;
+}
+
+} // namespace netcoredbg
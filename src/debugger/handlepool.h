@@ -0,0 +1,97 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Pool that own GC handles (ICorDebugHandleValue) created by debugger during session.
+// Because handles affect the performance of the garbage collector, the debugger should limit itself to a relatively
+// small number of handles (about 256) that are active at a time.
+// https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/icordebugheapvalue2-createhandle-method
+// Pool hold only one reference for each handle, so, handle will be released (and disposed by runtime) at eviction.
+// In case pool is full, least recently used handle with `Lifetime::Session` is evicted. Handles with `Lifetime::Break`
+// are pinned until 'Continue' (variables references still point to them), pool could exceed budget in this case.
+class HandlePool
+{
+public:
+
+    typedef uint64_t HandleId;
+    static const HandleId InvalidHandleId = 0;
+    static const size_t DefaultBudget = 256;
+
+    enum class Lifetime
+    {
+        Break,  // released at 'Continue' (eval results and exception objects in variables references)
+        Session // released at debug session cleanup (type objects cache)
+    };
+
+    struct Counters
+    {
+        size_t active;     // handles owned by pool right now
+        size_t peak;       // max of `active` during session
+        uint64_t added;    // handles added into pool
+        uint64_t evicted;  // handles released in order to fit into budget
+        uint64_t overBudget; // handles added into full pool without eviction (all handles are pinned)
+        uint64_t released; // handles released at 'Continue' or session cleanup
+        uint64_t misses;   // requests for already evicted handles
+    };
+
+    HandlePool(size_t budget = DefaultBudget);
+
+    // Check, that value is handle and could be owned by pool.
+    static bool IsHandle(ICorDebugValue *pValue);
+
+    // Add handle into pool, value must implement ICorDebugHandleValue. Pool take its own reference.
+    HRESULT Add(ICorDebugValue *pValue, Lifetime lifetime, HandleId &id);
+    // Get value for handle and mark handle as recently used.
+    // Return S_FALSE and null value in case handle was already evicted or released.
+    HRESULT Get(HandleId id, ICorDebugValue **ppValue);
+    bool IsAlive(HandleId id);
+    // Release all handles with `Lifetime::Break` (called at 'Continue').
+    void ReleaseBreakHandles();
+    // Release all handles.
+    void Clear();
+
+    Counters GetCounters();
+
+private:
+
+    struct HandleEntry
+    {
+        HandleId id;
+        Lifetime lifetime;
+        ToRelease<ICorDebugValue> iCorValue;
+
+        HandleEntry(HandleId id, Lifetime lifetime, ICorDebugValue *pValue) :
+            id(id),
+            lifetime(lifetime),
+            iCorValue(pValue)
+        {}
+        HandleEntry(HandleEntry &&that) = default;
+        HandleEntry(const HandleEntry &that) = delete;
+    };
+
+    std::mutex m_mutex;
+    const size_t m_budget;
+    HandleId m_nextId;
+    Counters m_counters;
+    // At access, element moved to front of list, new element also add to front. In this way, evicted element is list's back.
+    // Note, only `Lifetime::Session` handles are here.
+    std::list<HandleEntry> m_lru;
+    // `Lifetime::Break` handles, never evicted.
+    std::list<HandleEntry> m_pinned;
+    std::unordered_map<HandleId, std::list<HandleEntry>::iterator> m_index;
+};
+
+} // namespace netcoredbg
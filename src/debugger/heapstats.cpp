@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <algorithm>
+#include "debugger/heapstats.h"
+#include "metadata/typeprinter.h"
+#include "utils/logger.h"
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Caller must care about m_mutex.
+const std::string &HeapStatsCollector::GetTypeName(ICorDebugProcess5 *pProcess5, const COR_TYPEID &typeId)
+{
+    auto find = m_typeNames.find(typeId);
+    if (find != m_typeNames.end())
+        return find->second;
+
+    std::string typeName;
+    ToRelease<ICorDebugType> iCorType;
+    if (FAILED(pProcess5->GetTypeForTypeID(typeId, &iCorType)) ||
+        FAILED(TypePrinter::NameForTypeByType(iCorType, typeName)))
+    {
+        typeName = "<unknown type>";
+    }
+
+    return m_typeNames.emplace(typeId, std::move(typeName)).first->second;
+}
+
+HRESULT HeapStatsCollector::CollectHeapStats(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker, uint32_t baseSnapshotId, HeapStats &heapStats)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto findBase = std::find_if(m_snapshots.begin(), m_snapshots.end(),
+                                 [&](const std::pair<uint32_t, Snapshot> &entry) { return entry.first == baseSnapshotId; });
+    if (baseSnapshotId != 0 && findBase == m_snapshots.end())
+        return E_INVALIDARG;
+
+    // Aggregate by type ID during walk, type names resolved after walk for each type only once.
+    std::unordered_map<COR_TYPEID, TypeCounters, TypeIdHash, TypeIdEqual> typeCounters;
+    IfFailRet(pHeapWalker->Walk(pProcess, [&](const COR_HEAPOBJECT &heapObject) -> HRESULT
+    {
+        TypeCounters &counters = typeCounters[heapObject.type];
+        counters.count++;
+        counters.size += heapObject.size;
+        return S_OK;
+    }));
+
+    Snapshot snapshot;
+    for (const auto &entry : typeCounters)
+    {
+        // Different type IDs could have same name (for example, same type from different load contexts).
+        TypeCounters &counters = snapshot[GetTypeName(iCorProcess5, entry.first)];
+        counters.count += entry.second.count;
+        counters.size += entry.second.size;
+    }
+
+    heapStats = HeapStats();
+    heapStats.snapshotId = m_nextSnapshotId++;
+    heapStats.baseSnapshotId = baseSnapshotId;
+    heapStats.types.reserve(snapshot.size());
+    for (const auto &entry : snapshot)
+    {
+        heapStats.types.emplace_back();
+        HeapTypeStats &typeStats = heapStats.types.back();
+        typeStats.typeName = entry.first;
+        typeStats.count = entry.second.count;
+        typeStats.size = entry.second.size;
+        heapStats.totalCount += entry.second.count;
+        heapStats.totalSize += entry.second.size;
+
+        if (baseSnapshotId == 0)
+            continue;
+
+        auto findType = findBase->second.find(entry.first);
+        const TypeCounters baseCounters = findType == findBase->second.end() ? TypeCounters() : findType->second;
+        typeStats.countDiff = int64_t(entry.second.count) - int64_t(baseCounters.count);
+        typeStats.sizeDiff = int64_t(entry.second.size) - int64_t(baseCounters.size);
+    }
+
+    // Types, that have no objects in new snapshot.
+    if (baseSnapshotId != 0)
+    {
+        for (const auto &entry : findBase->second)
+        {
+            if (snapshot.find(entry.first) != snapshot.end())
+                continue;
+
+            heapStats.types.emplace_back();
+            HeapTypeStats &typeStats = heapStats.types.back();
+            typeStats.typeName = entry.first;
+            typeStats.countDiff = -int64_t(entry.second.count);
+            typeStats.sizeDiff = -int64_t(entry.second.size);
+        }
+    }
+
+    std::sort(heapStats.types.begin(), heapStats.types.end(), [](const HeapTypeStats &left, const HeapTypeStats &right)
+    {
+        return left.size != right.size ? left.size > right.size : left.typeName < right.typeName;
+    });
+
+    if (m_snapshots.size() == MaxSnapshots)
+        m_snapshots.pop_front();
+    m_snapshots.emplace_back(heapStats.snapshotId, std::move(snapshot));
+
+    LOGI("Heap snapshot %u: %llu objects, %llu bytes, %u types", heapStats.snapshotId, (unsigned long long)heapStats.totalCount,
+         (unsigned long long)heapStats.totalSize, (unsigned)heapStats.types.size());
+
+    return S_OK;
+}
+
+void HeapStatsCollector::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_snapshots.clear();
+    m_typeNames.clear();
+}
+
+} // namespace netcoredbg
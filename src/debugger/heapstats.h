@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "interfaces/types.h"
+#include "debugger/heapwalker.h"
+
+namespace netcoredbg
+{
+
+// Managed heap statistics (objects count and size per type). Few last snapshots are stored, so, new snapshot could be
+// compared with snapshot made at previous stop.
+class HeapStatsCollector
+{
+public:
+
+    HeapStatsCollector() : m_nextSnapshotId(1) {}
+
+    // [in] baseSnapshotId - snapshot for diff, 0 in case diff is not needed.
+    HRESULT CollectHeapStats(ICorDebugProcess *pProcess, HeapWalker *pHeapWalker, uint32_t baseSnapshotId, HeapStats &heapStats);
+    void Clear();
+
+private:
+
+    static const size_t MaxSnapshots = 8;
+
+    struct TypeCounters
+    {
+        uint64_t count;
+        uint64_t size;
+
+        TypeCounters() : count(0), size(0) {}
+    };
+
+    typedef std::unordered_map<std::string, TypeCounters> Snapshot;
+
+    std::mutex m_mutex;
+    uint32_t m_nextSnapshotId;
+    // New snapshot added to back, oldest snapshot removed from front.
+    std::list<std::pair<uint32_t, Snapshot>> m_snapshots;
+    // Type names are resolved only once for each type during debug session, since most of types survive between stops.
+    std::unordered_map<COR_TYPEID, std::string, TypeIdHash, TypeIdEqual> m_typeNames;
+
+    const std::string &GetTypeName(ICorDebugProcess5 *pProcess5, const COR_TYPEID &typeId);
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <algorithm>
+#include "debugger/heapwalker.h"
+#include "utils/logger.h"
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Return summary size of all GC heap segments or 0 in case of error, used for walk progress only.
+static ULONG64 GetHeapSize(ICorDebugProcess5 *pProcess5)
+{
+    ToRelease<ICorDebugHeapSegmentEnum> iCorSegmentEnum;
+    if (FAILED(pProcess5->EnumerateHeapRegions(&iCorSegmentEnum)))
+        return 0;
+
+    ULONG64 heapSize = 0;
+    COR_SEGMENT segment;
+    ULONG fetched = 0;
+    while (SUCCEEDED(iCorSegmentEnum->Next(1, &segment, &fetched)) && fetched == 1)
+    {
+        heapSize += segment.end - segment.start;
+    }
+
+    return heapSize;
+}
+
+HRESULT HeapWalker::WalkObjects(ICorDebugHeapEnum *pHeapEnum, ULONG64 heapSize, HeapObjectCallback &cb)
+{
+    HRESULT Status;
+    COR_HEAPOBJECT heapObjects[HeapObjectsBatch];
+    ULONG fetched = 0;
+    ULONG64 walkedSize = 0;
+    unsigned percentage = 0;
+    do
+    {
+        if (m_canceled)
+        {
+            LOGI("Heap walk canceled.");
+            return COR_E_OPERATIONCANCELED;
+        }
+
+        IfFailRet(pHeapEnum->Next(HeapObjectsBatch, heapObjects, &fetched));
+
+        for (ULONG i = 0; i < fetched; i++)
+        {
+            IfFailRet(cb(heapObjects[i]));
+            if (Status == S_FALSE)
+                return S_OK;
+
+            walkedSize += heapObjects[i].size;
+        }
+
+        if (m_progressCallback && heapSize != 0)
+        {
+            // Segments could have free space, so, walked objects size never reach heap size, 100% reported at walk end only.
+            const unsigned newPercentage = unsigned(std::min<ULONG64>(99, walkedSize * 100 / heapSize));
+            if (newPercentage > percentage)
+            {
+                percentage = newPercentage;
+                m_progressCallback(ProgressUpdate, percentage);
+            }
+        }
+    }
+    while (fetched == HeapObjectsBatch);
+
+    return S_OK;
+}
+
+HRESULT HeapWalker::Walk(ICorDebugProcess *pProcess, HeapObjectCallback cb)
+{
+    if (m_canceled)
+    {
+        LOGI("Heap walk canceled.");
+        return COR_E_OPERATIONCANCELED;
+    }
+
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+
+    COR_HEAPINFO heapInfo;
+    IfFailRet(iCorProcess5->GetGCHeapInformation(&heapInfo));
+    if (!heapInfo.areGCStructuresValid)
+    {
+        LOGW("GC structures are not valid, heap walk is not possible at this point.");
+        return CORDBG_E_GC_STRUCTURES_INVALID;
+    }
+
+    ToRelease<ICorDebugHeapEnum> iCorHeapEnum;
+    IfFailRet(iCorProcess5->EnumerateHeap(&iCorHeapEnum));
+
+    if (m_progressCallback)
+        m_progressCallback(ProgressStart, 0);
+
+    Status = WalkObjects(iCorHeapEnum, m_progressCallback ? GetHeapSize(iCorProcess5) : 0, cb);
+
+    if (m_progressCallback)
+        m_progressCallback(ProgressEnd, 100);
+
+    return Status;
+}
+
+void HeapWalker::Cancel()
+{
+    m_canceled = true;
+}
+
+void HeapWalker::ResetCancel()
+{
+    m_canceled = false;
+}
+
+} // namespace netcoredbg
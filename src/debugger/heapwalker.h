@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <atomic>
+#include <functional>
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+// Hash and comparison for COR_TYPEID, in order to use it as key in unordered containers.
+struct TypeIdHash
+{
+    size_t operator()(const COR_TYPEID &typeId) const
+    {
+        return std::hash<ULONG64>()(typeId.token1) ^ (std::hash<ULONG64>()(typeId.token2) << 1);
+    }
+};
+
+struct TypeIdEqual
+{
+    bool operator()(const COR_TYPEID &left, const COR_TYPEID &right) const
+    {
+        return left.token1 == right.token1 && left.token2 == right.token2;
+    }
+};
+
+// Managed heap walk (ICorDebugProcess5::EnumerateHeap). Objects are requested from runtime and provided to caller
+// by small batches, so, walk don't need memory for whole heap (that could be few GB) and could be canceled between batches.
+class HeapWalker
+{
+public:
+
+    // Return S_FALSE in order to stop walk, any failed return code will stop walk with this code.
+    typedef std::function<HRESULT(const COR_HEAPOBJECT &heapObject)> HeapObjectCallback;
+    // Called at walk start and end, and in case walk progress (walked objects size in percents of heap size) changed.
+    typedef std::function<void(ProgressReason reason, unsigned percentage)> ProgressCallback;
+
+    HeapWalker(ProgressCallback progressCallback = nullptr) :
+        m_progressCallback(progressCallback),
+        m_canceled(false)
+    {}
+
+    // Note, process must be stopped, since heap walk is possible only in case GC structures are valid.
+    HRESULT Walk(ICorDebugProcess *pProcess, HeapObjectCallback cb);
+    // Could be called from any thread, running walk will be stopped with COR_E_OPERATIONCANCELED.
+    void Cancel();
+    // Must be called at heap walk request acceptance (before walk start), so, cancel received after this call but
+    // before walk start is not lost. Note, command could have few walks, all of them will be canceled.
+    void ResetCancel();
+
+private:
+
+    static const ULONG HeapObjectsBatch = 256;
+    ProgressCallback m_progressCallback;
+    std::atomic<bool> m_canceled;
+
+    HRESULT WalkObjects(ICorDebugHeapEnum *pHeapEnum, ULONG64 heapSize, HeapObjectCallback &cb);
+};
+
+} // namespace netcoredbg
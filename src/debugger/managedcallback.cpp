@@ -13,15 +13,28 @@
 #include "debugger/breakpoints.h"
 #include "debugger/waitpid.h"
 #include "debugger/evalstackmachine.h"
+#include "debugger/coverage.h"
+#include "debugger/outputaggregator.h"
 #include "metadata/modules.h"
 #include "interfaces/iprotocol.h"
 #include "utils/utf.h"
+#include "utils/timeline.h"
 #include "managed/interop.h"
 
 
 namespace netcoredbg
 {
 
+// Debuggee output must be delivered before exited event.
+static void FlushDebuggeeOutput(OutputAggregator &outputAggregator)
+{
+    outputAggregator.Flush();
+
+    const OutputAggregator::Stats stats = outputAggregator.GetStats();
+    LOGI("Debuggee output: %llu bytes emitted, %llu bytes dropped (%llu chunks)", (unsigned long long)stats.emittedBytes,
+         (unsigned long long)stats.droppedBytes, (unsigned long long)stats.droppedChunks);
+}
+
 ULONG ManagedCallback::GetRefCount()
 {
     LogFuncEntry();
@@ -91,6 +104,22 @@ ULONG STDMETHODCALLTYPE ManagedCallback::Release()
 HRESULT STDMETHODCALLTYPE ManagedCallback::Breakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
 {
     LogFuncEntry();
+
+    // Coverage breakpoint is removed at first hit and never stop debuggee, don't queue it.
+    if (m_debugger.m_uniqueCodeCoverage->ManagedCallbackBreakpoint(pBreakpoint) == S_OK)
+        return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
+
+    // Breakpoint hit rejected by cheap filters don't need stop of the whole debugger machinery (queue, worker thread),
+    // continue right here. Note, during evaluation all breakpoints are ignored by AddCallbackToQueue() anyway.
+    const auto start = std::chrono::steady_clock::now();
+    if (!m_debugger.m_sharedEvalWaiter->IsEvalRunning() &&
+        m_debugger.m_sharedBreakpoints->ManagedCallbackBreakpointFilter(pThread, pBreakpoint) == S_OK)
+    {
+        HRESULT Status = m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
+        m_debugger.m_sharedBreakpoints->AddRejectedHitLatency(std::chrono::steady_clock::now() - start);
+        return Status;
+    }
+
     return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]()
     {
         pAppDomain->AddRef();
@@ -151,6 +180,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::EvalException(ICorDebugAppDomain *pAp
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProcess)
 {
     LogFuncEntry();
+    Timeline::Scope timelineScope("CreateProcess", "callback");
 
     // ManagedPart must be initialized only once for process, since CoreCLR don't support unload and reinit
     // for global variables. coreclr_shutdown only should be called on process exit.
@@ -180,7 +210,9 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProc
 
         m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(nullptr, nullptr);
 
-        m_debugger.pProtocol->EmitExitedEvent(ExitedEvent(GetWaitpid().GetExitCode()));
+        FlushDebuggeeOutput(*m_debugger.m_uniqueOutputAggregator);
+        m_debugger.pProtocol->EmitExitedEvent(ExitedEvent(GetWaitpid().GetExitCode(m_debugger.m_processId)));
+        GetWaitpid().StopTrackingPID(m_debugger.m_processId);
         m_debugger.NotifyProcessExited();
         m_debugger.pProtocol->EmitTerminatedEvent();
         m_debugger.m_ioredirect.async_cancel();
@@ -234,7 +266,8 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProces
     // C# Main() return values is int (signed int) or void (return 0)
     int exitCode = 0;
 #ifdef FEATURE_PAL
-    exitCode = GetWaitpid().GetExitCode();
+    exitCode = GetWaitpid().GetExitCode(m_debugger.m_processId);
+    GetWaitpid().StopTrackingPID(m_debugger.m_processId);
 #else
     HPROCESS hProcess;
     DWORD dwExitCode = 0;
@@ -245,6 +278,12 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProces
     }
 #endif // FEATURE_PAL
 
+    std::string coverageSummary;
+    m_debugger.m_uniqueCodeCoverage->WriteReport(coverageSummary);
+    if (!coverageSummary.empty())
+        m_debugger.pProtocol->EmitOutputEvent(OutputConsole, coverageSummary);
+
+    FlushDebuggeeOutput(*m_debugger.m_uniqueOutputAggregator);
     m_debugger.pProtocol->EmitExitedEvent(ExitedEvent(exitCode));
     m_debugger.NotifyProcessExited();
     m_debugger.pProtocol->EmitTerminatedEvent();
@@ -272,6 +311,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitThread(ICorDebugAppDomain *pAppDo
 
     ThreadId threadId(getThreadId(pThread));
     m_debugger.m_sharedThreads->Remove(threadId);
+    FrameId::invalidate(std::vector<ThreadId>{threadId});
 
     m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(pThread, nullptr);
     if (m_debugger.GetLastStoppedThreadId() == threadId)
@@ -286,10 +326,13 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitThread(ICorDebugAppDomain *pAppDo
 HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
     LogFuncEntry();
+    Timeline::Scope timelineScope("LoadModule", "callback");
 
     Module module;
     std::string outputText;
     m_debugger.m_sharedModules->TryLoadModuleSymbols(pModule, module, m_debugger.IsJustMyCode(), m_debugger.IsHotReload(), outputText);
+    if (timelineScope.IsEnabled())
+        timelineScope.SetDetail(module.name);
     if (!outputText.empty())
     {
         m_debugger.pProtocol->EmitOutputEvent(OutputStdErr, outputText);
@@ -299,11 +342,17 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDo
     if (module.symbolStatus == SymbolsLoaded)
     {
         std::vector<BreakpointEvent> events;
-        m_debugger.m_sharedBreakpoints->ManagedCallbackLoadModule(pModule, events);
+        {
+            Timeline::Scope resolveScope("ResolveBreakpoints", "breakpoints");
+            m_debugger.m_sharedBreakpoints->ManagedCallbackLoadModule(pModule, events);
+        }
         for (const BreakpointEvent &event : events)
         {
             m_debugger.pProtocol->EmitBreakpointEvent(event);
         }
+
+        if (FAILED(m_debugger.m_uniqueCodeCoverage->ManagedCallbackLoadModule(pModule)))
+            LOGW("Code coverage breakpoints setup failed for %s", module.path.c_str());
     }
     m_debugger.m_sharedBreakpoints->ManagedCallbackLoadModuleAll(pModule);
 
@@ -320,6 +369,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDo
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
     LogFuncEntry();
+    m_debugger.m_sharedBreakpoints->ManagedCallbackUnloadModule(pModule);
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
@@ -461,33 +511,19 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::DestroyConnection(ICorDebugProcess *p
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
-static HRESULT GetExceptionModuleName(ICorDebugFrame *pFrame, std::string &excModule)
+// Note, module name is not resolved here, since most of exceptions will be filtered out and never stop debuggee.
+static ICorDebugModule *GetExceptionModule(ICorDebugFrame *pFrame)
 {
     // Exception was thrown outside of managed code (for example, by runtime).
     if (pFrame == nullptr)
-    {
-        excModule = "<unknown module>";
-        return S_OK;
-    }
+        return nullptr;
 
-    HRESULT Status;
     ToRelease<ICorDebugFunction> pFunc;
-    IfFailRet(pFrame->GetFunction(&pFunc));
-
     ToRelease<ICorDebugModule> pModule;
-    IfFailRet(pFunc->GetModule(&pModule));
-
-    ToRelease<IUnknown> pMDUnknown;
-    ToRelease<IMetaDataImport> pMDImport;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
+    if (FAILED(pFrame->GetFunction(&pFunc)) || FAILED(pFunc->GetModule(&pModule)))
+        return nullptr;
 
-    WCHAR mdName[mdNameLen];
-    ULONG nameLen;
-    IfFailRet(pMDImport->GetScopeProps(mdName, _countof(mdName), &nameLen, nullptr));
-    excModule = to_utf8(mdName);
-
-    return S_OK;
+    return pModule.Detach();
 }
 
 static ExceptionCallbackType CorrectedByJMCCatchHandlerEventType(ICorDebugFrame *pFrame, bool justMyCode)
@@ -518,16 +554,16 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDom
     {
         // pFrame could be neutered in case of evaluation during brake, do all stuff with pFrame in callback itself.
         ExceptionCallbackType eventType;
-        std::string excModule;
+        ICorDebugModule *pExcModule = nullptr; // ownership is moved to queue entry
         switch(dwEventType)
         {
         case DEBUG_EXCEPTION_FIRST_CHANCE:
             eventType = ExceptionCallbackType::FIRST_CHANCE;
-            GetExceptionModuleName(pFrame, excModule);
+            pExcModule = GetExceptionModule(pFrame);
             break;
         case DEBUG_EXCEPTION_USER_FIRST_CHANCE:
             eventType = ExceptionCallbackType::USER_FIRST_CHANCE;
-            GetExceptionModuleName(pFrame, excModule);
+            pExcModule = GetExceptionModule(pFrame);
             break;
         case DEBUG_EXCEPTION_CATCH_HANDLER_FOUND:
             eventType = CorrectedByJMCCatchHandlerEventType(pFrame, m_debugger.IsJustMyCode());
@@ -539,7 +575,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDom
 
         pAppDomain->AddRef();
         pThread->AddRef();
-        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Exception, pAppDomain, pThread, nullptr, STEP_NORMAL, eventType, excModule);
+        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Exception, pAppDomain, pThread, nullptr, STEP_NORMAL, eventType, pExcModule);
     });
 }
 
@@ -24,6 +24,7 @@
 #include "debugger/evalstackmachine.h"
 #include "debugger/evaluator.h"
 #include "debugger/evalwaiter.h"
+#include "debugger/handlepool.h"
 #include "debugger/variables.h"
 #include "debugger/breakpoint_break.h"
 #include "debugger/breakpoint_entry.h"
@@ -42,6 +43,14 @@
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
+#include "debugger/async_callstack.h"
+#include "debugger/heapwalker.h"
+#include "debugger/heapstats.h"
+#include "debugger/gcrootpaths.h"
+#include "debugger/samplingprofiler.h"
+#include "debugger/coverage.h"
+#include "debugger/tracerecorder.h"
+#include "debugger/outputaggregator.h"
 #include "managed/interop.h"
 #include "metadata/interop_libraries.h"
 #include "utils/utf.h"
@@ -51,6 +60,7 @@
 #include "utils/logger.h"
 #include "debugger/waitpid.h"
 #include "utils/iosystem.h"
+#include "utils/timeline.h"
 
 #ifdef INTEROP_DEBUGGING
 #include "elf++.h"
@@ -76,6 +86,10 @@ namespace
 {
     const auto startupWaitTimeout = std::chrono::milliseconds(5000);
 
+    // Process launch change debugger's working directory and substitute standard files, this is process wide state,
+    // that could be shared by few debug sessions (multi-session server).
+    std::mutex g_launchMutex;
+
     const std::string envDOTNET_STARTUP_HOOKS = "DOTNET_STARTUP_HOOKS";
 #ifdef FEATURE_PAL
     const char delimiterDOTNET_STARTUP_HOOKS = ':';
@@ -175,6 +189,23 @@ void ManagedDebuggerBase::InvalidateLastStoppedThreadId()
     SetLastStoppedThreadId(ThreadId::AllThreads);
 }
 
+// Note, frames are shared by all debug sessions in process, clear only frames of this debuggee threads.
+void ManagedDebuggerBase::InvalidateFrames()
+{
+#ifdef INTEROP_DEBUGGING
+    if (m_interopDebugging)
+    {
+        // Native threads are not tracked by m_sharedThreads, interop debugging can't be used by multi-session server.
+        FrameId::invalidate();
+        return;
+    }
+#endif // INTEROP_DEBUGGING
+
+    std::vector<ThreadId> threads;
+    m_sharedThreads->GetThreadIds(threads);
+    FrameId::invalidate(threads);
+}
+
 ThreadId ManagedDebugger::GetLastStoppedThreadId()
 {
     LogFuncEntry();
@@ -192,12 +223,20 @@ ManagedDebuggerBase::ManagedDebuggerBase(IProtocol *pProtocol_) :
     m_sharedThreads(new Threads),
     m_sharedModules(new Modules),
     m_sharedEvalWaiter(new EvalWaiter),
-    m_sharedEvalHelpers(new EvalHelpers(m_sharedModules, m_sharedEvalWaiter)),
+    m_sharedHandlePool(new HandlePool),
+    m_sharedEvalHelpers(new EvalHelpers(m_sharedModules, m_sharedEvalWaiter, m_sharedHandlePool)),
     m_sharedEvalStackMachine(new EvalStackMachine),
     m_sharedEvaluator(new Evaluator(m_sharedModules, m_sharedEvalHelpers, m_sharedEvalStackMachine)),
-    m_sharedVariables(new Variables(m_sharedEvalHelpers, m_sharedEvaluator, m_sharedEvalStackMachine)),
-    m_uniqueSteppers(new Steppers(m_sharedModules, m_sharedEvalHelpers)),
-    m_sharedBreakpoints(new Breakpoints(m_sharedModules, m_sharedEvaluator, m_sharedEvalHelpers, m_sharedVariables)),
+    m_sharedVariables(new Variables(m_sharedEvalHelpers, m_sharedEvaluator, m_sharedEvalStackMachine, m_sharedHandlePool)),
+    m_sharedAsyncInfo(new AsyncInfo(m_sharedModules)),
+    m_uniqueSteppers(new Steppers(m_sharedModules, m_sharedAsyncInfo, m_sharedEvalHelpers)),
+    m_uniqueAsyncCallStack(new AsyncCallStack(m_sharedModules, m_sharedAsyncInfo)),
+    m_uniqueHeapWalker(new HeapWalker(std::bind(&ManagedDebuggerBase::HeapWalkProgress, this, std::placeholders::_1, std::placeholders::_2))),
+    m_uniqueHeapStatsCollector(new HeapStatsCollector),
+    m_uniqueGCRootPaths(new GCRootPaths),
+    m_sharedTraceRecorder(new TraceRecorder),
+    m_uniqueCodeCoverage(new CodeCoverage(m_sharedModules)),
+    m_sharedBreakpoints(new Breakpoints(m_sharedModules, m_sharedEvaluator, m_sharedEvalHelpers, m_sharedVariables, m_sharedThreads, m_sharedTraceRecorder)),
     m_sharedCallbacksQueue(nullptr),
     m_uniqueManagedCallback(nullptr),
 #ifdef INTEROP_DEBUGGING
@@ -206,9 +245,15 @@ ManagedDebuggerBase::ManagedDebuggerBase(IProtocol *pProtocol_) :
     m_justMyCode(true),
     m_stepFiltering(true),
     m_hotReload(false),
+    m_asyncCallStack(false),
+    m_collapseExternalCode(false),
     m_interopDebugging(false),
     m_unregisterToken(nullptr),
     m_processId(0),
+    m_uniqueOutputAggregator(new OutputAggregator([this](OutputCategory category, string_view text)
+    {
+        pProtocol->EmitOutputEvent(category, text);
+    })),
     m_ioredirect(
         { IOSystem::unnamed_pipe(), IOSystem::unnamed_pipe(), IOSystem::unnamed_pipe() },
         std::bind(&ManagedDebugger::InputCallback, this, std::placeholders::_1, std::placeholders::_2)
@@ -251,7 +296,7 @@ HRESULT ManagedDebugger::Initialize()
 
 HRESULT ManagedDebuggerHelpers::RunIfReady()
 {
-    FrameId::invalidate();
+    InvalidateFrames();
 
     if (m_startMethod == StartNone || !m_isConfigurationDone)
         return S_OK;
@@ -381,7 +426,9 @@ HRESULT ManagedDebugger::StepCommand(ThreadId threadId, StepType stepType)
     IfFailRet(m_uniqueSteppers->SetupStep(pThread, stepType));
 
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
-    FrameId::invalidate(); // Clear all created during break frames.
+    m_sharedHandlePool->ReleaseBreakHandles();
+    m_uniqueGCRootPaths->Invalidate();
+    InvalidateFrames(); // Clear all created during break frames.
     pProtocol->EmitContinuedEvent(threadId); // VSCode protocol need thread ID.
 
     // Note, process continue must be after event emitted, since we could get new stop event from queue here.
@@ -413,7 +460,9 @@ HRESULT ManagedDebugger::Continue(ThreadId threadId)
     }
 
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
-    FrameId::invalidate(); // Clear all created during break frames.
+    m_sharedHandlePool->ReleaseBreakHandles();
+    m_uniqueGCRootPaths->Invalidate();
+    InvalidateFrames(); // Clear all created during break frames.
     pProtocol->EmitContinuedEvent(threadId); // VSCode protocol need thread ID.
 
     // Note, process continue must be after event emitted, since we could get new stop event from queue here.
@@ -552,6 +601,7 @@ static std::string GetCLRPath(dbgshim_t &dbgshim, DWORD pid, int timeoutSec = 3)
 
 HRESULT ManagedDebuggerHelpers::Startup(IUnknown *punk)
 {
+    Timeline::Scope timelineScope("Startup", "startup");
     HRESULT Status;
 
     ToRelease<ICorDebug> iCorDebug;
@@ -691,6 +741,7 @@ static void PrepareSystemEnvironmentArg(const std::map<std::string, std::string>
 
 HRESULT ManagedDebuggerHelpers::RunProcess(const std::string& fileExec, const std::vector<std::string>& execArgs)
 {
+    Timeline::Scope timelineScope("RunProcess", "startup");
     HRESULT Status;
 
     IfFailRet(CheckNoProcess());
@@ -722,6 +773,8 @@ HRESULT ManagedDebuggerHelpers::RunProcess(const std::string& fileExec, const st
     }
 #endif INTEROP_DEBUGGING
 
+    std::unique_lock<std::mutex> lockLaunch(g_launchMutex);
+
     // cwd in launch.json set working directory for debugger https://code.visualstudio.com/docs/python/debugging#_cwd
     if (!m_cwd.empty())
     {
@@ -730,6 +783,7 @@ HRESULT ManagedDebuggerHelpers::RunProcess(const std::string& fileExec, const st
     }
 
     Status = m_ioredirect.exec([&]() -> HRESULT {
+            Timeline::Scope createScope("CreateProcessForLaunch", "startup");
             IfFailRet(m_dbgshim.CreateProcessForLaunch(reinterpret_cast<LPWSTR>(const_cast<WCHAR*>(to_utf16(ss.str()).c_str())),
                                      /* Suspend process */ TRUE,
                                      outEnv.empty() ? NULL : &outEnv[0],
@@ -738,6 +792,8 @@ HRESULT ManagedDebuggerHelpers::RunProcess(const std::string& fileExec, const st
             return Status;
         });
 
+    lockLaunch.unlock();
+
     if (FAILED(Status))
         return Status;
 
@@ -745,7 +801,10 @@ HRESULT ManagedDebuggerHelpers::RunProcess(const std::string& fileExec, const st
     GetWaitpid().SetupTrackingPID(m_processId);
 #endif // FEATURE_PAL
 
-    IfFailRet(m_dbgshim.RegisterForRuntimeStartup(m_processId, ManagedDebugger::StartupCallback, this, &m_unregisterToken));
+    {
+        Timeline::Scope registerScope("RegisterForRuntimeStartup", "startup");
+        IfFailRet(m_dbgshim.RegisterForRuntimeStartup(m_processId, ManagedDebugger::StartupCallback, this, &m_unregisterToken));
+    }
 
     // Resume the process so that StartupCallback can run
     IfFailRet(m_dbgshim.ResumeProcess(resumeHandle));
@@ -796,6 +855,9 @@ HRESULT ManagedDebuggerHelpers::DetachFromProcess()
         HRESULT Status;
         if (FAILED(Status = m_iCorProcess->Detach()))
             LOGE("Process detach failed: %s", errormessage(Status));
+#ifdef FEATURE_PAL
+        GetWaitpid().StopTrackingPID(m_processId);
+#endif // FEATURE_PAL
 
         m_processAttachedState = ProcessAttachedState::Unattached; // Since we free process object anyway, reset process attached state.
     } while(0);
@@ -841,8 +903,26 @@ void ManagedDebuggerBase::Cleanup()
     m_sharedModules->CleanupAllModules();
     m_sharedEvalHelpers->Cleanup();
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
+    m_sharedHandlePool->Clear();
+    m_uniqueAsyncCallStack->Clear();
+    m_uniqueHeapStatsCollector->Clear();
+    m_uniqueGCRootPaths->Invalidate();
     pProtocol->Cleanup();
 
+    m_samplingProfilerMutex.lock();
+    m_uniqueSamplingProfiler.reset(); // Must be stopped before process release.
+    m_samplingProfilerMutex.unlock();
+
+    // Usually, report was written at process exit, but detach or terminate case also should be covered.
+    std::string coverageSummary;
+    m_uniqueCodeCoverage->WriteReport(coverageSummary); // Must release breakpoints before process release.
+
+    if (m_sharedTraceRecorder->IsRecording())
+    {
+        TraceRecordingStats stats;
+        m_sharedTraceRecorder->Stop(stats); // Flush all recorded hits at debug session end.
+    }
+
     std::lock_guard<Utility::RWLock::Writer> guardProcessRWLock(m_debugProcessRWLock.writer);
 
     assert((m_iCorProcess && m_iCorDebug && m_uniqueManagedCallback && m_sharedCallbacksQueue) ||
@@ -866,6 +946,7 @@ void ManagedDebuggerBase::Cleanup()
 
 HRESULT ManagedDebuggerHelpers::AttachToProcess()
 {
+    Timeline::Scope timelineScope("AttachToProcess", "startup");
     HRESULT Status;
 
     IfFailRet(CheckNoProcess());
@@ -897,7 +978,7 @@ HRESULT ManagedDebuggerHelpers::AttachToProcess()
     return S_OK;
 }
 
-HRESULT ManagedDebugger::GetExceptionInfo(ThreadId threadId, ExceptionInfo &exceptionInfo)
+HRESULT ManagedDebugger::GetExceptionInfo(ThreadId threadId, bool extendedDetails, ExceptionInfo &exceptionInfo)
 {
     LogFuncEntry();
 
@@ -907,7 +988,7 @@ HRESULT ManagedDebugger::GetExceptionInfo(ThreadId threadId, ExceptionInfo &exce
 
     ToRelease<ICorDebugThread> iCorThread;
     IfFailRet(m_iCorProcess->GetThread(int(threadId), &iCorThread));
-    return m_sharedBreakpoints->GetExceptionInfo(iCorThread, exceptionInfo);
+    return m_sharedBreakpoints->GetExceptionInfo(iCorThread, extendedDetails, exceptionInfo);
 }
 
 HRESULT ManagedDebugger::SetExceptionBreakpoints(const std::vector<ExceptionBreakpoint> &exceptionBreakpoints, std::vector<Breakpoint> &breakpoints)
@@ -1104,12 +1185,20 @@ static std::string GetModuleNameForFrame(ICorDebugFrame *pFrame)
 }
 
 HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, ThreadId threadId, FrameLevel startFrame, unsigned maxFrames,
-                                                  std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller)
+                                                  std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller,
+                                                  const CancellationToken &token)
 {
     LogFuncEntry();
 
     HRESULT Status;
-    int currentFrame = -1;
+    int currentFrame = -1; // physical frame level, used for frame id
+    // Frame index in provided call stack, used for paging. Differ from physical frame level in case external code
+    // collapsed, so, collapsed run is provided as one "[External Code]" frame even if run crosses page border.
+    int logicalFrame = -1;
+    auto IsInPage = [&]() -> bool
+    {
+        return logicalFrame >= int(startFrame) && (maxFrames == 0 || logicalFrame < int(startFrame) + int(maxFrames));
+    };
 
     auto AddFrameStatementFlag = [&] ()
     {
@@ -1127,18 +1216,70 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
     static const std::string FrameCLRNativeText = "[Native Frames]";
 #endif // INTEROP_DEBUGGING
 
+    // Outermost async method's frame, logical call stack start from async methods, that await it.
+    ToRelease<ICorDebugFrame> pAsyncFrame;
+
+    // Run of non user code frames collapsed into one "[External Code]" frame, names and sequence points are not resolved
+    // for this frames, only module's JMC bitmap is checked.
+    const bool collapseExternalCode = m_justMyCode && m_collapseExternalCode;
+    bool inExternalCode = false;
+    auto IsExternalCodeFrame = [&](ICorDebugFrame *pFrame) -> bool
+    {
+        mdMethodDef methodToken;
+        CORDB_ADDRESS modAddress;
+        ToRelease<ICorDebugFunction> iCorFunction;
+        ToRelease<ICorDebugModule> iCorModule;
+        if (FAILED(pFrame->GetFunctionToken(&methodToken)) ||
+            FAILED(pFrame->GetFunction(&iCorFunction)) ||
+            FAILED(iCorFunction->GetModule(&iCorModule)) ||
+            FAILED(iCorModule->GetBaseAddress(&modAddress)))
+            return false;
+
+        return !m_sharedModules->IsUserCodeMethod(modAddress, methodToken);
+    };
+
     IfFailRet(WalkFrames(pThread, [&](
         FrameType frameType,
         std::uintptr_t addr,
         ICorDebugFrame *pFrame,
         NativeFrame *pNative)
     {
+        if (token.IsCanceled())
+            return COR_E_OPERATIONCANCELED;
+
         currentFrame++;
 
-        if (currentFrame < int(startFrame))
+        if (m_asyncCallStack && frameType == FrameCLRManaged && m_uniqueAsyncCallStack->IsAsyncMethodFrame(pFrame))
+        {
+            pFrame->AddRef();
+            pAsyncFrame = pFrame;
+        }
+
+        // Note, frames out of page must be checked too, since paging use logical frames.
+        if (collapseExternalCode)
+        {
+            // Note, native and runtime internal frames inside external code run are collapsed too.
+            const bool externalCode = frameType == FrameCLRManaged ? IsExternalCodeFrame(pFrame)
+                                                                   : inExternalCode && (frameType == FrameCLRNative || frameType == FrameCLRInternal);
+            if (externalCode && inExternalCode)
+                return S_OK;
+
+            inExternalCode = externalCode;
+        }
+
+        logicalFrame++;
+        if (!IsInPage())
             return S_OK;
-        if (maxFrames != 0 && currentFrame >= int(startFrame) + int(maxFrames))
+
+        if (inExternalCode)
+        {
+            stackFrames.emplace_back(threadId, FrameLevel{currentFrame}, "[External Code]");
+            stackFrames.back().addr = addr;
+            stackFrames.back().unknownFrameAddr = !addr;
+            stackFrames.back().presentationHint = "label";
+            AddFrameStatementFlag();
             return S_OK;
+        }
 
         switch(frameType)
         {
@@ -1193,8 +1334,35 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
         return S_OK;
     }));
 
-    totalFrames = currentFrame + 1;
-    ExceptionInfo exceptionInfo;
+    // In case requested page ends before async call stack, don't follow continuations chain (heap reads for each
+    // awaiting state machine). Count only "[Async Call Stack]" frame, so, protocol client know that more frames
+    // are available and request next page, that will provide real total frames count.
+    const bool skipAsyncFrames = pAsyncFrame != nullptr && maxFrames != 0 && logicalFrame + 1 >= int(startFrame) + int(maxFrames);
+    std::vector<StackFrame> asyncFrames;
+    if (!skipAsyncFrames && pAsyncFrame != nullptr &&
+        SUCCEEDED(m_uniqueAsyncCallStack->GetAsyncCallStack(pAsyncFrame, threadId, FrameLevel{currentFrame + 2}, asyncFrames)) &&
+        !asyncFrames.empty())
+    {
+        currentFrame++;
+        logicalFrame++;
+        if (IsInPage())
+        {
+            stackFrames.emplace_back(FrameId::logical(threadId, FrameLevel{currentFrame}));
+            stackFrames.back().methodName = "[Async Call Stack]";
+            stackFrames.back().unknownFrameAddr = true;
+        }
+
+        for (auto &asyncFrame : asyncFrames)
+        {
+            currentFrame++;
+            logicalFrame++;
+            if (IsInPage())
+                stackFrames.push_back(std::move(asyncFrame));
+        }
+    }
+
+    totalFrames = skipAsyncFrames ? logicalFrame + 2 : logicalFrame + 1;
+    std::string exceptionStackTrace;
     bool analyzeExceptions = true;
     if (!stackFrames.empty())
     {
@@ -1205,7 +1373,9 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
     analyzeExceptions = analyzeExceptions && !m_interopDebugging;
 #endif // INTEROP_DEBUGGING
 
-    if (!analyzeExceptions)
+    // Exception stack trace need func-eval, but stack trace could be requested in parallel with commands queue
+    // (for example, during long evaluation), don't wait for running evaluation end and provide frames as is.
+    if (!analyzeExceptions || m_sharedEvalWaiter->IsEvalRunning())
         return S_OK;
 
 //  Sometimes Coreclr may return the empty stack frame in exception info
@@ -1214,9 +1384,10 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
     int tries = 3;
     for(int tryCount = 0; tryCount < tries; tryCount++)
     {
-        if (SUCCEEDED(GetExceptionInfo (threadId, exceptionInfo)))
+        // Note, only exception stack trace needed here, don't collect all exception details (message, inner exceptions, etc).
+        if (SUCCEEDED(m_sharedBreakpoints->GetExceptionStackTrace(pThread, exceptionStackTrace)))
         {
-            std::stringstream ss(exceptionInfo.details.stackTrace);
+            std::stringstream ss(exceptionStackTrace);
             int countOfNewFrames = 0;
             int currentFrame = -1;
             size_t sizeofStackFrame = stackFrames.size();
@@ -1339,7 +1510,8 @@ HRESULT ManagedDebuggerBase::GetNativeStackTrace(ThreadId threadId, FrameLevel s
 }
 #endif // INTEROP_DEBUGGING
 
-HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller)
+HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames,
+                                       bool hotReloadAwareCaller, const CancellationToken &token)
 {
     LogFuncEntry();
 
@@ -1349,7 +1521,7 @@ HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame,
 
     ToRelease<ICorDebugThread> pThread;
     if (SUCCEEDED(Status = m_iCorProcess->GetThread(int(threadId), &pThread)))
-        return GetManagedStackTrace(pThread, threadId, startFrame, maxFrames, stackFrames, totalFrames, hotReloadAwareCaller);
+        return GetManagedStackTrace(pThread, threadId, startFrame, maxFrames, stackFrames, totalFrames, hotReloadAwareCaller, token);
 
 #ifdef INTEROP_DEBUGGING
     // E_INVALIDARG for ICorDebugProcess::GetThread() mean thread is not managed (can't found ICorDebugThread object that represents the thread)
@@ -1360,6 +1532,136 @@ HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame,
     return Status;
 }
 
+HRESULT ManagedDebugger::GetAsyncTasks(std::vector<AsyncTaskGroup> &taskGroups)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    // Executed in parallel with commands queue, don't walk heap during evaluation.
+    std::lock_guard<Utility::RWLock::Reader> guardInspectionRWLock(m_sharedEvalWaiter->GetInspectionLock());
+    if (m_sharedCallbacksQueue->IsRunning())
+    {
+        LOGW("Can't enumerate async tasks, process is running.");
+        return E_FAIL;
+    }
+
+    return m_uniqueAsyncCallStack->GetAsyncTasks(m_iCorProcess, m_uniqueHeapWalker.get(), taskGroups);
+}
+
+HRESULT ManagedDebugger::GetHeapStats(uint32_t baseSnapshotId, HeapStats &heapStats)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    // Executed in parallel with commands queue, don't walk heap during evaluation.
+    std::lock_guard<Utility::RWLock::Reader> guardInspectionRWLock(m_sharedEvalWaiter->GetInspectionLock());
+    if (m_sharedCallbacksQueue->IsRunning())
+    {
+        LOGW("Can't collect heap statistics, process is running.");
+        return E_FAIL;
+    }
+
+    return m_uniqueHeapStatsCollector->CollectHeapStats(m_iCorProcess, m_uniqueHeapWalker.get(), baseSnapshotId, heapStats);
+}
+
+HRESULT ManagedDebugger::StartSampling(unsigned intervalMs)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    std::lock_guard<std::mutex> lock(m_samplingProfilerMutex);
+    if (m_uniqueSamplingProfiler)
+    {
+        LOGW("Sampling already started.");
+        return E_FAIL;
+    }
+
+    m_uniqueSamplingProfiler.reset(new SamplingProfiler(m_iCorProcess, m_sharedCallbacksQueue, m_debugProcessRWLock,
+                                                        intervalMs != 0 ? intervalMs : SamplingProfiler::DefaultIntervalMs));
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::StopSampling(SamplingResult &result)
+{
+    LogFuncEntry();
+
+    std::lock_guard<std::mutex> lock(m_samplingProfilerMutex);
+    if (!m_uniqueSamplingProfiler)
+    {
+        LOGW("Sampling was not started.");
+        return E_FAIL;
+    }
+
+    m_uniqueSamplingProfiler->Stop(result);
+    m_uniqueSamplingProfiler.reset();
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::StartTraceRecording(const std::string &outputFile)
+{
+    LogFuncEntry();
+
+    // Note, recording could be started before debuggee process start, in order to record tracepoints hits from start.
+    return m_sharedTraceRecorder->Start(outputFile);
+}
+
+HRESULT ManagedDebugger::StopTraceRecording(TraceRecordingStats &stats)
+{
+    LogFuncEntry();
+
+    return m_sharedTraceRecorder->Stop(stats);
+}
+
+HRESULT ManagedDebugger::ReadTrace(const std::string &traceFile, uint32_t tracepointId, unsigned maxRecords, TraceSummary &summary)
+{
+    LogFuncEntry();
+
+    // Offline trace file read, debuggee process is not needed.
+    return TraceRecorder::ReadTrace(traceFile, tracepointId, maxRecords, summary);
+}
+
+HRESULT ManagedDebugger::GetGCRootPaths(uint32_t variablesReference, unsigned maxPaths, std::vector<GCRootPath> &paths)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    // Executed in parallel with commands queue, don't walk heap during evaluation.
+    std::lock_guard<Utility::RWLock::Reader> guardInspectionRWLock(m_sharedEvalWaiter->GetInspectionLock());
+    if (m_sharedCallbacksQueue->IsRunning())
+    {
+        LOGW("Can't find GC root paths, process is running.");
+        return E_FAIL;
+    }
+
+    CORDB_ADDRESS address = 0;
+    IfFailRet(m_sharedVariables->GetObjectAddress(variablesReference, address));
+
+    // Heap could be changed by eval, in this case index must be rebuilt.
+    return m_uniqueGCRootPaths->FindRootPaths(m_iCorProcess, m_uniqueHeapWalker.get(), m_sharedEvalWaiter->GetEvalsCount(),
+                                              address, maxPaths, paths);
+}
+
+void ManagedDebuggerBase::HeapWalkProgress(ProgressReason reason, unsigned percentage)
+{
+    ProgressEvent event(reason, "heapWalk", percentage);
+    if (reason == ProgressStart)
+        event.title = "Managed heap walk";
+
+    pProtocol->EmitProgressEvent(event);
+}
+
 int ManagedDebugger::GetNamedVariables(uint32_t variablesReference)
 {
     LogFuncEntry();
@@ -1372,7 +1674,8 @@ HRESULT ManagedDebugger::GetVariables(
     VariablesFilter filter,
     int start,
     int count,
-    std::vector<Variable> &variables)
+    std::vector<Variable> &variables,
+    const CancellationToken &token)
 {
     LogFuncEntry();
 
@@ -1380,7 +1683,7 @@ HRESULT ManagedDebugger::GetVariables(
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
 
-    return m_sharedVariables->GetVariables(m_iCorProcess, variablesReference, filter, start, count, variables);
+    return m_sharedVariables->GetVariables(m_iCorProcess, variablesReference, filter, start, count, variables, token);
 }
 
 HRESULT ManagedDebugger::GetScopes(FrameId frameId, std::vector<Scope> &scopes)
@@ -1405,11 +1708,38 @@ HRESULT ManagedDebugger::Evaluate(FrameId frameId, const std::string &expression
     return m_sharedVariables->Evaluate(m_iCorProcess, frameId, expression, variable, output);
 }
 
+HRESULT ManagedDebugger::EvaluateBatch(FrameId frameId, int evalFlags, const std::vector<std::string> &expressions,
+                                       std::vector<EvaluateBatchResult> &results)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    return m_sharedVariables->EvaluateBatch(m_iCorProcess, frameId, evalFlags, expressions, results);
+}
+
 void ManagedDebugger::CancelEvalRunning()
 {
     LogFuncEntry();
 
     m_sharedEvalWaiter->CancelEvalRunning();
+    m_uniqueHeapWalker->Cancel();
+}
+
+void ManagedDebugger::CancelHeapWalk()
+{
+    LogFuncEntry();
+
+    m_uniqueHeapWalker->Cancel();
+}
+
+void ManagedDebugger::ResetHeapWalkCancel()
+{
+    LogFuncEntry();
+
+    m_uniqueHeapWalker->ResetCancel();
 }
 
 HRESULT ManagedDebugger::SetVariable(const std::string &name, const std::string &value, uint32_t ref, std::string &output)
@@ -1497,7 +1827,7 @@ void ManagedDebugger::FindVariables(ThreadId thread, FrameLevel framelevel, stri
 
 void ManagedDebuggerBase::InputCallback(IORedirectHelper::StreamType type, span<char> text)
 {
-    pProtocol->EmitOutputEvent(type == IOSystem::Stderr ? OutputStdErr : OutputStdOut, {text.begin(), text.size()});
+    m_uniqueOutputAggregator->Append(type == IOSystem::Stderr ? OutputStdErr : OutputStdOut, {text.begin(), text.size()});
 }
 
 
@@ -1573,6 +1903,31 @@ HRESULT ManagedDebugger::SetHotReload(bool enable)
     return S_OK;
 }
 
+void ManagedDebugger::SetAsyncCallStack(bool enable)
+{
+    m_asyncCallStack = enable;
+}
+
+void ManagedDebugger::SetCollapseExternalCode(bool enable)
+{
+    m_collapseExternalCode = enable;
+}
+
+HRESULT ManagedDebugger::SetCodeCoverage(const std::string &outputFile)
+{
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+
+    // Coverage breakpoints are set at module load, already loaded modules can't be covered.
+    if (m_iCorProcess)
+    {
+        LOGE("Code coverage must be enabled before debuggee process start");
+        return E_FAIL;
+    }
+
+    m_uniqueCodeCoverage->SetOutputFile(outputFile);
+    return S_OK;
+}
+
 #ifdef INTEROP_DEBUGGING
 void ManagedDebugger::SetInteropDebugging(bool enable)
 {
@@ -1641,6 +1996,9 @@ HRESULT ManagedDebuggerBase::ApplyPdbDeltaAndLineUpdates(const std::string &dllF
     for (const BreakpointEvent &event : events)
         pProtocol->EmitBreakpointEvent(event);
 
+    // Changed methods have new async info (new method version), drop data cached for previous version.
+    m_uniqueSteppers->UpdateOnHotReload(pModule, pdbMethodTokens);
+
     return S_OK;
 }
 
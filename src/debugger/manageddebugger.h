@@ -30,12 +30,22 @@ class Steppers;
 class Evaluator;
 class EvalWaiter;
 class EvalHelpers;
+class HandlePool;
 class EvalStackMachine;
 class Variables;
 class ManagedCallback;
 class CallbacksQueue;
 class Breakpoints;
 class Modules;
+class AsyncInfo;
+class AsyncCallStack;
+class HeapWalker;
+class HeapStatsCollector;
+class GCRootPaths;
+class SamplingProfiler;
+class CodeCoverage;
+class TraceRecorder;
+class OutputAggregator;
 
 enum class ProcessAttachedState
 {
@@ -71,6 +81,7 @@ protected:
     void SetLastStoppedThread(ICorDebugThread *pThread);
     void SetLastStoppedThreadId(ThreadId threadId);
     void InvalidateLastStoppedThreadId();
+    void InvalidateFrames();
 
     StartMethod m_startMethod;
     std::string m_execPath;
@@ -83,11 +94,21 @@ protected:
     std::shared_ptr<Threads> m_sharedThreads;
     std::shared_ptr<Modules> m_sharedModules;
     std::shared_ptr<EvalWaiter> m_sharedEvalWaiter;
+    std::shared_ptr<HandlePool> m_sharedHandlePool;
     std::shared_ptr<EvalHelpers> m_sharedEvalHelpers;
     std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     std::shared_ptr<Variables> m_sharedVariables;
+    std::shared_ptr<AsyncInfo> m_sharedAsyncInfo;
     std::unique_ptr<Steppers> m_uniqueSteppers;
+    std::unique_ptr<AsyncCallStack> m_uniqueAsyncCallStack;
+    std::unique_ptr<HeapWalker> m_uniqueHeapWalker;
+    std::unique_ptr<HeapStatsCollector> m_uniqueHeapStatsCollector;
+    std::unique_ptr<GCRootPaths> m_uniqueGCRootPaths;
+    std::mutex m_samplingProfilerMutex;
+    std::unique_ptr<SamplingProfiler> m_uniqueSamplingProfiler;
+    std::unique_ptr<CodeCoverage> m_uniqueCodeCoverage;
+    std::shared_ptr<TraceRecorder> m_sharedTraceRecorder;
     std::shared_ptr<Breakpoints> m_sharedBreakpoints;
     std::shared_ptr<CallbacksQueue> m_sharedCallbacksQueue;
     std::unique_ptr<ManagedCallback> m_uniqueManagedCallback;
@@ -102,6 +123,8 @@ protected:
     bool m_justMyCode;
     bool m_stepFiltering;
     bool m_hotReload;
+    bool m_asyncCallStack;
+    bool m_collapseExternalCode;
     bool m_interopDebugging;
 
     PVOID m_unregisterToken;
@@ -109,6 +132,8 @@ protected:
     std::string m_clrPath;
     dbgshim_t m_dbgshim;
 
+    // Note, must be declared before m_ioredirect, since IO redirection thread use it until m_ioredirect destruction.
+    std::unique_ptr<OutputAggregator> m_uniqueOutputAggregator;
     IORedirectHelper m_ioredirect;
 
     HRESULT CheckDebugProcess();
@@ -121,12 +146,14 @@ protected:
 
     HRESULT GetFrameLocation(ICorDebugFrame *pFrame, ThreadId threadId, FrameLevel level, StackFrame &stackFrame, bool hotReloadAwareCaller = false);
     HRESULT GetManagedStackTrace(ICorDebugThread *pThread, ThreadId threadId, FrameLevel startFrame, unsigned maxFrames,
-                                 std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller);
+                                 std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller,
+                                 const CancellationToken &token);
 #ifdef INTEROP_DEBUGGING
     HRESULT GetNativeStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames);
 #endif // INTEROP_DEBUGGING
 
     HRESULT FindEvalCapableThread(ToRelease<ICorDebugThread> &pThread);
+    void HeapWalkProgress(ProgressReason reason, unsigned percentage);
     HRESULT ApplyPdbDeltaAndLineUpdates(const std::string &dllFileName, const std::string &deltaPDB, const std::string &lineUpdates,
                                         std::string &updatedDLL, std::unordered_set<mdTypeDef> &updatedTypeTokens);
 };
@@ -159,6 +186,11 @@ public:
     void SetStepFiltering(bool enable) override;
     bool IsHotReload() const override { return m_hotReload; }
     HRESULT SetHotReload(bool enable) override;
+    bool IsAsyncCallStack() const override { return m_asyncCallStack; }
+    void SetAsyncCallStack(bool enable) override;
+    bool IsCollapseExternalCode() const override { return m_collapseExternalCode; }
+    void SetCollapseExternalCode(bool enable) override;
+    HRESULT SetCodeCoverage(const std::string &outputFile) override;
 #ifdef INTEROP_DEBUGGING
     void SetInteropDebugging(bool enable) override;
 #endif
@@ -182,16 +214,29 @@ public:
     HRESULT BreakpointActivate(int id, bool act) override;
     void EnumerateBreakpoints(std::function<bool (const IDebugger::BreakpointInfo&)>&& callback) override;
     HRESULT AllBreakpointsActivate(bool act) override;
-    HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) override;
+    HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames,
+                          bool hotReloadAwareCaller = false, const CancellationToken &token = CancellationToken()) override;
+    HRESULT GetAsyncTasks(std::vector<AsyncTaskGroup> &taskGroups) override;
+    HRESULT GetHeapStats(uint32_t baseSnapshotId, HeapStats &heapStats) override;
+    HRESULT GetGCRootPaths(uint32_t variablesReference, unsigned maxPaths, std::vector<GCRootPath> &paths) override;
+    HRESULT StartSampling(unsigned intervalMs) override;
+    HRESULT StopSampling(SamplingResult &result) override;
+    HRESULT StartTraceRecording(const std::string &outputFile) override;
+    HRESULT StopTraceRecording(TraceRecordingStats &stats) override;
+    HRESULT ReadTrace(const std::string &traceFile, uint32_t tracepointId, unsigned maxRecords, TraceSummary &summary) override;
+    void CancelHeapWalk() override;
+    void ResetHeapWalkCancel() override;
     HRESULT StepCommand(ThreadId threadId, StepType stepType) override;
     HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) override;
-    HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) override;
+    HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables,
+                         const CancellationToken &token = CancellationToken()) override;
     int GetNamedVariables(uint32_t variablesReference) override;
     HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) override;
+    HRESULT EvaluateBatch(FrameId frameId, int evalFlags, const std::vector<std::string> &expressions, std::vector<EvaluateBatchResult> &results) override;
     void CancelEvalRunning() override;
     HRESULT SetVariable(const std::string &name, const std::string &value, uint32_t ref, std::string &output) override;
     HRESULT SetExpression(FrameId frameId, const std::string &expression, int evalFlags, const std::string &value, std::string &output) override;
-    HRESULT GetExceptionInfo(ThreadId threadId, ExceptionInfo &exceptionInfo) override;
+    HRESULT GetExceptionInfo(ThreadId threadId, bool extendedDetails, ExceptionInfo &exceptionInfo) override;
     HRESULT GetSourceFile(const std::string &sourcePath, char** fileBuf, int* fileLen) override;
     void FreeUnmanaged(PVOID mem) override;
     HRESULT HotReloadApplyDeltas(const std::string &dllFileName, const std::string &deltaMD, const std::string &deltaIL,
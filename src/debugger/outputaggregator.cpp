@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/outputaggregator.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+    // How long producer could wait for pending data emit, before start drop new data.
+    const std::chrono::milliseconds BackpressureTimeout(100);
+}
+
+OutputAggregator::OutputAggregator(EmitCallback emitCallback, std::chrono::milliseconds window, size_t flushSize, size_t pendingLimit) :
+    m_emitCallback(std::move(emitCallback)),
+    m_window(window),
+    m_flushSize(flushSize),
+    m_pendingLimit(pendingLimit),
+    m_pendingSize(0),
+    m_stats{0, 0, 0},
+    m_notReportedDroppedBytes(0),
+    m_stop(false)
+{
+    m_workerThread = std::thread(&OutputAggregator::Worker, this);
+}
+
+OutputAggregator::~OutputAggregator()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workerCV.notify_one();
+    if (m_workerThread.joinable())
+        m_workerThread.join();
+}
+
+void OutputAggregator::Append(OutputCategory category, string_view text)
+{
+    if (text.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_pendingSize + text.size() > m_pendingLimit &&
+        !m_producerCV.wait_for(lock, BackpressureTimeout, [&]{ return m_stop || m_pendingSize + text.size() <= m_pendingLimit; }))
+    {
+        if (m_notReportedDroppedBytes == 0)
+            LOGW("Debuggee output dropped, client can't keep up");
+        m_stats.droppedBytes += text.size();
+        m_stats.droppedChunks++;
+        m_notReportedDroppedBytes += text.size();
+        return;
+    }
+
+    if (!m_pending.empty() && m_pending.back().category == category)
+        m_pending.back().text.append(text.data(), text.size());
+    else
+        m_pending.emplace_back(Chunk{category, std::string(text.data(), text.size())});
+
+    const bool notify = m_pendingSize < m_flushSize && m_pendingSize + text.size() >= m_flushSize;
+    m_pendingSize += text.size();
+    lock.unlock();
+
+    if (notify)
+        m_workerCV.notify_one();
+}
+
+// Caller must care about m_mutex, note, m_mutex is unlocked during emit.
+void OutputAggregator::EmitPending(std::unique_lock<std::mutex> &lock)
+{
+    std::vector<Chunk> chunks;
+    chunks.swap(m_pending);
+    m_stats.emittedBytes += m_pendingSize;
+    m_pendingSize = 0;
+    const uint64_t droppedBytes = m_notReportedDroppedBytes;
+    m_notReportedDroppedBytes = 0;
+    lock.unlock();
+
+    // Note, m_emitMutex is locked before m_mutex unlock by caller, so, chunks order between emitter threads can't change.
+    for (const auto &chunk : chunks)
+    {
+        m_emitCallback(chunk.category, chunk.text);
+    }
+    if (droppedBytes != 0)
+        m_emitCallback(OutputConsole, "Debugger: " + std::to_string(droppedBytes) + " bytes of debuggee output dropped, client can't keep up.\n");
+
+    m_producerCV.notify_all();
+    lock.lock();
+}
+
+void OutputAggregator::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_workerCV.wait(lock, [this]{ return m_stop || !m_pending.empty(); });
+        // Collect more data during window, in case data don't reach flush size.
+        m_workerCV.wait_for(lock, m_window, [this]{ return m_stop || m_pendingSize >= m_flushSize; });
+
+        const bool stop = m_stop;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> lockEmit(m_emitMutex);
+            lock.lock();
+            EmitPending(lock);
+        }
+
+        if (stop && m_pending.empty())
+            break;
+    }
+}
+
+void OutputAggregator::Flush()
+{
+    std::lock_guard<std::mutex> lockEmit(m_emitMutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    EmitPending(lock);
+}
+
+OutputAggregator::Stats OutputAggregator::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace netcoredbg
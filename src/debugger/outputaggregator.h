@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "interfaces/types.h"
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+using Utility::string_view;
+
+// Coalesce debuggee stdout/stderr chunks into bigger output events. Chunks are collected during short time window
+// (or until size threshold reached) and emitted by background thread, adjacent chunks of same category are merged,
+// so, stdout/stderr order is kept. In case client can't keep up and pending data reach limit, producer (IO redirection
+// thread, that also mean debuggee pipe write) is blocked for some time, after that new data is dropped and counted.
+class OutputAggregator
+{
+public:
+
+    typedef std::function<void(OutputCategory category, string_view text)> EmitCallback;
+
+    static const size_t DefaultFlushSize = 64 * 1024;
+    static const size_t DefaultPendingLimit = size_t(4) * 1024 * 1024;
+
+    OutputAggregator(EmitCallback emitCallback,
+                     std::chrono::milliseconds window = std::chrono::milliseconds(10),
+                     size_t flushSize = DefaultFlushSize,
+                     size_t pendingLimit = DefaultPendingLimit);
+    ~OutputAggregator();
+
+    void Append(OutputCategory category, string_view text);
+    // Emit all pending output right now (for example, before process exit event).
+    void Flush();
+
+    struct Stats
+    {
+        uint64_t emittedBytes;
+        uint64_t droppedBytes;
+        uint64_t droppedChunks;
+    };
+    Stats GetStats();
+
+private:
+
+    struct Chunk
+    {
+        OutputCategory category;
+        std::string text;
+    };
+
+    const EmitCallback m_emitCallback;
+    const std::chrono::milliseconds m_window;
+    const size_t m_flushSize;
+    const size_t m_pendingLimit;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workerCV; // new data or stop
+    std::condition_variable m_producerCV; // pending data emitted
+    std::vector<Chunk> m_pending;
+    size_t m_pendingSize;
+    Stats m_stats;
+    uint64_t m_notReportedDroppedBytes; // dropped since last emit, user notified at next emit
+    bool m_stop;
+
+    // Only one thread emit output at time, in order to keep chunks order.
+    std::mutex m_emitMutex;
+
+    std::thread m_workerThread;
+
+    void Worker();
+    void EmitPending(std::unique_lock<std::mutex> &lock);
+};
+
+} // namespace netcoredbg
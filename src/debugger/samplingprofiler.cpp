@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <algorithm>
+#include "debugger/samplingprofiler.h"
+#include "debugger/callbacksqueue.h"
+#include "debugger/frames.h"
+#include "metadata/typeprinter.h"
+#include "utils/logger.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+SamplingProfiler::SamplingProfiler(ICorDebugProcess *pProcess, std::shared_ptr<CallbacksQueue> &sharedCallbacksQueue,
+                                   Utility::RWLock &debugProcessRWLock, unsigned intervalMs) :
+    m_iCorProcess(pProcess),
+    m_sharedCallbacksQueue(sharedCallbacksQueue),
+    m_debugProcessRWLock(debugProcessRWLock),
+    m_interval(intervalMs),
+    m_stop(false)
+{
+    m_iCorProcess->AddRef();
+    m_samplingThread = std::thread(&SamplingProfiler::SamplingWorker, this);
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    StopSampling();
+}
+
+HRESULT SamplingProfiler::GetFunctionId(ICorDebugFrame *pFrame, uint32_t &id)
+{
+    HRESULT Status;
+    FunctionKey key;
+    ToRelease<ICorDebugFunction> iCorFunction;
+    ToRelease<ICorDebugModule> iCorModule;
+    IfFailRet(pFrame->GetFunctionToken(&key.methodDef));
+    IfFailRet(pFrame->GetFunction(&iCorFunction));
+    IfFailRet(iCorFunction->GetModule(&iCorModule));
+    IfFailRet(iCorModule->GetBaseAddress(&key.modAddress));
+
+    auto find = m_functionIds.find(key);
+    if (find != m_functionIds.end())
+    {
+        id = find->second;
+        return S_OK;
+    }
+
+    // Name is resolved at first sample with this function only.
+    std::string typeName;
+    std::string methodName;
+    std::string name;
+    if (FAILED(TypePrinter::GetTypeAndMethod(pFrame, typeName, methodName)))
+        name = "<unknown>";
+    else if (typeName.empty())
+        name = methodName;
+    else
+        name = typeName + "." + methodName;
+    // Folded stack format use ';' as frames separator.
+    std::replace(name.begin(), name.end(), ';', ',');
+
+    id = uint32_t(m_functionNames.size());
+    m_functionNames.emplace_back(std::move(name));
+    m_functionIds.emplace(key, id);
+    return S_OK;
+}
+
+// Called with stopped process and m_debugProcessRWLock reader lock held.
+void SamplingProfiler::TakeSample()
+{
+    ToRelease<ICorDebugThreadEnum> iCorThreadEnum;
+    if (FAILED(m_iCorProcess->EnumerateThreads(&iCorThreadEnum)))
+        return;
+
+    ULONG fetched = 0;
+    ToRelease<ICorDebugThread> iCorThread;
+    while (SUCCEEDED(iCorThreadEnum->Next(1, &iCorThread, &fetched)) && fetched == 1)
+    {
+        m_stack.clear();
+        WalkFrames(iCorThread, [&](FrameType frameType, std::uintptr_t, ICorDebugFrame *pFrame, NativeFrame *) -> HRESULT
+        {
+            uint32_t id;
+            if (frameType == FrameCLRManaged && SUCCEEDED(GetFunctionId(pFrame, id)))
+                m_stack.push_back(id);
+
+            return S_OK;
+        });
+        iCorThread.Free();
+
+        if (m_stack.empty())
+            continue;
+
+        // Frames are walked from leaf to root.
+        std::reverse(m_stack.begin(), m_stack.end());
+        m_stacks[m_stack]++;
+    }
+}
+
+void SamplingProfiler::SamplingWorker()
+{
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+    while (!m_stopCV.wait_for(lock, m_interval, [this]{ return m_stop; }))
+    {
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        HRESULT Status = S_FALSE;
+        {
+            // Same as other debugger's methods, that work with process, TakeSample() must hold reader lock.
+            // Note, try lock used, since process release (writer lock) could wait for sampling thread join,
+            // sample is skipped in case writer own or wait for lock.
+            std::unique_lock<Utility::RWLock::Reader> lockProcessRWLock(m_debugProcessRWLock.reader, std::try_to_lock);
+            if (lockProcessRWLock.owns_lock())
+                Status = m_sharedCallbacksQueue->Sample(m_iCorProcess, [this]() { TakeSample(); });
+        }
+        const uint64_t pauseUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+
+        if (FAILED(Status))
+        {
+            LOGW("Sampling stopped, process stop failed: %s", errormessage(Status));
+            break;
+        }
+        else if (Status == S_FALSE)
+        {
+            m_result.skippedSamples++;
+            continue;
+        }
+
+        m_result.samples++;
+        m_result.totalPauseUs += pauseUs;
+        m_result.maxPauseUs = std::max(m_result.maxPauseUs, pauseUs);
+    }
+}
+
+void SamplingProfiler::StopSampling()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stop = true;
+    }
+    m_stopCV.notify_one();
+    if (m_samplingThread.joinable())
+        m_samplingThread.join();
+}
+
+void SamplingProfiler::Stop(SamplingResult &result)
+{
+    StopSampling();
+
+    result = m_result;
+    result.stacks.reserve(m_stacks.size());
+    for (const auto &entry : m_stacks)
+    {
+        std::string frames;
+        for (uint32_t id : entry.first)
+        {
+            if (!frames.empty())
+                frames += ';';
+            frames += m_functionNames[id];
+        }
+        result.stacks.emplace_back(frames, entry.second);
+    }
+    std::sort(result.stacks.begin(), result.stacks.end(), [](const SampledStack &left, const SampledStack &right)
+    {
+        return left.count != right.count ? left.count > right.count : left.frames < right.frames;
+    });
+
+    LOGI("Sampling: %llu samples, %llu skipped, pause avg %llu us, max %llu us, %u functions",
+         (unsigned long long)result.samples, (unsigned long long)result.skippedSamples,
+         (unsigned long long)(result.samples ? result.totalPauseUs / result.samples : 0),
+         (unsigned long long)result.maxPauseUs, (unsigned)m_functionNames.size());
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/types.h"
+#include "utils/rwlock.h"
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+class CallbacksQueue;
+
+// Poor man's sampling profiler. Process is stopped by timer, managed stacks of all threads are collected and process is
+// continued. Functions are interned (stack is stored as vector of function IDs) and function name is resolved only once,
+// so, process pause for sample is about stack walk time only.
+class SamplingProfiler
+{
+public:
+
+    static const unsigned DefaultIntervalMs = 10;
+
+    // Start sampling thread. Note, debugProcessRWLock reader lock is held during each sample.
+    SamplingProfiler(ICorDebugProcess *pProcess, std::shared_ptr<CallbacksQueue> &sharedCallbacksQueue,
+                     Utility::RWLock &debugProcessRWLock, unsigned intervalMs);
+    ~SamplingProfiler();
+
+    // Stop sampling thread and provide aggregated stacks.
+    void Stop(SamplingResult &result);
+
+private:
+
+    struct FunctionKey
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodDef;
+
+        bool operator==(const FunctionKey &other) const
+        {
+            return modAddress == other.modAddress && methodDef == other.methodDef;
+        }
+    };
+
+    struct FunctionKeyHash
+    {
+        size_t operator()(const FunctionKey &key) const
+        {
+            return std::hash<CORDB_ADDRESS>()(key.modAddress) ^ (std::hash<mdMethodDef>()(key.methodDef) << 1);
+        }
+    };
+
+    struct StackHash
+    {
+        size_t operator()(const std::vector<uint32_t> &stack) const
+        {
+            size_t hash = stack.size();
+            for (uint32_t id : stack)
+            {
+                hash ^= std::hash<uint32_t>()(id) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    ToRelease<ICorDebugProcess> m_iCorProcess;
+    std::shared_ptr<CallbacksQueue> m_sharedCallbacksQueue;
+    Utility::RWLock &m_debugProcessRWLock;
+    const std::chrono::milliseconds m_interval;
+
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCV;
+    bool m_stop;
+
+    // Accessed by sampling thread only (until thread joined).
+    std::unordered_map<FunctionKey, uint32_t, FunctionKeyHash> m_functionIds;
+    std::vector<std::string> m_functionNames; // function ID is index in this vector
+    std::unordered_map<std::vector<uint32_t>, uint64_t, StackHash> m_stacks; // frames from root to leaf
+    std::vector<uint32_t> m_stack;
+    SamplingResult m_result; // counters only, stacks are filled at stop
+
+    std::thread m_samplingThread;
+
+    void SamplingWorker();
+    void StopSampling();
+    void TakeSample();
+    HRESULT GetFunctionId(ICorDebugFrame *pFrame, uint32_t &id);
+};
+
+} // namespace netcoredbg
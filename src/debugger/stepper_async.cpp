@@ -259,7 +259,7 @@ HRESULT AsyncStepper::SetupStep(ICorDebugThread *pThread, IDebugger::StepType st
     ULONG32 methodVersion;
     IfFailRet(pCode->GetVersionNumber(&methodVersion));
 
-    if (!m_uniqueAsyncInfo->IsMethodHaveAwait(modAddress, methodToken, methodVersion))
+    if (!m_sharedAsyncInfo->IsMethodHaveAwait(modAddress, methodToken, methodVersion))
         return S_FALSE; // setup simple stepper
 
     ToRelease<ICorDebugILFrame> pILFrame;
@@ -276,7 +276,7 @@ HRESULT AsyncStepper::SetupStep(ICorDebugThread *pThread, IDebugger::StepType st
     // switch to step-out, so whole NotifyDebuggerOfWaitCompletion magic happens.
     ULONG32 lastIlOffset;
     if (stepType != IDebugger::StepType::STEP_OUT &&
-        m_uniqueAsyncInfo->FindLastIlOffsetAwaitInfo(modAddress, methodToken, methodVersion, lastIlOffset) &&
+        m_sharedAsyncInfo->FindLastIlOffsetAwaitInfo(modAddress, methodToken, methodVersion, lastIlOffset) &&
         ipOffset >= lastIlOffset)
     {
         stepType = IDebugger::StepType::STEP_OUT;
@@ -300,8 +300,8 @@ HRESULT AsyncStepper::SetupStep(ICorDebugThread *pThread, IDebugger::StepType st
         return S_OK;
     }
 
-    AsyncInfo::AwaitInfo *awaitInfo = nullptr;
-    if (m_uniqueAsyncInfo->FindNextAwaitInfo(modAddress, methodToken, methodVersion, ipOffset, &awaitInfo))
+    AsyncInfo::AwaitInfo awaitInfo;
+    if (m_sharedAsyncInfo->FindNextAwaitInfo(modAddress, methodToken, methodVersion, ipOffset, awaitInfo))
     {
         // We have step inside async function with await, setup breakpoint at closest await's yield_offset.
         // Two possible cases here:
@@ -313,13 +313,13 @@ HRESULT AsyncStepper::SetupStep(ICorDebugThread *pThread, IDebugger::StepType st
         m_asyncStep.reset(new asyncStep_t());
         m_asyncStep->m_threadId = getThreadId(pThread);
         m_asyncStep->m_initialStepType = stepType;
-        m_asyncStep->m_resume_offset = awaitInfo->resume_offset;
+        m_asyncStep->m_resume_offset = awaitInfo.resume_offset;
         m_asyncStep->m_stepStatus = asyncStepStatus::yield_offset_breakpoint;
 
         m_asyncStep->m_Breakpoint.reset(new asyncBreakpoint_t());
         m_asyncStep->m_Breakpoint->modAddress = modAddress;
         m_asyncStep->m_Breakpoint->methodToken = methodToken;
-        m_asyncStep->m_Breakpoint->ilOffset = awaitInfo->yield_offset;
+        m_asyncStep->m_Breakpoint->ilOffset = awaitInfo.yield_offset;
 
         ToRelease<ICorDebugFunctionBreakpoint> iCorFuncBreakpoint;
         IfFailRet(pCode->CreateBreakpoint(m_asyncStep->m_Breakpoint->ilOffset, &iCorFuncBreakpoint));
@@ -353,6 +353,15 @@ HRESULT AsyncStepper::DisableAllSteppers()
     return S_OK;
 }
 
+HRESULT AsyncStepper::UpdateOnHotReload(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    m_sharedAsyncInfo->InvalidateMethods(modAddress, methodTokens);
+    return S_OK;
+}
+
 // Setup breakpoint into System.Threading.Tasks.Task.NotifyDebuggerOfWaitCompletion() method, that will be
 // called at wait completion if notification was enabled by SetNotificationForWaitCompletion().
 // Note, NotifyDebuggerOfWaitCompletion() will be called only once, since notification flag
@@ -23,9 +23,9 @@ class AsyncStepper
 {
 public:
 
-    AsyncStepper(std::shared_ptr<SimpleStepper> simpleStepper, std::shared_ptr<Modules> &sharedModules, std::shared_ptr<EvalHelpers> &sharedEvalHelpers) :
+    AsyncStepper(std::shared_ptr<SimpleStepper> simpleStepper, std::shared_ptr<AsyncInfo> &sharedAsyncInfo, std::shared_ptr<EvalHelpers> &sharedEvalHelpers) :
         m_simpleStepper(simpleStepper),
-        m_uniqueAsyncInfo(new AsyncInfo(sharedModules)),
+        m_sharedAsyncInfo(sharedAsyncInfo),
         m_sharedEvalHelpers(sharedEvalHelpers),
         m_asyncStep(nullptr),
         m_asyncStepNotifyDebuggerOfWaitCompletion(nullptr)
@@ -44,11 +44,12 @@ public:
     HRESULT ManagedCallbackStepComplete();
 
     HRESULT DisableAllSteppers();
+    HRESULT UpdateOnHotReload(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens);
 
 private:
 
     std::shared_ptr<SimpleStepper> m_simpleStepper;
-    std::unique_ptr<AsyncInfo> m_uniqueAsyncInfo;
+    std::shared_ptr<AsyncInfo> m_sharedAsyncInfo;
     std::shared_ptr<EvalHelpers> m_sharedEvalHelpers;
 
     enum class asyncStepStatus
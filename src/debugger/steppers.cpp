@@ -275,6 +275,11 @@ HRESULT Steppers::DisableAllSimpleSteppers(ICorDebugProcess *pProcess)
     return m_simpleStepper->DisableAllSteppers(pProcess);
 }
 
+HRESULT Steppers::UpdateOnHotReload(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens)
+{
+    return m_asyncStepper->UpdateOnHotReload(pModule, methodTokens);
+}
+
 void Steppers::SetJustMyCode(bool enable)
 {
     m_justMyCode = enable;
@@ -7,6 +7,7 @@
 #include "cordebug.h"
 
 #include <memory>
+#include <unordered_set>
 #include "interfaces/idebugger.h"
 
 namespace netcoredbg
@@ -16,14 +17,15 @@ class SimpleStepper;
 class AsyncStepper;
 class Modules;
 class EvalHelpers;
+class AsyncInfo;
 
 class Steppers
 {
 public:
 
-    Steppers(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<EvalHelpers> &sharedEvalHelpers) :
+    Steppers(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<AsyncInfo> &sharedAsyncInfo, std::shared_ptr<EvalHelpers> &sharedEvalHelpers) :
         m_simpleStepper(new SimpleStepper(sharedModules)),
-        m_asyncStepper(new AsyncStepper(m_simpleStepper, sharedModules, sharedEvalHelpers)),
+        m_asyncStepper(new AsyncStepper(m_simpleStepper, sharedAsyncInfo, sharedEvalHelpers)),
         m_sharedModules(sharedModules),
         m_initialStepType(IDebugger::StepType::STEP_OVER),
         m_justMyCode(true),
@@ -46,6 +48,7 @@ public:
     HRESULT DisableAllSteppers(ICorDebugProcess *pProcess);
     HRESULT DisableAllSteppers(ICorDebugAppDomain *pAppDomain);
     HRESULT DisableAllSimpleSteppers(ICorDebugProcess *pProcess);
+    HRESULT UpdateOnHotReload(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens);
 
     void SetJustMyCode(bool enable);
     void SetStepFiltering(bool enable);
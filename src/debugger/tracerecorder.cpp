@@ -0,0 +1,251 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include "debugger/tracerecorder.h"
+#include "utils/logger.h"
+#include "utils/tracefile.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // Writer thread flush buffer at least with this period, or earlier in case buffer have enough data.
+    const std::chrono::milliseconds FlushPeriod(100);
+    const size_t FlushSize = 256 * 1024;
+
+} // unnamed namespace
+
+TraceRecorder::~TraceRecorder()
+{
+    StopWriter();
+}
+
+HRESULT TraceRecorder::Start(const std::string &outputFile)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_recording)
+    {
+        LOGE("Trace recording already started");
+        return E_FAIL;
+    }
+
+    m_output.open(outputFile, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_output.is_open())
+    {
+        LOGE("Can't open trace file '%s'", outputFile.c_str());
+        return E_FAIL;
+    }
+
+    m_outputFile = outputFile;
+    m_startTime = Clock::now();
+    const uint64_t startTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    m_buffer.clear();
+    TraceFile::AppendHeader(m_buffer, startTimeUs);
+
+    m_definedTracepoints.clear();
+    m_records = 0;
+    m_lostRecords = 0;
+    m_bytes = 0;
+    m_stop = false;
+    m_recording = true;
+    m_writerThread = std::thread(&TraceRecorder::WriterWorker, this);
+
+    return S_OK;
+}
+
+bool TraceRecorder::IsRecording()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_recording;
+}
+
+void TraceRecorder::Record(uint32_t tracepointId, const std::string &location, const std::vector<std::string> &expressions,
+                           DWORD threadId, Clock::time_point hitTime, const std::vector<std::string> &values)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (!m_recording)
+        return;
+
+    // Tracepoint could be changed by setBreakpoints with same id, in this case new definition must be written.
+    auto findDefinition = m_definedTracepoints.find(tracepointId);
+    const bool needDefinition = findDefinition == m_definedTracepoints.end() ||
+                                findDefinition->second.location != location ||
+                                findDefinition->second.expressions != expressions;
+    size_t recordSize = TraceFile::HitSize(values);
+    if (needDefinition)
+        recordSize += TraceFile::DefinitionSize(location, expressions);
+
+    if (m_buffer.size() + recordSize > m_bufferLimit)
+    {
+        m_lostRecords++;
+        return;
+    }
+
+    if (needDefinition)
+    {
+        TraceFile::AppendDefinition(m_buffer, tracepointId, location, expressions);
+        TracepointDefinition &definition = m_definedTracepoints[tracepointId];
+        definition.location = location;
+        definition.expressions = expressions;
+    }
+
+    const uint64_t timeUs = hitTime > m_startTime ? std::chrono::duration_cast<std::chrono::microseconds>(hitTime - m_startTime).count() : 0;
+    TraceFile::AppendHit(m_buffer, tracepointId, timeUs, uint32_t(threadId), values);
+    m_records++;
+
+    if (m_buffer.size() >= FlushSize)
+    {
+        lock.unlock();
+        m_writerCV.notify_one();
+    }
+}
+
+void TraceRecorder::WriterWorker()
+{
+    std::vector<char> writeBuffer;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_writerCV.wait_for(lock, FlushPeriod, [this]{ return m_stop || m_buffer.size() >= FlushSize; });
+
+        // Swap buffers, so, tracepoints hits are not blocked by file write.
+        writeBuffer.swap(m_buffer);
+        m_buffer.clear();
+        const bool stop = m_stop;
+        lock.unlock();
+
+        if (!writeBuffer.empty())
+        {
+            if (!m_output.write(writeBuffer.data(), writeBuffer.size()))
+                LOGE("Trace file write failed");
+        }
+
+        lock.lock();
+        m_bytes += writeBuffer.size();
+        writeBuffer.clear();
+
+        if (stop)
+            break;
+    }
+}
+
+void TraceRecorder::StopWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_writerCV.notify_one();
+    if (m_writerThread.joinable())
+        m_writerThread.join();
+}
+
+HRESULT TraceRecorder::Stop(TraceRecordingStats &stats)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_recording)
+        {
+            LOGE("Trace recording not started");
+            return E_FAIL;
+        }
+        m_recording = false; // new hits are not recorded, but buffer still have data for writer
+    }
+
+    StopWriter();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_output.close();
+    stats.records = m_records;
+    stats.lostRecords = m_lostRecords;
+    stats.bytes = m_bytes;
+    stats.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_startTime).count();
+
+    LOGI("Trace recording to '%s' stopped: %llu records, %llu lost, %llu bytes, %llu us",
+         m_outputFile.c_str(), (unsigned long long)stats.records, (unsigned long long)stats.lostRecords,
+         (unsigned long long)stats.bytes, (unsigned long long)stats.durationUs);
+
+    return m_output.fail() ? E_FAIL : S_OK;
+}
+
+HRESULT TraceRecorder::ReadTrace(const std::string &traceFile, uint32_t tracepointId, unsigned maxRecords, TraceSummary &summary)
+{
+    std::ifstream input(traceFile, std::ios::in | std::ios::binary);
+    if (!input.is_open())
+    {
+        LOGE("Can't open trace file '%s'", traceFile.c_str());
+        return E_FAIL;
+    }
+
+    TraceFile::Reader reader(input);
+    if (!reader.ReadHeader(summary.startTimeUs))
+    {
+        LOGE("Wrong trace file format '%s'", traceFile.c_str());
+        return E_FAIL;
+    }
+
+    summary.hits = 0;
+    summary.tracepoints.clear();
+    summary.records.clear();
+
+    std::map<uint32_t, TracepointSummary> tracepoints; // ordered by id
+    std::map<uint32_t, std::set<uint32_t>> tracepointsThreads;
+    TraceFile::Record record;
+    TraceFile::Reader::Status status;
+
+    // Note, incomplete record at file end (debugger crash during recording) is ignored.
+    while ((status = reader.ReadRecord(record)) == TraceFile::Reader::Ok)
+    {
+        TracepointSummary &tracepoint = tracepoints[record.id];
+        tracepoint.id = record.id;
+
+        if (record.type == TraceFile::DefinitionRecord)
+        {
+            // Tracepoint was changed during recording, use last definition, but keep already counted hits.
+            tracepoint.location = record.location;
+            tracepoint.expressions = record.strings;
+            continue;
+        }
+
+        if (tracepoint.hits == 0)
+            tracepoint.firstTimeUs = record.timeUs;
+        tracepoint.lastTimeUs = std::max(tracepoint.lastTimeUs, record.timeUs);
+        tracepoint.hits++;
+        tracepointsThreads[record.id].insert(record.threadId);
+        summary.hits++;
+
+        if ((tracepointId == 0 || tracepointId == record.id) && summary.records.size() < maxRecords)
+        {
+            summary.records.emplace_back();
+            TraceRecord &traceRecord = summary.records.back();
+            traceRecord.tracepointId = record.id;
+            traceRecord.timeUs = record.timeUs;
+            traceRecord.threadId = int(record.threadId);
+            traceRecord.values = record.strings;
+        }
+    }
+
+    if (status == TraceFile::Reader::UnknownRecord)
+        LOGW("Unknown trace record type, trace file '%s' read stopped", traceFile.c_str());
+
+    summary.tracepoints.reserve(tracepoints.size());
+    for (auto &entry : tracepoints)
+    {
+        entry.second.threads = unsigned(tracepointsThreads[entry.first].size());
+        summary.tracepoints.emplace_back(std::move(entry.second));
+    }
+
+    return S_OK;
+}
+
+} // namespace netcoredbg
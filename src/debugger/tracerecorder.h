@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+// Record tracepoints hits into compact binary trace file. Records are serialized into memory buffer at hit (debuggee
+// continued right after this), buffer is written into file by background writer thread. In case writer can't keep up
+// with hits rate and buffer size limit reached, records are dropped and counted as lost.
+// File format described in "utils/tracefile.h".
+class TraceRecorder
+{
+public:
+
+    typedef std::chrono::steady_clock Clock;
+
+    static const size_t DefaultBufferLimit = size_t(16) * 1024 * 1024;
+
+    TraceRecorder(size_t bufferLimit = DefaultBufferLimit) :
+        m_bufferLimit(bufferLimit),
+        m_recording(false),
+        m_stop(false),
+        m_records(0),
+        m_lostRecords(0),
+        m_bytes(0)
+    {}
+    ~TraceRecorder();
+
+    HRESULT Start(const std::string &outputFile);
+    HRESULT Stop(TraceRecordingStats &stats);
+    bool IsRecording();
+    void Record(uint32_t tracepointId, const std::string &location, const std::vector<std::string> &expressions,
+                DWORD threadId, Clock::time_point hitTime, const std::vector<std::string> &values);
+
+    // Offline trace file reader, provide per tracepoint summary and first maxRecords hits of tracepointId (0 - all tracepoints).
+    static HRESULT ReadTrace(const std::string &traceFile, uint32_t tracepointId, unsigned maxRecords, TraceSummary &summary);
+
+private:
+
+    const size_t m_bufferLimit;
+
+    std::mutex m_mutex;
+    std::condition_variable m_writerCV;
+    bool m_recording;
+    bool m_stop;
+    std::string m_outputFile;
+    std::ofstream m_output; // accessed by writer thread only, while recording
+    std::vector<char> m_buffer; // serialized records, not written into file yet
+    // Last written definition for each tracepoint, tracepoint could be changed during recording (same id).
+    struct TracepointDefinition
+    {
+        std::string location;
+        std::vector<std::string> expressions;
+    };
+    std::unordered_map<uint32_t, TracepointDefinition> m_definedTracepoints;
+    Clock::time_point m_startTime;
+    uint64_t m_records;
+    uint64_t m_lostRecords;
+    uint64_t m_bytes;
+
+    std::thread m_writerThread;
+
+    void WriterWorker();
+    void StopWriter();
+};
+
+} // namespace netcoredbg
@@ -92,7 +92,8 @@ static HRESULT FillValueAndType(VariableMember &member, Variable &var)
 
 static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *pInputValue, ICorDebugThread *pThread,
                                         FrameLevel frameLevel, std::vector<VariableMember> &members, bool fetchOnlyStatic,
-                                        bool &hasStaticMembers, int childStart, int childEnd, int evalFlags)
+                                        bool &hasStaticMembers, int childStart, int childEnd, int evalFlags,
+                                        const CancellationToken &token)
 {
     hasStaticMembers = false;
     HRESULT Status;
@@ -109,6 +110,9 @@ static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *p
         Evaluator::GetValueCallback getValue,
         Evaluator::SetterData*)
     {
+        if (token.IsCanceled())
+            return COR_E_OPERATIONCANCELED;
+
         if (is_static)
             hasStaticMembers = true;
 
@@ -155,7 +159,8 @@ HRESULT Variables::GetVariables(
     VariablesFilter filter,
     int start,
     int count,
-    std::vector<Variable> &variables)
+    std::vector<Variable> &variables,
+    const CancellationToken &token)
 {
     std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
@@ -178,16 +183,17 @@ HRESULT Variables::GetVariables(
 
     if (ref.IsScope())
     {
-        IfFailRet(GetStackVariables(ref.frameId, pThread, start, count, variables));
+        IfFailRet(GetStackVariables(ref.frameId, pThread, start, count, variables, token));
     }
     else
     {
-        IfFailRet(GetChildren(ref, pThread, start, count, variables));
+        IfFailRet(GetChildren(ref, pThread, start, count, variables, token));
     }
     return S_OK;
 }
 
-HRESULT Variables::AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind)
+HRESULT Variables::AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind,
+                                        HandlePool::HandleId pooledHandleId)
 {
     std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
@@ -201,13 +207,69 @@ HRESULT Variables::AddVariableReference(Variable &variable, FrameId frameId, ICo
 
     variable.namedVariables = numChild;
     variable.variablesReference = (uint32_t)m_references.size() + 1;
-    pValue->AddRef();
-    VariableReference variableReference(variable, frameId, pValue, valueKind);
+    // Handles (eval results, exception objects) are owned by handle pool, in order to limit GC handles number.
+    HandlePool::HandleId handleId = pooledHandleId;
+    if (handleId != HandlePool::InvalidHandleId ||
+        (HandlePool::IsHandle(pValue) && SUCCEEDED(m_sharedHandlePool->Add(pValue, HandlePool::Lifetime::Break, handleId))))
+        pValue = nullptr;
+    else
+        pValue->AddRef();
+    VariableReference variableReference(variable, frameId, pValue, handleId, valueKind);
     m_references.emplace(std::make_pair(variable.variablesReference, std::move(variableReference)));
 
     return S_OK;
 }
 
+HRESULT Variables::GetReferenceValue(VariableReference &ref, ICorDebugValue **ppValue)
+{
+    if (ref.handleId == HandlePool::InvalidHandleId)
+    {
+        if (ref.iCorValue)
+            ref.iCorValue->AddRef();
+        *ppValue = ref.iCorValue.GetPtr();
+        return S_OK;
+    }
+
+    HRESULT Status;
+    IfFailRet(m_sharedHandlePool->Get(ref.handleId, ppValue));
+    if (Status == S_FALSE)
+    {
+        LOGW("Value for variables reference %u was already released", ref.variablesReference);
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+HRESULT Variables::GetObjectAddress(uint32_t variablesReference, CORDB_ADDRESS &address)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+
+    auto it = m_references.find(variablesReference);
+    if (it == m_references.end() || it->second.IsScope())
+        return E_INVALIDARG;
+
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorValue;
+    IfFailRet(GetReferenceValue(it->second, &iCorValue));
+    if (iCorValue == nullptr)
+        return E_FAIL;
+
+    ToRelease<ICorDebugReferenceValue> iCorRefValue;
+    if (FAILED(iCorValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorRefValue)))
+    {
+        // Note, value type on stack have address too, but this is not heap object address.
+        return iCorValue->GetAddress(&address);
+    }
+
+    BOOL isNull = FALSE;
+    IfFailRet(iCorRefValue->IsNull(&isNull));
+    if (isNull)
+        return E_INVALIDARG;
+
+    return iCorRefValue->GetValue(&address);
+}
+
 HRESULT Variables::GetExceptionVariable(FrameId frameId, ICorDebugThread *pThread, Variable &var)
 {
     ToRelease<ICorDebugValue> pExceptionValue;
@@ -231,7 +293,8 @@ HRESULT Variables::GetStackVariables(
     ICorDebugThread *pThread,
     int start,
     int count,
-    std::vector<Variable> &variables)
+    std::vector<Variable> &variables,
+    const CancellationToken &token)
 {
     HRESULT Status;
     int currentIndex = -1;
@@ -245,6 +308,9 @@ HRESULT Variables::GetStackVariables(
     if (FAILED(Status = m_sharedEvaluator->WalkStackVars(pThread, frameId.getLevel(),
         [&](const std::string &name, Evaluator::GetValueCallback getValue) -> HRESULT
     {
+        if (token.IsCanceled())
+            return COR_E_OPERATIONCANCELED;
+
         ++currentIndex;
 
         if (currentIndex < start)
@@ -329,26 +395,32 @@ HRESULT Variables::GetChildren(
     ICorDebugThread *pThread,
     int start,
     int count,
-    std::vector<Variable> &variables)
+    std::vector<Variable> &variables,
+    const CancellationToken &token)
 {
     if (ref.IsScope())
         return E_INVALIDARG;
 
-    if (!ref.iCorValue)
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorValue;
+    IfFailRet(GetReferenceValue(ref, &iCorValue));
+    if (!iCorValue)
         return S_OK;
 
-    HRESULT Status;
     std::vector<VariableMember> members;
     bool hasStaticMembers = false;
 
-    IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), ref.iCorValue, pThread, ref.frameId.getLevel(),
+    IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), iCorValue, pThread, ref.frameId.getLevel(),
                                        members, ref.valueKind == ValueIsClass, hasStaticMembers, start,
-                                       count == 0 ? INT_MAX : start + count, ref.evalFlags));
+                                       count == 0 ? INT_MAX : start + count, ref.evalFlags, token));
 
     FixupInheritedFieldNames(members);
 
     for (auto &it : members)
     {
+        if (token.IsCanceled())
+            return COR_E_OPERATIONCANCELED;
+
         Variable var(ref.evalFlags);
         var.name = it.name;
         bool isIndex = !it.name.empty() && it.name.at(0) == '[';
@@ -365,7 +437,7 @@ HRESULT Variables::GetChildren(
         if (staticsInRange)
         {
             ToRelease<ICorDebugValue2> pValue2;
-            IfFailRet(ref.iCorValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
+            IfFailRet(iCorValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
             ToRelease<ICorDebugType> pType;
             IfFailRet(pValue2->GetExactType(&pType));
             // Note, this call could return S_FALSE without ICorDebugValue creation in case type don't have static members.
@@ -373,9 +445,10 @@ HRESULT Variables::GetChildren(
 
             Variable var(ref.evalFlags);
             var.name = "Static members";
-            IfFailRet(TypePrinter::GetTypeOfValue(ref.iCorValue, var.evaluateName)); // do not expose type for this fake variable
+            IfFailRet(TypePrinter::GetTypeOfValue(iCorValue, var.evaluateName)); // do not expose type for this fake variable
 
-            IfFailRet(AddVariableReference(var, ref.frameId, ref.iCorValue, ValueIsClass));
+            // Same value as parent reference have, reuse its handle.
+            IfFailRet(AddVariableReference(var, ref.frameId, iCorValue, ValueIsClass, ref.handleId));
             variables.push_back(var);
         }
     }
@@ -409,6 +482,64 @@ HRESULT Variables::Evaluate(
     return AddVariableReference(variable, frameId, pResultValue, ValueIsVariable);
 }
 
+// Evaluate all expressions for same frame in one call. Thread object resolved only once, frame, scope (visible locals)
+// and method class data are shared between expressions by caches, each expression have its own result status and
+// output, so, one failed expression don't affect others in batch.
+HRESULT Variables::EvaluateBatch(
+    ICorDebugProcess *pProcess,
+    FrameId frameId,
+    int evalFlags,
+    const std::vector<std::string> &expressions,
+    std::vector<IDebugger::EvaluateBatchResult> &results)
+{
+    ThreadId threadId = frameId.getThread();
+    if (!threadId)
+        return E_FAIL;
+
+    HRESULT Status;
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(int(threadId), &pThread));
+
+    FramesCacheScope framesCache;
+    Evaluator::BatchCacheScope evaluatorCache;
+
+    FrameLevel frameLevel = frameId.getLevel();
+    results.clear();
+    results.reserve(expressions.size());
+
+    bool canceled = false;
+    for (const auto &expression : expressions)
+    {
+        results.emplace_back(evalFlags);
+        IDebugger::EvaluateBatchResult &result = results.back();
+
+        // Note, in case evaluation was canceled, all rest expressions in batch should be canceled too.
+        if (canceled)
+        {
+            result.status = COR_E_OPERATIONCANCELED;
+            continue;
+        }
+
+        ToRelease<ICorDebugValue> pResultValue;
+        Variable &variable = result.variable;
+        if (FAILED(result.status = m_sharedEvalStackMachine->EvaluateExpression(pThread, frameLevel, variable.evalFlags, expression,
+                                                                                &pResultValue, result.output, &variable.editable)))
+        {
+            canceled = result.status == COR_E_OPERATIONCANCELED;
+            continue;
+        }
+
+        variable.evaluateName = expression;
+        if (FAILED(result.status = TypePrinter::GetTypeOfValue(pResultValue, variable.type)) ||
+            FAILED(result.status = PrintValue(pResultValue, variable.value)))
+            continue;
+
+        result.status = AddVariableReference(variable, frameId, pResultValue, ValueIsVariable);
+    }
+
+    return S_OK;
+}
+
 HRESULT Variables::SetVariable(
     ICorDebugProcess *pProcess,
     const std::string &name,
@@ -485,13 +616,15 @@ HRESULT Variables::SetChild(
     if (ref.IsScope())
         return E_INVALIDARG;
 
-    if (!ref.iCorValue)
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorRefValue;
+    IfFailRet(GetReferenceValue(ref, &iCorRefValue));
+    if (!iCorRefValue)
         return S_OK;
 
-    HRESULT Status;
     bool found = false;
 
-    if (FAILED(Status = m_sharedEvaluator->WalkMembers(ref.iCorValue, pThread, ref.frameId.getLevel(), true, [&](
+    if (FAILED(Status = m_sharedEvaluator->WalkMembers(iCorRefValue, pThread, ref.frameId.getLevel(), true, [&](
         ICorDebugType*,
         bool is_static,
         const std::string &varName,
@@ -9,6 +9,8 @@
 #include <mutex>
 #include <unordered_map>
 #include "interfaces/types.h"
+#include "interfaces/idebugger.h"
+#include "debugger/handlepool.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -25,10 +27,12 @@ public:
 
     Variables(std::shared_ptr<EvalHelpers> &sharedEvalHelpers,
               std::shared_ptr<Evaluator> &sharedEvaluator,
-              std::shared_ptr<EvalStackMachine> &sharedEvalStackMachine) :
+              std::shared_ptr<EvalStackMachine> &sharedEvalStackMachine,
+              std::shared_ptr<HandlePool> &sharedHandlePool) :
         m_sharedEvalHelpers(sharedEvalHelpers),
         m_sharedEvaluator(sharedEvaluator),
-        m_sharedEvalStackMachine(sharedEvalStackMachine)
+        m_sharedEvalStackMachine(sharedEvalStackMachine),
+        m_sharedHandlePool(sharedHandlePool)
     {}
 
     int GetNamedVariables(uint32_t variablesReference);
@@ -39,7 +43,8 @@ public:
         VariablesFilter filter,
         int start,
         int count,
-        std::vector<Variable> &variables);
+        std::vector<Variable> &variables,
+        const CancellationToken &token = CancellationToken());
 
     HRESULT SetVariable(
         ICorDebugProcess *pProcess,
@@ -68,11 +73,21 @@ public:
         Variable &variable,
         std::string &output);
 
+    HRESULT EvaluateBatch(
+        ICorDebugProcess *pProcess,
+        FrameId frameId,
+        int evalFlags,
+        const std::vector<std::string> &expressions,
+        std::vector<IDebugger::EvaluateBatchResult> &results);
+
     HRESULT GetExceptionVariable(
         FrameId frameId,
         ICorDebugThread *pThread,
         Variable &variable);
 
+    // Get address of heap object for variable with children (class or boxed value).
+    HRESULT GetObjectAddress(uint32_t variablesReference, CORDB_ADDRESS &address);
+
     void Clear()
     {
         m_referencesMutex.lock();
@@ -100,9 +115,10 @@ private:
 
         ValueKind valueKind;
         ToRelease<ICorDebugValue> iCorValue;
+        HandlePool::HandleId handleId; // in case value is handle, it owned by handle pool and iCorValue is null
         FrameId frameId;
 
-        VariableReference(const Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind) :
+        VariableReference(const Variable &variable, FrameId frameId, ICorDebugValue *pValue, HandlePool::HandleId handleId, ValueKind valueKind) :
             variablesReference(variable.variablesReference),
             namedVariables(variable.namedVariables),
             indexedVariables(variable.indexedVariables),
@@ -110,6 +126,7 @@ private:
             evaluateName(variable.evaluateName),
             valueKind(valueKind),
             iCorValue(pValue),
+            handleId(handleId),
             frameId(frameId)
         {}
 
@@ -120,6 +137,7 @@ private:
             evalFlags(0), // unused in this case, not involved into GetScopes routine
             valueKind(ValueIsScope),
             iCorValue(nullptr),
+            handleId(HandlePool::InvalidHandleId),
             frameId(frameId)
         {}
 
@@ -132,25 +150,31 @@ private:
     std::shared_ptr<EvalHelpers> m_sharedEvalHelpers;
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
+    std::shared_ptr<HandlePool> m_sharedHandlePool;
 
     std::recursive_mutex m_referencesMutex;
     std::unordered_map<uint32_t, VariableReference> m_references;
 
-    HRESULT AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind);
+    // In case value is already owned by handle pool, `pooledHandleId` must be provided (handle is not added twice).
+    HRESULT AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind,
+                                 HandlePool::HandleId pooledHandleId = HandlePool::InvalidHandleId);
+    HRESULT GetReferenceValue(VariableReference &ref, ICorDebugValue **ppValue);
 
     HRESULT GetStackVariables(
         FrameId frameId,
         ICorDebugThread *pThread,
         int start,
         int count,
-        std::vector<Variable> &variables);
+        std::vector<Variable> &variables,
+        const CancellationToken &token);
 
     HRESULT GetChildren(
         VariableReference &ref,
         ICorDebugThread *pThread,
         int start,
         int count,
-        std::vector<Variable> &variables);
+        std::vector<Variable> &variables,
+        const CancellationToken &token);
 
     HRESULT SetStackVariable(
         VariableReference &ref,
@@ -41,24 +41,31 @@ pid_t waitpid_t::operator() (pid_t pid, int *status, int options)
 void waitpid_t::SetupTrackingPID(pid_t PID)
 {
     std::lock_guard<std::recursive_mutex> mutex_guard(interlock);
-    trackPID = PID;
-    exitCode = 0; // same behaviour as CoreCLR have, by default exit code is 0
+    trackPIDs[PID] = 0; // same behaviour as CoreCLR have, by default exit code is 0
 }
 
-int waitpid_t::GetExitCode()
+void waitpid_t::StopTrackingPID(pid_t PID)
 {
     std::lock_guard<std::recursive_mutex> mutex_guard(interlock);
-    return exitCode;
+    trackPIDs.erase(PID);
+}
+
+int waitpid_t::GetExitCode(pid_t PID)
+{
+    std::lock_guard<std::recursive_mutex> mutex_guard(interlock);
+    auto find = trackPIDs.find(PID);
+    return find == trackPIDs.end() ? 0 : find->second;
 }
 
 void waitpid_t::SetExitCode(pid_t PID, int Code)
 {
     std::lock_guard<std::recursive_mutex> mutex_guard(interlock);
-    if (trackPID == notConfigured || PID != trackPID)
+    auto find = trackPIDs.find(PID);
+    if (find == trackPIDs.end())
     {
         return;
     }
-    exitCode = Code;
+    find->second = Code;
 }
 
 #ifdef INTEROP_DEBUGGING
@@ -12,6 +12,7 @@
 #include "interfaces/types.h"
 #include "utils/string_view.h"
 #include "utils/streams.h"
+#include "utils/cancellation.h"
 
 namespace netcoredbg
 {
@@ -53,6 +54,16 @@ public:
         bool operator==(const BreakpointInfo& other) const { return id == other.id; }
     };
 
+    // Result of one expression evaluation in batch, see EvaluateBatch().
+    struct EvaluateBatchResult
+    {
+        HRESULT     status;
+        Variable    variable;
+        std::string output;    // error message in case evaluation failed
+
+        EvaluateBatchResult(int evalFlags) : status(S_OK), variable(evalFlags) {}
+    };
+
     enum class AsyncResult
     {
         Canceled,   // function canceled due to debugger interruption
@@ -69,6 +80,11 @@ public:
     virtual void SetStepFiltering(bool enable) = 0;
     virtual bool IsHotReload() const = 0;
     virtual HRESULT SetHotReload(bool enable) = 0;
+    virtual bool IsAsyncCallStack() const = 0;
+    virtual void SetAsyncCallStack(bool enable) = 0;
+    virtual bool IsCollapseExternalCode() const = 0;
+    virtual void SetCollapseExternalCode(bool enable) = 0;
+    virtual HRESULT SetCodeCoverage(const std::string &outputFile) = 0;
 #ifdef INTEROP_DEBUGGING
     virtual void SetInteropDebugging(bool enable) = 0;
 #endif
@@ -89,16 +105,30 @@ public:
     virtual HRESULT BreakpointActivate(int id, bool act) = 0;
     virtual void EnumerateBreakpoints(std::function<bool (const BreakpointInfo&)>&& callback) = 0;
     virtual HRESULT AllBreakpointsActivate(bool act) = 0;
-    virtual HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) = 0;
+    virtual HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames,
+                                  bool hotReloadAwareCaller = false, const CancellationToken &token = CancellationToken()) = 0;
+    virtual HRESULT GetAsyncTasks(std::vector<AsyncTaskGroup> &taskGroups) = 0;
+    virtual HRESULT GetHeapStats(uint32_t baseSnapshotId, HeapStats &heapStats) = 0;
+    virtual HRESULT StartSampling(unsigned intervalMs) = 0;
+    virtual HRESULT StopSampling(SamplingResult &result) = 0;
+    virtual HRESULT StartTraceRecording(const std::string &outputFile) = 0;
+    virtual HRESULT StopTraceRecording(TraceRecordingStats &stats) = 0;
+    virtual HRESULT ReadTrace(const std::string &traceFile, uint32_t tracepointId, unsigned maxRecords, TraceSummary &summary) = 0;
+    virtual HRESULT GetGCRootPaths(uint32_t variablesReference, unsigned maxPaths, std::vector<GCRootPath> &paths) = 0;
+    virtual void CancelHeapWalk() = 0;
+    virtual void ResetHeapWalkCancel() = 0;
     virtual HRESULT StepCommand(ThreadId threadId, StepType stepType) = 0;
     virtual HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) = 0;
-    virtual HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) = 0;
+    virtual HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables,
+                                 const CancellationToken &token = CancellationToken()) = 0;
     virtual int GetNamedVariables(uint32_t variablesReference) = 0;
     virtual HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) = 0;
+    virtual HRESULT EvaluateBatch(FrameId frameId, int evalFlags, const std::vector<std::string> &expressions, std::vector<EvaluateBatchResult> &results) = 0;
     virtual void CancelEvalRunning() = 0;
     virtual HRESULT SetVariable(const std::string &name, const std::string &value, uint32_t ref, std::string &output) = 0;
     virtual HRESULT SetExpression(FrameId frameId, const std::string &expression, int evalFlags, const std::string &value, std::string &output) = 0;
-    virtual HRESULT GetExceptionInfo(ThreadId threadId, ExceptionInfo &exceptionInfo) = 0;
+    // extendedDetails - also provide exception stack trace and source (func-eval used).
+    virtual HRESULT GetExceptionInfo(ThreadId threadId, bool extendedDetails, ExceptionInfo &exceptionInfo) = 0;
     virtual HRESULT GetSourceFile(const std::string &sourcePath, char** fileBuf, int* fileLen) = 0;
     virtual void FreeUnmanaged(PVOID mem) = 0;
     virtual HRESULT HotReloadApplyDeltas(const std::string &dllFileName, const std::string &deltaMD, const std::string &deltaIL,
@@ -127,10 +127,16 @@ public:
     explicit operator ScalarType() const noexcept { return assert(*this), m_id; }
     explicit operator bool() const { return m_id != -1; }
 
+    // Note, logical frames (async call stack) have no thread, since there is no physical frame for evaluation.
     ThreadId getThread() const noexcept;
     FrameLevel getLevel() const noexcept;
 
+    // Id for logical frame, that could be shown in call stack, but can't be used for scopes and evaluation.
+    static FrameId logical(ThreadId, FrameLevel);
+
     static void invalidate();
+    // Invalidate only frames of provided threads (frames are shared by all debug sessions in process).
+    static void invalidate(const std::vector<ThreadId> &threads);
 
 private:
     ScalarType m_id;
@@ -197,6 +203,7 @@ public:
     std::uintptr_t addr; // exposed for MI and CLI protocols
     bool unknownFrameAddr; // exposed for CLI protocol
     std::string moduleOrLibName; // exposed for CLI protocol
+    std::string presentationHint; // exposed for VSCode protocol
 
     enum ActiveStatementFlags : uint16_t
     {
@@ -234,6 +241,126 @@ public:
     }
 };
 
+struct AsyncTask
+{
+    uint64_t address;
+    std::string status;
+    uint64_t awaitedTask; // 0 in case awaited task is unknown
+
+    AsyncTask() : address(0), awaitedTask(0) {}
+};
+
+struct HeapTypeStats
+{
+    std::string typeName;
+    uint64_t count;
+    uint64_t size;
+    int64_t countDiff; // diff with base snapshot
+    int64_t sizeDiff;
+
+    HeapTypeStats() : count(0), size(0), countDiff(0), sizeDiff(0) {}
+};
+
+struct HeapStats
+{
+    uint32_t snapshotId;
+    uint32_t baseSnapshotId; // 0 in case diff was not requested
+    uint64_t totalCount;
+    uint64_t totalSize;
+    std::vector<HeapTypeStats> types; // sorted by size
+
+    HeapStats() : snapshotId(0), baseSnapshotId(0), totalCount(0), totalSize(0) {}
+};
+
+struct GCRootPathObject
+{
+    uint64_t address;
+    std::string typeName;
+
+    GCRootPathObject() : address(0) {}
+};
+
+// Stack in folded format (method names from root to leaf, separated by ';') and count of samples with this stack.
+struct SampledStack
+{
+    std::string frames;
+    uint64_t count;
+
+    SampledStack(const std::string &frames, uint64_t count) : frames(frames), count(count) {}
+};
+
+struct SamplingResult
+{
+    uint64_t samples;
+    uint64_t skippedSamples; // process was stopped by debugger at sample time
+    uint64_t totalPauseUs;
+    uint64_t maxPauseUs;
+    std::vector<SampledStack> stacks; // sorted by count
+
+    SamplingResult() : samples(0), skippedSamples(0), totalPauseUs(0), maxPauseUs(0) {}
+};
+
+struct TraceRecordingStats
+{
+    uint64_t records;
+    uint64_t lostRecords; // dropped, since writer can't keep up with tracepoints hits
+    uint64_t bytes;
+    uint64_t durationUs;
+
+    TraceRecordingStats() : records(0), lostRecords(0), bytes(0), durationUs(0) {}
+};
+
+// Tracepoint hit, values are expressions evaluation results (or error messages) in tracepoint's expressions order.
+struct TraceRecord
+{
+    uint32_t tracepointId;
+    uint64_t timeUs; // from recording start
+    int threadId;
+    std::vector<std::string> values;
+
+    TraceRecord() : tracepointId(0), timeUs(0), threadId(0) {}
+};
+
+struct TracepointSummary
+{
+    uint32_t id;
+    std::string location;
+    std::vector<std::string> expressions;
+    uint64_t hits;
+    uint64_t firstTimeUs;
+    uint64_t lastTimeUs;
+    unsigned threads;
+
+    TracepointSummary() : id(0), hits(0), firstTimeUs(0), lastTimeUs(0), threads(0) {}
+};
+
+struct TraceSummary
+{
+    uint64_t startTimeUs; // recording start, from epoch
+    uint64_t hits;
+    std::vector<TracepointSummary> tracepoints;
+    std::vector<TraceRecord> records; // first records for requested tracepoint (or all tracepoints)
+
+    TraceSummary() : startTimeUs(0), hits(0) {}
+};
+
+// Chain of references from GC root to object.
+struct GCRootPath
+{
+    std::string rootKind; // for example, "stack" or "strong handle", comma separated in case object is root for few reasons
+    std::vector<GCRootPathObject> objects; // from root object to target object
+};
+
+// Not completed async tasks with same logical call stack.
+struct AsyncTaskGroup
+{
+    std::vector<StackFrame> stackFrames; // frames have no ID, since not related to any thread
+    std::vector<AsyncTask> tasks; // only first tasks, see `count` for all tasks in group
+    unsigned count;
+
+    AsyncTaskGroup() : count(0) {}
+};
+
 struct Breakpoint
 {
     uint32_t id;
@@ -367,6 +494,25 @@ struct ModuleEvent
     ModuleEvent(ModuleReason reason, const Module &module) : reason(reason), module(module) {}
 };
 
+enum ProgressReason
+{
+    ProgressStart,
+    ProgressUpdate,
+    ProgressEnd
+};
+
+struct ProgressEvent
+{
+    ProgressReason reason;
+    std::string progressId;
+    std::string title; // ProgressStart only
+    unsigned percentage;
+
+    ProgressEvent(ProgressReason reason, const std::string &progressId, unsigned percentage) :
+        reason(reason), progressId(progressId), percentage(percentage)
+    {}
+};
+
 struct Scope
 {
     std::string name;
@@ -430,11 +576,26 @@ enum VariablesFilter
     VariablesBoth
 };
 
+// Breakpoint hit filters, checked before condition evaluation. Empty vector - no filter.
+struct BreakpointFilters
+{
+    // Thread filter pass, in case thread id or thread name match any item.
+    std::vector<int> threadIds;
+    std::vector<std::string> threadNames;
+    // Caller (previous frame) method module name, with or without path and extension.
+    std::vector<std::string> callerModules;
+};
+
 struct LineBreakpoint
 {
     std::string module;
     int line;
     std::string condition;
+    // Not empty for tracepoint, that don't stop debuggee, but record expressions values at hit (see trace recording).
+    std::vector<std::string> traceExpressions;
+    // Hit count condition: "N" or "==N" - break at N hit, ">=N", ">N", "%N" - break at each N hit.
+    std::string hitCondition;
+    BreakpointFilters filters;
 
     LineBreakpoint(const std::string &module,
                    int linenum,
@@ -451,6 +612,7 @@ struct FuncBreakpoint
     std::string func;
     std::string params;
     std::string condition;
+    BreakpointFilters filters;
 
     FuncBreakpoint(const std::string &module,
                    const std::string &func,
@@ -490,6 +652,7 @@ struct ExceptionDetails
     std::string fullTypeName;
     std::string evaluateName;
     std::string stackTrace;
+    int32_t hResult = 0;
     // Note, VSCode protocol have "innerException" field as array, but in real we don't have array with inner exceptions here,
     // since exception object have only one exeption object reference in InnerException field.
     std::unique_ptr<ExceptionDetails> innerException;
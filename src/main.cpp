@@ -4,6 +4,10 @@
 
 #include <string>
 #include <exception>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -17,6 +21,7 @@
 #include "managed/interop.h"
 #include "utils/utf.h"
 #include "utils/logger.h"
+#include "utils/timeline.h"
 #include "buildinfo.h"
 #include "version.h"
 
@@ -46,6 +51,7 @@ namespace netcoredbg
 {
 
 static const uint16_t DEFAULT_SERVER_PORT = 4711;
+static const unsigned DEFAULT_MAX_SESSIONS = 16;
 
 static void print_help()
 {
@@ -72,10 +78,20 @@ static void print_help()
         "--server[=port_num]                   Start the debugger listening for requests on the\n"
         "                                      specified TCP/IP port instead of stdin/out. If port is not specified\n"
         "                                      TCP %i will be used.\n"
+        "--multi-session[=max_sessions]        Server mode only, serve many debug sessions (connections) at same time,\n"
+        "                                      each session have own debugger instance. Runtime for debugger's managed\n"
+        "                                      part is initialized only once and reused by all sessions. If maximum is\n"
+        "                                      not specified, %u sessions will be served at same time.\n"
+        "--preload-runtime=<path>              Initialize runtime for debugger's managed part at start, path to\n"
+        "                                      CoreCLR library should be provided.\n"
+        "--warm-up=<none|eval|symbols|all>     Managed part code warm-up in background after runtime initialization.\n"
+        "                                      All warm-up is enabled by default.\n"
+        "--trace=<file>                        Write debugger startup and requests timeline to file in Chrome trace\n"
+        "                                      format (could be opened by chrome://tracing or Perfetto UI).\n"
         "--log[=<type>]                        Enable logging. Supported logging to file and to dlog (only for Tizen)\n"
         "                                      File log by default. File is created in 'current' folder.\n"
         "--version                             Displays the current version.\n",
-        (int)DEFAULT_SERVER_PORT
+        (int)DEFAULT_SERVER_PORT, DEFAULT_MAX_SESSIONS
     );
 }
 
@@ -166,6 +182,129 @@ Streams open_streams(Holder& holder, unsigned server_port, ProtocolConstructor c
     return {std::cin, std::cout};
 }
 
+struct SessionOptions
+{
+    ProtocolConstructor constructor;
+    bool engineLogging;
+    std::string logFilePath;
+    bool hotReload;
+};
+
+// Serve single debug session with own protocol and debugger instances, session finished at command loop exit
+// (client disconnect or connection close).
+static void RunSession(IOSystem::FileHandle socket, unsigned sessionId, const SessionOptions &options)
+{
+    LOGI("Session %u started", sessionId);
+
+    std::unique_ptr<std::iostream> stream(new IOStream(StreamBuf(socket)));
+    ProtocolHolder protocol = options.constructor({*stream, *stream});
+
+    if (options.engineLogging)
+    {
+        // Note, protocol was checked at start. Each session need own log file.
+        auto p = static_cast<VSCodeProtocol*>(protocol.get());
+        p->EngineLogging(options.logFilePath.empty() ? options.logFilePath : options.logFilePath + "." + std::to_string(sessionId));
+    }
+
+    std::shared_ptr<IDebugger> debugger;
+    try
+    {
+        debugger.reset(new ManagedDebugger(protocol.get()));
+    }
+    catch (const std::exception &e)
+    {
+        LOGE("Session %u: %s", sessionId, e.what());
+        return;
+    }
+
+    protocol->SetDebugger(debugger);
+    if (options.hotReload)
+        debugger->SetHotReload(true);
+
+    protocol->CommandLoop();
+
+    // Debugger must be destroyed before protocol, since debugger use protocol for events.
+    std::shared_ptr<IDebugger> noDebugger;
+    protocol->SetDebugger(noDebugger);
+    debugger.reset();
+    protocol.reset();
+
+    LOGI("Session %u finished", sessionId);
+}
+
+// Accept connections and serve each connection by own debug session in separate thread. CoreCLR for debugger's
+// managed part can be initialized only once for process (see Interop::Init()), so, only first session (or
+// preload at start) pay for runtime start and ManagedPart load, all next sessions reuse it.
+static int RunMultiSessionServer(uint16_t serverPort, unsigned maxSessions, const SessionOptions &options)
+{
+    IOSystem::FileHandle listener = IOSystem::server_socket(serverPort, int(maxSessions));
+    if (!listener)
+    {
+        fprintf(stderr, "can't open listening socket for port %u\n", serverPort);
+        return EXIT_FAILURE;
+    }
+
+    struct Session
+    {
+        std::thread thread;
+        bool finished = false;
+    };
+
+    std::mutex sessionsMutex;
+    std::condition_variable sessionsCV;
+    std::list<Session> sessions;
+    unsigned lastSessionId = 0;
+
+    // Caller must care about sessionsMutex.
+    auto JoinFinishedSessions = [&]()
+    {
+        for (auto it = sessions.begin(); it != sessions.end();)
+        {
+            if (!it->finished)
+            {
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            it = sessions.erase(it);
+        }
+    };
+
+    LOGI("Multi-session server started on port %u, %u sessions max", serverPort, maxSessions);
+
+    while (true)
+    {
+        {
+            // Note, connections that can't be served now are queued by listening socket.
+            std::unique_lock<std::mutex> lock(sessionsMutex);
+            sessionsCV.wait(lock, [&]{ JoinFinishedSessions(); return sessions.size() < maxSessions; });
+        }
+
+        IOSystem::FileHandle socket = IOSystem::accept_socket(listener);
+        if (!socket)
+            break;
+
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        auto session = sessions.emplace(sessions.end());
+        const unsigned sessionId = ++lastSessionId;
+        session->thread = std::thread([&, session, socket, sessionId]()
+        {
+            RunSession(socket, sessionId, options);
+
+            std::lock_guard<std::mutex> lockSessions(sessionsMutex);
+            session->finished = true;
+            sessionsCV.notify_one();
+        });
+    }
+
+    LOGE("Multi-session server stopped, can't accept connection");
+
+    std::unique_lock<std::mutex> lock(sessionsMutex);
+    sessionsCV.wait(lock, [&]{ JoinFinishedSessions(); return sessions.empty(); });
+    IOSystem::close(listener);
+    return EXIT_FAILURE;
+}
+
 } // namespace netcoredbg
 
 
@@ -258,6 +397,10 @@ int
     std::vector<string_view> initCommands;
 
     uint16_t serverPort = 0;
+    bool multiSession = false;
+    unsigned maxSessions = DEFAULT_MAX_SESSIONS;
+    std::string preloadRuntimePath;
+    std::string traceFilePath;
 
     std::string execFile;
     std::vector<std::string> execArgs;
@@ -374,6 +517,11 @@ int
 
             serverPort = DEFAULT_SERVER_PORT;
 
+        } },
+        { "--multi-session", [&](int& i){
+
+            multiSession = true;
+
         } },
         { "--", [&](int& i){
 
@@ -424,6 +572,45 @@ int
             }
 
         } },
+        { "--multi-session=", [&](int& i){
+
+            char *err;
+            multiSession = true;
+            maxSessions = static_cast<unsigned>(strtoul(argv[i] + strlen("--multi-session="), &err, 10));
+            if (*err != 0 || maxSessions == 0)
+            {
+                fprintf(stderr, "Error: Wrong sessions number\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--preload-runtime=", [&](int& i){
+
+            preloadRuntimePath = argv[i] + strlen("--preload-runtime=");
+
+        } },
+        { "--trace=", [&](int& i){
+
+            traceFilePath = argv[i] + strlen("--trace=");
+
+        } },
+        { "--warm-up=", [&](int& i){
+
+            static const std::unordered_map<std::string, unsigned> modes{
+                {"none", Interop::WarmUpNone},
+                {"eval", Interop::WarmUpEval},
+                {"symbols", Interop::WarmUpSymbols},
+                {"all", Interop::WarmUpAll}
+            };
+            auto find = modes.find(argv[i] + strlen("--warm-up="));
+            if (find == modes.end())
+            {
+                fprintf(stderr, "Error: Unknown warm-up mode %s\n", argv[i] + strlen("--warm-up="));
+                exit(EXIT_FAILURE);
+            }
+            Interop::SetWarmUpMode(find->second);
+
+        } },
     };
 
     for (int i = 1; i < argc; i++)
@@ -441,10 +628,66 @@ int
 
     CheckStartOptions(protocol_constructor, initCommands, argv, execFile, run, serverPort);
 
+    if (multiSession)
+    {
+        if (serverPort == 0)
+        {
+            fprintf(stderr, "--multi-session option can be used only in server mode!\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if (pidDebuggee != 0 || !execFile.empty() || needInteropDebugging)
+        {
+            fprintf(stderr, "--multi-session option can't be used with --attach, --interop-debugging or program to debug!\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if (engineLogging && protocol_constructor != &instantiate_protocol<VSCodeProtocol>)
+        {
+            fprintf(stderr, "Error: Engine logging is only supported in VsCode interpreter mode.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
     LOGI("Netcoredbg started");
     // Note: there is no possibility to know which exception caused call to std::terminate
     std::set_terminate([]{ LOGF("Netcoredbg is terminated due to call to std::terminate: see stderr..."); });
 
+    if (!traceFilePath.empty())
+    {
+        if (!Timeline::Start(traceFilePath))
+        {
+            fprintf(stderr, "Error: Can't open trace file %s\n", traceFilePath.c_str());
+            exit(EXIT_FAILURE);
+        }
+        // Note, debugger could be finished by exit() call from protocol, write rest of timeline in any case.
+        atexit([]{ Timeline::Stop(); });
+    }
+
+    if (!preloadRuntimePath.empty())
+    {
+        try
+        {
+            Interop::Init(preloadRuntimePath);
+        }
+        catch (const std::exception &e)
+        {
+            fprintf(stderr, "Error: Can't preload runtime: %s\n", e.what());
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (multiSession)
+    {
+#ifdef INTEROP_DEBUGGING
+        SetSigactionMode(false);
+#endif
+        SessionOptions options{protocol_constructor, engineLogging, logFilePath, needHotReload};
+        int result = RunMultiSessionServer(serverPort, maxSessions, options);
+        Interop::Shutdown();
+        return result;
+    }
+
     std::vector<std::unique_ptr<std::ios_base> > streams;
     std::shared_ptr<IProtocol> protocol = protocol_constructor(open_streams(streams, serverPort, protocol_constructor));
 
@@ -7,6 +7,10 @@
 #include "managed/interop.h"
 
 #include <coreclrhost.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <string>
 
@@ -17,6 +21,8 @@
 #include "utils/utf.h"
 #include "utils/rwlock.h"
 #include "utils/filesystem.h"
+#include "utils/logger.h"
+#include "utils/timeline.h"
 
 
 #ifdef FEATURE_PAL
@@ -52,6 +58,14 @@ void *hostHandle = nullptr;
 unsigned int domainId = 0;
 coreclr_shutdown_ptr shutdownCoreClr = nullptr;
 
+std::atomic<unsigned> warmUpMode(WarmUpAll);
+// Note, warm-up thread is detached, since process could be finished by exit() call with running warm-up.
+std::mutex warmUpMutex;
+std::condition_variable warmUpCV;
+bool warmUpRunning = false;
+thread_local bool isWarmUpThread = false;
+std::atomic<bool> firstProgramGenerated(false);
+
 // CoreCLR use fixed size integers, don't use system/arch size dependent types for delegates.
 // Important! In case of usage pointer to variable as delegate arg, make sure it have proper size for CoreCLR!
 // For example, native code "int" != managed code "int", since managed code "int" is 4 byte fixed size.
@@ -118,8 +132,56 @@ int ReadMemoryForSymbols(uint64_t address, char *buffer, int cb)
     return cb;
 }
 
+long long MillisecondsFrom(std::chrono::steady_clock::time_point start)
+{
+    return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Note, warm-up errors are not fatal, code will be compiled by JIT at first real usage.
+void WarmUpWorker(unsigned mode, std::string managedPartPath)
+{
+    isWarmUpThread = true;
+
+    if (mode & WarmUpEval)
+    {
+        Timeline::Scope timelineScope("WarmUpEval", "startup");
+        const auto start = std::chrono::steady_clock::now();
+        PVOID pStackProgram = nullptr;
+        std::string textOutput;
+        // Expression with most common syntax nodes (identifiers, member access, indexer, invocation, literals, operators).
+        if (SUCCEEDED(GenerateStackMachineProgram("a.b[1] + c(2, \"s\") * -d.e", &pStackProgram, textOutput)))
+            ReleaseStackMachineProgram(pStackProgram);
+
+        LOGI("Warm-up: evaluation %lld ms", MillisecondsFrom(start));
+    }
+
+    if (mode & WarmUpSymbols)
+    {
+        Timeline::Scope timelineScope("WarmUpSymbols", "startup");
+        const auto start = std::chrono::steady_clock::now();
+        PVOID pSymbolReaderHandle = nullptr;
+        if (SUCCEEDED(LoadSymbolsForPortablePDB(managedPartPath, FALSE, TRUE, 0, 0, 0, 0, &pSymbolReaderHandle)))
+        {
+            SequencePoint sequencePoint;
+            GetSequencePointByILOffset(pSymbolReaderHandle, mdMethodDefNil + 1, 0, &sequencePoint);
+            DisposeSymbols(pSymbolReaderHandle);
+        }
+
+        LOGI("Warm-up: symbol reader %lld ms", MillisecondsFrom(start));
+    }
+
+    std::lock_guard<std::mutex> lock(warmUpMutex);
+    warmUpRunning = false;
+    warmUpCV.notify_all();
+}
+
 } // unnamed namespace
 
+void SetWarmUpMode(unsigned mode)
+{
+    warmUpMode = mode;
+}
+
 HRESULT LoadSymbolsForPortablePDB(const std::string &modulePath, BOOL isInMemory, BOOL isFileLayout, ULONG64 peAddress, ULONG64 peSize,
                                   ULONG64 inMemoryPdbAddress, ULONG64 inMemoryPdbSize, VOID **ppSymbolReaderHandle)
 {
@@ -168,6 +230,9 @@ void Init(const std::string &coreClrPath)
     if (shutdownCoreClr != nullptr)
         return;
 
+    Timeline::Scope timelineScope("Interop::Init", "startup");
+    auto start = std::chrono::steady_clock::now();
+
     std::string clrDir = coreClrPath.substr(0, coreClrPath.rfind(DIRECTORY_SEPARATOR_STR_A));
 
     HRESULT Status;
@@ -211,12 +276,18 @@ void Init(const std::string &coreClrPath)
                                     clrDir.c_str(), // NATIVE_DLL_SEARCH_DIRECTORIES
                                     "UseLatestBehaviorWhenTFMNotSpecified"};  // AppDomainCompatSwitch
 
+    const long long loadTime = MillisecondsFrom(start);
+    start = std::chrono::steady_clock::now();
+
     Status = initializeCoreCLR(exe.c_str(), "debugger",
         sizeof(propertyKeys) / sizeof(propertyKeys[0]), propertyKeys, propertyValues, &hostHandle, &domainId);
 
     if (FAILED(Status))
         throw std::runtime_error("Fail to initialize CoreCLR " + std::to_string(Status));
 
+    const long long initTime = MillisecondsFrom(start);
+    start = std::chrono::steady_clock::now();
+
     coreclr_create_delegate_ptr createDelegate = (coreclr_create_delegate_ptr)DLSym(coreclrLib, "coreclr_create_delegate");
     if (createDelegate == nullptr)
         throw std::runtime_error("coreclr_create_delegate not found");
@@ -277,16 +348,32 @@ void Init(const std::string &coreClrPath)
 
     if (!allDelegatesInited)
         throw std::runtime_error("Some delegates nulled");
+
+    LOGI("Managed part init: CoreCLR load %lld ms, CoreCLR init %lld ms, ManagedPart load %lld ms",
+         loadTime, initTime, MillisecondsFrom(start));
+
+    const unsigned mode = warmUpMode;
+    if (mode != WarmUpNone)
+    {
+        std::lock_guard<std::mutex> lock(warmUpMutex);
+        warmUpRunning = true;
+        std::thread(WarmUpWorker, mode, exeDir + DIRECTORY_SEPARATOR_STR_A + ManagedPartDllName + ".dll").detach();
+    }
 }
 
 // WARNING! Due to CoreCLR limitations, Shutdown() can't be called out of the Main() scope, for example, from global object destructor.
 void Shutdown()
 {
+    {
+        // Don't shutdown CoreCLR in the middle of warm-up managed code execution.
+        std::unique_lock<std::mutex> lock(warmUpMutex);
+        warmUpCV.wait(lock, []{ return !warmUpRunning; });
+    }
+
     std::unique_lock<Utility::RWLock::Writer> write_lock(CLRrwlock.writer);
     if (shutdownCoreClr == nullptr)
         return;
 
-    // "Warm up Roslyn" thread still could be running at this point, let `coreclr_shutdown` care about this.
     HRESULT Status;
     if (FAILED(Status = shutdownCoreClr(hostHandle, domainId)))
         LOGE("coreclr_shutdown failed - status: 0x%08x", Status);
@@ -474,9 +561,14 @@ HRESULT GenerateStackMachineProgram(const std::string &expr, PVOID *ppStackProgr
 
     textOutput = "";
     BSTR wTextOutput = nullptr;
+    const auto start = std::chrono::steady_clock::now();
     HRESULT Status = generateStackMachineProgramDelegate(to_utf16(expr).c_str(), ppStackProgram, &wTextOutput);
     read_lock.unlock();
 
+    // First program generation time show, how much JIT (Roslyn) cost for first evaluation (see warm-up).
+    if (!isWarmUpThread && !firstProgramGenerated.exchange(true))
+        LOGI("First stack machine program generated in %lld ms", MillisecondsFrom(start));
+
     if (wTextOutput)
     {
         textOutput = to_utf8(wTextOutput);
@@ -78,6 +78,18 @@ namespace Interop
         {}
     };
 
+    enum WarmUpMode : unsigned
+    {
+        WarmUpNone = 0,
+        WarmUpEval = 1 << 0,    // Roslyn parse and stack machine program generation
+        WarmUpSymbols = 1 << 1, // symbol reader (ManagedPart.dll own symbols are used)
+        WarmUpAll = WarmUpEval | WarmUpSymbols
+    };
+
+    // Managed code warm-up (JIT) is started in background thread right after Init(), so, it overlap with debuggee
+    // startup and first evaluation/breakpoint condition don't wait for JIT. Must be set before Init() call.
+    void SetWarmUpMode(unsigned mode);
+
     // WARNING! Due to CoreCLR limitations, Init() / Shutdown() sequence can be used only once during process execution.
     // Note, init in case of error will throw exception, since this is fatal for debugger (CoreCLR can't be re-init).
     void Init(const std::string &coreClrPath);
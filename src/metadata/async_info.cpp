@@ -10,41 +10,82 @@
 namespace netcoredbg
 {
 
-// Caller must care about m_asyncMethodSteppingInfoMutex.
-HRESULT AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion)
+// Return cached or new created async info for method, never return null.
+std::shared_ptr<const AsyncInfo::AsyncMethodInfo> AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion)
 {
     // Note, for normal methods, `Interop::GetAsyncMethodSteppingInfo()` will return error code and set `lastIlOffset` to 0.
     // Error during async info search (debug info not available or method token belong to normal method) is proper behaviour and debugger logic also count on this.
 
-    if (asyncMethodSteppingInfo.modAddress == modAddress &&
-        asyncMethodSteppingInfo.methodToken == methodToken &&
-        asyncMethodSteppingInfo.methodVersion == methodVersion)
-        return asyncMethodSteppingInfo.retCode;
+    const AsyncMethodKey key{modAddress, methodToken, methodVersion};
+    {
+        const std::lock_guard<std::mutex> lock(m_asyncMethodsCacheMutex);
+
+        auto find = m_asyncMethodsCacheIndex.find(key);
+        if (find != m_asyncMethodsCacheIndex.end())
+        {
+            // Move data to begin, so, last used will be on front.
+            if (find->second != m_asyncMethodsCache.begin())
+                m_asyncMethodsCache.splice(m_asyncMethodsCache.begin(), m_asyncMethodsCache, find->second);
 
-    if (!asyncMethodSteppingInfo.awaits.empty())
-        asyncMethodSteppingInfo.awaits.clear();
+            return m_asyncMethodsCache.front();
+        }
+    }
 
-    asyncMethodSteppingInfo.modAddress = modAddress;
-    asyncMethodSteppingInfo.methodToken = methodToken;
-    asyncMethodSteppingInfo.methodVersion = methodVersion;
-    asyncMethodSteppingInfo.retCode = m_sharedModules->GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+    // Note, we don't hold cache lock during async info read from PDB, so, other threads could use cache at this time.
+    std::shared_ptr<AsyncMethodInfo> asyncMethodInfo(new AsyncMethodInfo(key));
+    asyncMethodInfo->retCode = m_sharedModules->GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
         if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
             return E_FAIL;
 
         HRESULT Status;
         std::vector<Interop::AsyncAwaitInfoBlock> AsyncAwaitInfo;
-        IfFailRet(Interop::GetAsyncMethodSteppingInfo(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, AsyncAwaitInfo, &asyncMethodSteppingInfo.lastIlOffset));
+        IfFailRet(Interop::GetAsyncMethodSteppingInfo(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, AsyncAwaitInfo, &asyncMethodInfo->lastIlOffset));
 
+        asyncMethodInfo->awaits.reserve(AsyncAwaitInfo.size());
         for (const auto &entry : AsyncAwaitInfo)
         {
-            asyncMethodSteppingInfo.awaits.emplace_back(entry.yield_offset, entry.resume_offset);
+            asyncMethodInfo->awaits.emplace_back(entry.yield_offset, entry.resume_offset);
         }
 
         return S_OK;
     });
 
-    return asyncMethodSteppingInfo.retCode;
+    const std::lock_guard<std::mutex> lock(m_asyncMethodsCacheMutex);
+
+    // Same method could be added by another thread, while we read async info.
+    auto find = m_asyncMethodsCacheIndex.find(key);
+    if (find != m_asyncMethodsCacheIndex.end())
+        return *find->second;
+
+    if (m_asyncMethodsCache.size() == m_asyncMethodsCacheSize)
+    {
+        m_asyncMethodsCacheIndex.erase(m_asyncMethodsCache.back()->key);
+        m_asyncMethodsCache.pop_back();
+    }
+
+    m_asyncMethodsCache.emplace_front(std::move(asyncMethodInfo));
+    m_asyncMethodsCacheIndex.emplace(key, m_asyncMethodsCache.begin());
+
+    return m_asyncMethodsCache.front();
+}
+
+void AsyncInfo::InvalidateMethods(CORDB_ADDRESS modAddress, const std::unordered_set<mdMethodDef> &methodTokens)
+{
+    const std::lock_guard<std::mutex> lock(m_asyncMethodsCacheMutex);
+
+    for (auto it = m_asyncMethodsCache.begin(); it != m_asyncMethodsCache.end();)
+    {
+        const AsyncMethodKey &key = (*it)->key;
+        if (key.modAddress != modAddress || methodTokens.find(key.methodToken) == methodTokens.end())
+        {
+            ++it;
+            continue;
+        }
+
+        m_asyncMethodsCacheIndex.erase(key);
+        it = m_asyncMethodsCache.erase(it);
+    }
 }
 
 // Check if method have await block. In this way we detect async method with awaits.
@@ -52,9 +93,7 @@ HRESULT AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethod
 // [in] methodToken - method token (from module with address modAddress).
 bool AsyncInfo::IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion)
 {
-    const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
-
-    return SUCCEEDED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion));
+    return SUCCEEDED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion)->retCode);
 }
 
 // Find await block after IL offset in particular async method and return await info, if present.
@@ -63,19 +102,17 @@ bool AsyncInfo::IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 // [in] methodToken - method token (from module with address modAddress).
 // [in] ipOffset - IL offset;
 // [out] awaitInfo - result, next await info.
-bool AsyncInfo::FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 ipOffset, AwaitInfo **awaitInfo)
+bool AsyncInfo::FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 ipOffset, AwaitInfo &awaitInfo)
 {
-    const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
-
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion)))
+    std::shared_ptr<const AsyncMethodInfo> asyncMethodInfo = GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion);
+    if (FAILED(asyncMethodInfo->retCode))
         return false;
 
-    for (auto &await : asyncMethodSteppingInfo.awaits)
+    for (const auto &await : asyncMethodInfo->awaits)
     {
         if (ipOffset <= await.yield_offset)
         {
-            if (awaitInfo)
-                *awaitInfo = &await;
+            awaitInfo = await;
             return true;
         }
         // Stop search, if IP inside 'await' routine.
@@ -96,12 +133,30 @@ bool AsyncInfo::FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 // [out] lastIlOffset - result, IL offset for last user code line in async method.
 bool AsyncInfo::FindLastIlOffsetAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 &lastIlOffset)
 {
-    const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
+    std::shared_ptr<const AsyncMethodInfo> asyncMethodInfo = GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion);
+    if (FAILED(asyncMethodInfo->retCode))
+        return false;
+
+    lastIlOffset = asyncMethodInfo->lastIlOffset;
+    return true;
+}
+
+// Find await info for suspended async method by state machine state.
+// Compiler numerate awaits in method from 0 in IL order and store await number into state machine '<>1__state' field at suspend.
+// [in] modAddress - module address;
+// [in] methodToken - method token (from module with address modAddress).
+// [in] state - state machine '<>1__state' field value;
+// [out] awaitInfo - result, await info.
+bool AsyncInfo::FindAwaitInfoByState(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, int32_t state, AwaitInfo &awaitInfo)
+{
+    if (state < 0)
+        return false;
 
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion)))
+    std::shared_ptr<const AsyncMethodInfo> asyncMethodInfo = GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion);
+    if (FAILED(asyncMethodInfo->retCode) || asyncMethodInfo->awaits.size() <= (size_t)state)
         return false;
 
-    lastIlOffset = asyncMethodSteppingInfo.lastIlOffset;
+    awaitInfo = asyncMethodInfo->awaits[state];
     return true;
 }
 
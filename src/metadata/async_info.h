@@ -5,6 +5,10 @@
 #pragma once
 
 #include <memory>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "metadata/modules.h"
 
@@ -35,33 +39,61 @@ public:
     };
 
     bool IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion);
-    bool FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 ipOffset, AwaitInfo **awaitInfo);
+    bool FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 ipOffset, AwaitInfo &awaitInfo);
     bool FindLastIlOffsetAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 &lastIlOffset);
+    bool FindAwaitInfoByState(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, int32_t state, AwaitInfo &awaitInfo);
+    // Remove cached data for methods changed by Hot Reload.
+    void InvalidateMethods(CORDB_ADDRESS modAddress, const std::unordered_set<mdMethodDef> &methodTokens);
 
 private:
 
     std::shared_ptr<Modules> m_sharedModules;
 
-    struct AsyncMethodInfo
+    struct AsyncMethodKey
     {
         CORDB_ADDRESS modAddress;
         mdMethodDef methodToken;
         ULONG32 methodVersion;
+
+        bool operator==(const AsyncMethodKey &other) const
+        {
+            return modAddress == other.modAddress && methodToken == other.methodToken && methodVersion == other.methodVersion;
+        }
+    };
+
+    struct AsyncMethodKeyHash
+    {
+        size_t operator()(const AsyncMethodKey &key) const
+        {
+            return std::hash<CORDB_ADDRESS>()(key.modAddress) ^
+                   (std::hash<uint64_t>()((uint64_t(key.methodToken) << 32) | key.methodVersion) << 1);
+        }
+    };
+
+    // Note, data is not changed after creation, so, it could be used by caller without lock.
+    struct AsyncMethodInfo
+    {
+        AsyncMethodKey key;
         HRESULT retCode;
 
         std::vector<AwaitInfo> awaits;
         // Part of NotifyDebuggerOfWaitCompletion magic, see ManagedDebugger::SetupAsyncStep().
         ULONG32 lastIlOffset;
 
-        AsyncMethodInfo() :
-            modAddress(0), methodToken(mdMethodDefNil), methodVersion(0), retCode(S_OK), awaits(), lastIlOffset(0)
+        AsyncMethodInfo(const AsyncMethodKey &key) :
+            key(key), retCode(S_OK), awaits(), lastIlOffset(0)
         {};
     };
 
-    AsyncMethodInfo asyncMethodSteppingInfo;
-    std::mutex m_asyncMethodSteppingInfoMutex;
-    // Note, result stored into asyncMethodSteppingInfo.
-    HRESULT GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion);
+    // Stepping could bounce between few async methods and `IsMethodHaveAwait()` called for frames during step,
+    // so, we cache data for few last used methods (including normal methods, that have no async info).
+    static const size_t m_asyncMethodsCacheSize = 64;
+    std::mutex m_asyncMethodsCacheMutex;
+    // At access, element moved to front of list, new element also add to front. In this way, not used elements displaced from cache.
+    std::list<std::shared_ptr<const AsyncMethodInfo>> m_asyncMethodsCache;
+    std::unordered_map<AsyncMethodKey, std::list<std::shared_ptr<const AsyncMethodInfo>>::iterator, AsyncMethodKeyHash> m_asyncMethodsCacheIndex;
+
+    std::shared_ptr<const AsyncMethodInfo> GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion);
 
 };
 
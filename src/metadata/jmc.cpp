@@ -32,16 +32,40 @@ const char DebuggerAttribute::Hidden[] = "System.Diagnostics.DebuggerHiddenAttri
 static std::vector<std::string> typeAttrNames{DebuggerAttribute::NonUserCode, DebuggerAttribute::StepThrough};
 static std::vector<std::string> methodAttrNames{DebuggerAttribute::NonUserCode, DebuggerAttribute::StepThrough, DebuggerAttribute::Hidden};
 
+static void SetUserCodeMethod(std::vector<bool> &userCodeMethods, mdMethodDef methodDef, bool userCode)
+{
+    const ULONG rid = RidFromToken(methodDef);
+    if (userCodeMethods.size() <= rid)
+        userCodeMethods.resize(rid + 1, false);
+
+    userCodeMethods[rid] = userCode;
+}
+
+bool IsUserCodeMethod(const std::vector<bool> &userCodeMethods, mdMethodDef methodDef)
+{
+    const ULONG rid = RidFromToken(methodDef);
+    return rid < userCodeMethods.size() && userCodeMethods[rid];
+}
+
 static HRESULT GetNonJMCMethodsForTypeDef(
     IMetaDataImport *pMD,
     mdTypeDef typeDef,
-    std::vector<mdToken> &excludeMethods)
+    bool nonJMCTypeDef,
+    std::vector<mdToken> &excludeMethods,
+    std::vector<bool> &userCodeMethods)
 {
     ULONG numMethods = 0;
     HCORENUM fEnum = NULL;
     mdMethodDef methodDef;
     while(SUCCEEDED(pMD->EnumMethods(&fEnum, typeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
     {
+        // Class attribute affect all class methods, no need check each method attributes.
+        if (nonJMCTypeDef)
+        {
+            SetUserCodeMethod(userCodeMethods, methodDef, false);
+            continue;
+        }
+
         mdTypeDef memTypeDef;
         ULONG nameLen;
         WCHAR szFunctionName[mdNameLen] = {0};
@@ -52,14 +76,19 @@ static HRESULT GetNonJMCMethodsForTypeDef(
             continue;
 
         if (HasAttribute(pMD, methodDef, methodAttrNames))
+        {
             excludeMethods.push_back(methodDef);
+            SetUserCodeMethod(userCodeMethods, methodDef, false);
+        }
+        else
+            SetUserCodeMethod(userCodeMethods, methodDef, true);
     }
     pMD->CloseEnum(fEnum);
 
     return S_OK;
 }
 
-static HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens)
+static HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens, std::vector<bool> &userCodeMethods)
 {
     HRESULT Status;
 
@@ -68,15 +97,22 @@ static HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<
     IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
     IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
 
+    userCodeMethods.clear();
+    // Global methods (EnumTypeDefs don't provide <Module> type).
+    GetNonJMCMethodsForTypeDef(pMD, mdTypeDefNil, false, excludeTokens, userCodeMethods);
+
     ULONG numTypedefs = 0;
     HCORENUM fEnum = NULL;
     mdTypeDef typeDef;
     while(SUCCEEDED(pMD->EnumTypeDefs(&fEnum, &typeDef, 1, &numTypedefs)) && numTypedefs != 0)
     {
         if (HasAttribute(pMD, typeDef, typeAttrNames))
+        {
             excludeTokens.push_back(typeDef);
+            GetNonJMCMethodsForTypeDef(pMD, typeDef, true, excludeTokens, userCodeMethods);
+        }
         else
-            GetNonJMCMethodsForTypeDef(pMD, typeDef, excludeTokens);
+            GetNonJMCMethodsForTypeDef(pMD, typeDef, false, excludeTokens, userCodeMethods);
     }
     pMD->CloseEnum(fEnum);
 
@@ -110,17 +146,23 @@ void DisableJMCForTokenList(ICorDebugModule *pModule, const std::vector<mdToken>
     }
 }
 
-HRESULT DisableJMCByAttributes(ICorDebugModule *pModule)
+HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, std::vector<bool> &userCodeMethods)
 {
     HRESULT Status;
     std::vector<mdToken> excludeTokens;
-    IfFailRet(GetNonJMCClassesAndMethods(pModule, excludeTokens));
+    IfFailRet(GetNonJMCClassesAndMethods(pModule, excludeTokens, userCodeMethods));
 
     DisableJMCForTokenList(pModule, excludeTokens);
     return S_OK;
 }
 
-HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens)
+HRESULT GetUserCodeMethods(ICorDebugModule *pModule, std::vector<bool> &userCodeMethods)
+{
+    std::vector<mdToken> excludeTokens;
+    return GetNonJMCClassesAndMethods(pModule, excludeTokens, userCodeMethods);
+}
+
+HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens, std::vector<bool> &userCodeMethods)
 {
     HRESULT Status;
     std::vector<mdToken> excludeTokens;
@@ -145,11 +187,15 @@ HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, const std::unordered_se
         if (HasAttribute(pMD, typeToken, typeAttrNames))
         {
             excludeTypeTokens.emplace(typeToken);
+            SetUserCodeMethod(userCodeMethods, methodToken, false);
         }
         else if (HasAttribute(pMD, methodToken, methodAttrNames))
         {
             excludeTokens.push_back(methodToken);
+            SetUserCodeMethod(userCodeMethods, methodToken, false);
         }
+        else
+            SetUserCodeMethod(userCodeMethods, methodToken, true);
     }
     std::copy(excludeTypeTokens.begin(), excludeTypeTokens.end(), std::back_inserter(excludeTokens));
 
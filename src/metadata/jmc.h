@@ -8,11 +8,17 @@
 #include "cordebug.h"
 
 #include <unordered_set>
+#include <vector>
 
 namespace netcoredbg
 {
 
-HRESULT DisableJMCByAttributes(ICorDebugModule *pModule);
-HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens);
+// userCodeMethods - bitmap indexed by methodDef RID, true in case method is user code (not marked by "non user code" attributes).
+HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, std::vector<bool> &userCodeMethods);
+HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens, std::vector<bool> &userCodeMethods);
+// Same bitmap as DisableJMCByAttributes() provide, but metadata is read only, methods JMC status is not changed.
+HRESULT GetUserCodeMethods(ICorDebugModule *pModule, std::vector<bool> &userCodeMethods);
+// Note, methods out of bitmap are not user code (module without symbols have empty bitmap).
+bool IsUserCodeMethod(const std::vector<bool> &userCodeMethods, mdMethodDef methodDef);
 
 } // namespace netcoredbg
@@ -13,6 +13,7 @@
 #include "metadata/typeprinter.h"
 #include "metadata/jmc.h"
 #include "utils/filesystem.h"
+#include "utils/timeline.h"
 
 namespace netcoredbg
 {
@@ -244,6 +245,25 @@ HRESULT Modules::GetModuleInfo(CORDB_ADDRESS modAddress, ModuleInfoCallback cb)
     return (info_pair == m_modulesInfo.end()) ? E_FAIL : cb(info_pair->second);
 }
 
+bool Modules::IsUserCodeMethod(CORDB_ADDRESS modAddress, mdMethodDef methodToken)
+{
+    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
+    auto info_pair = m_modulesInfo.find(modAddress);
+    if (info_pair == m_modulesInfo.end())
+        return false;
+
+    // JMC was enabled after module load, build bitmap once (metadata read only).
+    ModuleInfo &mdInfo = info_pair->second;
+    if (mdInfo.m_userCodeMethodsDelayed)
+    {
+        mdInfo.m_userCodeMethodsDelayed = false;
+        if (FAILED(GetUserCodeMethods(mdInfo.m_iCorModule, mdInfo.m_userCodeMethods)))
+            mdInfo.m_userCodeMethods.clear();
+    }
+
+    return netcoredbg::IsUserCodeMethod(mdInfo.m_userCodeMethods, methodToken);
+}
+
 // Caller must care about m_modulesInfoMutex.
 HRESULT Modules::GetModuleInfo(CORDB_ADDRESS modAddress, ModuleInfo **ppmdInfo)
 {
@@ -522,6 +542,7 @@ static HRESULT LoadSymbols(IMetaDataImport *pMD, ICorDebugModule *pModule, VOID
 
 HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module, bool needJMC, bool needHotReload, std::string &outputText)
 {
+    Timeline::Scope timelineScope("TryLoadModuleSymbols", "symbols");
     HRESULT Status;
 
     ToRelease<IUnknown> pMDUnknown;
@@ -531,8 +552,12 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
 
     module.path = GetModuleFileName(pModule);
     module.name = GetFileName(module.path);
+    if (timelineScope.IsEnabled())
+        timelineScope.SetDetail(module.path);
 
     PVOID pSymbolReaderHandle = nullptr;
+    std::vector<bool> userCodeMethods;
+    bool userCodeMethodsDelayed = false;
     LoadSymbols(pMDImport, pModule, &pSymbolReaderHandle);
     module.symbolStatus = pSymbolReaderHandle != nullptr ? SymbolsLoaded : SymbolsNotFound;
 
@@ -560,7 +585,9 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
                 // * DebuggerStepThroughAttribute tells the debugger to step through the code it's applied to, rather than step into the code.
                 // The .NET debugger considers all other code to be user code.
                 if (needJMC)
-                    DisableJMCByAttributes(pModule);
+                    DisableJMCByAttributes(pModule, userCodeMethods);
+                else
+                    userCodeMethodsDelayed = true;
             }
             else if (Status == CORDBG_E_CANT_SET_TO_JMC)
             {
@@ -586,6 +613,8 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
 
     pModule->AddRef();
     ModuleInfo mdInfo { pSymbolReaderHandle, pModule };
+    mdInfo.m_userCodeMethods = std::move(userCodeMethods);
+    mdInfo.m_userCodeMethodsDelayed = userCodeMethodsDelayed;
     std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
     m_modulesInfo.insert(std::make_pair(baseAddress, std::move(mdInfo)));
 
@@ -752,6 +781,13 @@ HRESULT Modules::ResolveBreakpoint(/*in*/ CORDB_ADDRESS modAddress, /*in*/ std::
     return m_modulesSources.ResolveBreakpoint(this, modAddress, filename, fullname_index, sourceLine, resolvedPoints);
 }
 
+HRESULT Modules::GetModuleSequencePoints(CORDB_ADDRESS modAddress, std::vector<ModulesSources::module_sp_t> &sequencePoints)
+{
+    // Note, in all code we use m_modulesInfoMutex > m_sourcesInfoMutex lock sequence.
+    std::lock_guard<std::mutex> lockModulesInfo(m_modulesInfoMutex);
+    return m_modulesSources.GetModuleSequencePoints(this, modAddress, sequencePoints);
+}
+
 HRESULT Modules::ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
                                              const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens)
 {
@@ -31,9 +31,15 @@ struct ModuleInfo
     ToRelease<ICorDebugModule> m_iCorModule;
     // Cache for LineUpdates data for all methods in this module (Hot Reload related).
     method_block_updates_t m_methodBlockUpdates;
+    // JMC user code bitmap indexed by methodDef RID (empty in case JMC disabled or module without symbols).
+    std::vector<bool> m_userCodeMethods;
+    // Module loaded with JMC disabled, but runtime JMC status was set for module, bitmap could be built on demand
+    // in case JMC will be enabled (see Modules::IsUserCodeMethod()).
+    bool m_userCodeMethodsDelayed;
 
     ModuleInfo(PVOID Handle, ICorDebugModule *Module) :
-        m_iCorModule(Module)
+        m_iCorModule(Module),
+        m_userCodeMethodsDelayed(false)
     {
         if (Handle == nullptr)
             return;
@@ -44,7 +50,9 @@ struct ModuleInfo
 
     ModuleInfo(ModuleInfo&& other) noexcept :
         m_symbolReaderHandles(std::move(other.m_symbolReaderHandles)),
-        m_iCorModule(std::move(other.m_iCorModule))
+        m_iCorModule(std::move(other.m_iCorModule)),
+        m_userCodeMethods(std::move(other.m_userCodeMethods)),
+        m_userCodeMethodsDelayed(other.m_userCodeMethodsDelayed)
     {
     }
     ModuleInfo(const ModuleInfo&) = delete;
@@ -73,6 +81,7 @@ public:
         /*in*/ int sourceLine,
         /*out*/ std::vector<ModulesSources::resolved_bp_t> &resolvedPoints);
 
+    HRESULT GetModuleSequencePoints(CORDB_ADDRESS modAddress, std::vector<ModulesSources::module_sp_t> &sequencePoints);
     HRESULT GetSourceFullPathByIndex(unsigned index, std::string &fullPath);
     HRESULT GetIndexBySourceFullPath(std::string fullPath, unsigned &index);
     HRESULT ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
@@ -85,6 +94,8 @@ public:
     typedef std::function<HRESULT(ModuleInfo &)> ModuleInfoCallback;
     HRESULT GetModuleInfo(CORDB_ADDRESS modAddress, ModuleInfoCallback cb);
     HRESULT GetModuleInfo(CORDB_ADDRESS modAddress, ModuleInfo **ppmdInfo);
+    // Fast JMC check by module user code bitmap, no metadata and symbols access.
+    bool IsUserCodeMethod(CORDB_ADDRESS modAddress, mdMethodDef methodToken);
 
     HRESULT GetFrameILAndSequencePoint(
         ICorDebugFrame *pFrame,
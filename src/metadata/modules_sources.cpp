@@ -322,6 +322,7 @@ HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule,
         m_sourcesMethodsData[fullPathIndex].emplace_back(FileMethodsData{});
         auto &fileMethodsData = m_sourcesMethodsData[fullPathIndex].back();
         fileMethodsData.modAddress = modAddress;
+        m_moduleSourcesIndex.Add(modAddress, fullPathIndex);
 
         // Note, don't reorder input data, since it have almost ideal order for us.
         // For example, for Private.CoreLib (about 22000 methods) only 8 relocations were made.
@@ -517,6 +518,7 @@ HRESULT ModulesSources::UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule
             m_sourcesMethodsData[fullPathIndex].emplace_back(FileMethodsData{});
             auto &tmpFileMethodsData = m_sourcesMethodsData[fullPathIndex].back();
             tmpFileMethodsData.modAddress = modAddress;
+            m_moduleSourcesIndex.Add(modAddress, fullPathIndex);
 
             for (int j = 0; j < updateData.second.methodNum; j++)
             {
@@ -940,7 +942,7 @@ HRESULT ModulesSources::ApplyPdbDeltaAndLineUpdates(Modules *pModules, ICorDebug
             return S_OK;
 
         if (needJMC && !methodTokens.empty())
-            DisableJMCByAttributes(pModule, methodTokens);
+            DisableJMCByAttributes(pModule, methodTokens, mdInfo.m_userCodeMethods);
 
         ToRelease<IUnknown> pMDUnknown;
         IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
@@ -1029,4 +1031,66 @@ void ModulesSources::FindFileNames(Utility::string_view pattern, unsigned limit,
     }
 }
 
+// Caller must care about m_modulesInfoMutex.
+// Note, all not hidden sequence points of initial code version for all methods with source data are provided (ordered by method token),
+// this is all executable code lines of module.
+HRESULT ModulesSources::GetModuleSequencePoints(Modules *pModules, CORDB_ADDRESS modAddress, std::vector<module_sp_t> &sequencePoints)
+{
+    std::lock_guard<std::mutex> lockSourcesInfo(m_sourcesInfoMutex);
+
+    std::set<mdMethodDef> methodTokens;
+    for (const unsigned fullPathIndex : m_moduleSourcesIndex.Get(modAddress))
+    {
+        for (const auto &sourceData : m_sourcesMethodsData[fullPathIndex])
+        {
+            if (sourceData.modAddress != modAddress)
+                continue;
+
+            for (const auto &nestedLevel : sourceData.methodsData)
+            {
+                for (const auto &methodData : nestedLevel)
+                {
+                    methodTokens.insert(methodData.methodDef);
+                }
+            }
+            for (const auto &multiData : sourceData.multiMethodsData)
+            {
+                methodTokens.insert(multiData.second.begin(), multiData.second.end());
+            }
+        }
+    }
+
+    if (methodTokens.empty())
+        return S_FALSE;
+
+    HRESULT Status;
+    ModuleInfo *pmdInfo; // Note, pmdInfo must be covered by m_modulesInfoMutex.
+    IfFailRet(pModules->GetModuleInfo(modAddress, &pmdInfo));
+    if (pmdInfo->m_symbolReaderHandles.empty())
+        return E_FAIL;
+
+    for (auto methodToken : methodTokens)
+    {
+        Interop::SequencePoint *symSequencePoints = nullptr;
+        int32_t count = 0;
+        Status = Interop::GetSequencePoints(pmdInfo->m_symbolReaderHandles[0], methodToken, &symSequencePoints, count);
+
+        for (int32_t i = 0; i < count; i++)
+        {
+            unsigned fullPathIndex;
+            if (SUCCEEDED(Status) && symSequencePoints[i].startLine != Interop::HiddenLine &&
+                SUCCEEDED(GetFullPathIndex(symSequencePoints[i].document, fullPathIndex)))
+            {
+                sequencePoints.emplace_back(methodToken, (uint32_t)symSequencePoints[i].offset, fullPathIndex, symSequencePoints[i].startLine);
+            }
+            Interop::SysFreeString(symSequencePoints[i].document);
+        }
+
+        if (symSequencePoints)
+            Interop::CoTaskMemFree(symSequencePoints);
+    }
+
+    return S_OK;
+}
+
 } // namespace netcoredbg
@@ -13,6 +13,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
+#include "metadata/modules_sources_index.h"
 #include "utils/string_view.h"
 #include "utils/torelease.h"
 
@@ -149,6 +150,21 @@ public:
         {}
     };
 
+    struct module_sp_t
+    {
+        mdMethodDef methodToken;
+        uint32_t ilOffset;
+        unsigned fullPathIndex;
+        int32_t startLine;
+
+        module_sp_t(mdMethodDef methodToken_, uint32_t ilOffset_, unsigned fullPathIndex_, int32_t startLine_) :
+            methodToken(methodToken_),
+            ilOffset(ilOffset_),
+            fullPathIndex(fullPathIndex_),
+            startLine(startLine_)
+        {}
+    };
+
     HRESULT ResolveBreakpoint(
         /*in*/ Modules *pModules,
         /*in*/ CORDB_ADDRESS modAddress,
@@ -164,6 +180,7 @@ public:
                                         const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens);
 
     void FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
+    HRESULT GetModuleSequencePoints(Modules *pModules, CORDB_ADDRESS modAddress, std::vector<module_sp_t> &sequencePoints);
 
 private:
 
@@ -189,6 +206,8 @@ private:
     // m_sourcesMethodsData - all methods data indexed by full path, second vector hold data with same full path for different modules,
     //                        since we may have modules with same source full path
     std::vector<std::vector<FileMethodsData>> m_sourcesMethodsData;
+    // m_moduleSourcesIndex - full paths indexes in m_sourcesMethodsData with module's data
+    ModuleSourcesIndex m_moduleSourcesIndex;
 
     HRESULT GetFullPathIndex(BSTR document, unsigned &fullPathIndex);
     HRESULT UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, std::unordered_set<mdMethodDef> methodTokens,
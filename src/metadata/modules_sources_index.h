@@ -0,0 +1,40 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+
+namespace netcoredbg
+{
+
+// Source files (full path indexes) with methods data for each module, allow get module's sources data
+// without scan of all sources of all loaded modules.
+class ModuleSourcesIndex
+{
+public:
+
+    typedef std::set<unsigned> FullPathIndexes;
+
+    void Add(uint64_t modAddress, unsigned fullPathIndex)
+    {
+        m_moduleSources[modAddress].insert(fullPathIndex);
+    }
+
+    // Return empty set in case module don't have sources.
+    const FullPathIndexes &Get(uint64_t modAddress) const
+    {
+        static const FullPathIndexes empty;
+        auto find = m_moduleSources.find(modAddress);
+        return find == m_moduleSources.end() ? empty : find->second;
+    }
+
+private:
+
+    std::unordered_map<uint64_t, FullPathIndexes> m_moduleSources;
+};
+
+} // namespace netcoredbg
@@ -38,6 +38,7 @@
 #include "utils/string_view.h"
 #include "utils/span.h"
 #include "utils/logger.h"
+#include "utils/timeline.h"
 #include "tokenizer.h"
 
 #include "tty.h"
@@ -110,12 +111,18 @@ enum class CLIProtocol::CommandTag
     SetArgs,
     SetJustMyCode,
     SetStepFiltering,
+    SetAsyncCallStack,
+    SetCollapseExternalCode,
+    SetCoverageOutput,
     SetHelp,
 
     // info subcommand
     Info,
     InfoThreads,
     InfoBreakpoints,
+    InfoTasks,
+    InfoHeap,
+    InfoGCRoots,
     InfoHelp,
 
     // save subcommand
@@ -123,10 +130,26 @@ enum class CLIProtocol::CommandTag
     SaveBreakpoints,
     SaveHelp,
 
+    // profile subcommand
+    Profile,
+    ProfileStart,
+    ProfileStop,
+    ProfileHelp,
+
+    // trace subcommand
+    Trace,
+    TraceAdd,
+    TraceStart,
+    TraceStop,
+    TraceRead,
+    TraceHelp,
+
     // help subcommands
     HelpInfo,
     HelpSet,
     HelpSave,
+    HelpProfile,
+    HelpTrace,
 
     // These two definitons should end command list.
     CommandsCount,  // Total number of the commands.
@@ -172,11 +195,41 @@ constexpr static const CLIParams::CommandInfo save_commands[] =
     {CommandTag::End, {}, {}, {}, {}}
 };
 
+// Subcommands for "profile" command.
+constexpr static const CLIParams::CommandInfo profile_commands[] =
+{
+    {CommandTag::ProfileStart,   {}, {}, {{"start"}}, {"[interval-ms]", "Start sampling of managed stacks of all threads."}},
+    {CommandTag::ProfileStop,    {}, {}, {{"stop"}}, {"[file]", "Stop sampling and show most frequent stacks or save\n"
+                                                                 "all stacks to the file in folded format (for flame graph)."}},
+    {CommandTag::ProfileHelp,    {}, {}, {{"help"}}, {{}, {}}},
+
+    // This should be placed at end of command (sub)lists.
+    {CommandTag::End, {}, {}, {}, {}}
+};
+
+// Subcommands for "trace" command.
+constexpr static const CLIParams::CommandInfo trace_commands[] =
+{
+    {CommandTag::TraceAdd,       {}, {}, {{"add"}}, {"<file:line> <expr>[; <expr>...]", "Set tracepoint, that record expressions values\n"
+                                                                                      "at hit without program stop."}},
+    {CommandTag::TraceStart,     {}, {}, {{"start"}}, {"<file>", "Start tracepoints hits recording to the file."}},
+    {CommandTag::TraceStop,      {}, {}, {{"stop"}}, {{}, "Stop tracepoints hits recording."}},
+    {CommandTag::TraceRead,      {}, {}, {{"read"}}, {"<file> [tracepoint-id [count]]", "Show trace file summary and first records."}},
+    {CommandTag::TraceHelp,      {}, {}, {{"help"}}, {{}, {}}},
+
+    // This should be placed at end of command (sub)lists.
+    {CommandTag::End, {}, {}, {}, {}}
+};
+
 // Subcommands for "info" command.
 constexpr static const CLIParams::CommandInfo info_commands[] =
 {
     {CommandTag::InfoThreads,    {}, {}, {{"threads"}}, {{}, "Display currently known threads."}},
     {CommandTag::InfoBreakpoints,{}, {}, {{"breakpoints", "break"}}, {{}, "Display existing breakpoints."}},
+    {CommandTag::InfoTasks,      {}, {}, {{"tasks"}}, {{}, "Display not completed async tasks grouped by logical call stack."}},
+    {CommandTag::InfoGCRoots,    {}, {}, {{"gcroots"}}, {"<expression>", "Display shortest reference chains from GC roots to object."}},
+    {CommandTag::InfoHeap,       {}, {}, {{"heap"}}, {"[base-snapshot]", "Display managed heap statistics per type (biggest types only),\n"
+                                                                         "compared with base snapshot if provided."}},
     {CommandTag::InfoHelp,       {}, {}, {{"help"}}, {{}, {}}},
 
     // This should be placed at end of command (sub)lists.
@@ -198,6 +251,18 @@ constexpr static const CLIParams::CommandInfo set_commands[] =
             {{"1 or 0"},  "Prevent or allow stepping into properties and operators\n"
                           "in managed code."}},
 
+    {CommandTag::SetAsyncCallStack, {}, {}, {{"async-call-stack"}},
+            {{"1 or 0"},  "Enable or disable async methods, that await current async\n"
+                          "method, in backtrace."}},
+
+    {CommandTag::SetCollapseExternalCode, {}, {}, {{"collapse-external-code"}},
+            {{"1 or 0"},  "Enable or disable collapsing of non user code frames into\n"
+                          "one '[External Code]' frame in backtrace (Just My Code only)."}},
+
+    {CommandTag::SetCoverageOutput, {}, {}, {{"coverage-output"}},
+            {{"file"},    "Collect line coverage and write report to file at program\n"
+                          "exit (Cobertura for '.xml' file, lcov otherwise)."}},
+
     {CommandTag::SetHelp, {}, {}, {{"help"}}, {{}, {}}},
 
     // This should be placed at end of command (sub)lists.
@@ -210,6 +275,8 @@ constexpr static const CLIParams::CommandInfo help_commands[] =
     {CommandTag::HelpInfo, {}, {},  {{"info"}}, {{}, {}}},
     {CommandTag::HelpSet,  {}, {},  {{"set"}},  {{}, {}}},
     {CommandTag::HelpSave, {}, {},  {{"save"}}, {{}, {}}},
+    {CommandTag::HelpProfile, {}, {},  {{"profile"}}, {{}, {}}},
+    {CommandTag::HelpTrace, {}, {},  {{"trace"}}, {{}, {}}},
 
     // This should be placed at end of command (sub)lists.
     {CommandTag::End, {}, {}, {}, {}}
@@ -302,6 +369,12 @@ constexpr static const CLIParams::CommandInfo commands_list[] =
     {CommandTag::Save, save_commands, {}, {{"save"}},
         {"args...", "Save misc. things to the files."}},
 
+    {CommandTag::Profile, profile_commands, {}, {{"profile"}},
+        {"args...", "Sample managed stacks of running program (see 'help profile')."}},
+
+    {CommandTag::Trace, trace_commands, {}, {{"trace"}},
+        {"args...", "Record tracepoints hits without program stop (see 'help trace')."}},
+
     {CommandTag::Help, help_commands, {}, {{"help"}},
         {"[topic]", "Show help on specified topic or print\n"
                     "this help message (if no argument specified)."}},
@@ -323,6 +396,8 @@ constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::h
 constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::info_commands[];
 constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::set_commands[];
 constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::save_commands[];
+constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::profile_commands[];
+constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::trace_commands[];
 
 // instantiate cli_helper class which allows to parse command line, dispatch
 // appropriate command or perform command completons
@@ -750,7 +825,7 @@ HRESULT CLIProtocol::PrintFrames(ThreadId threadId, std::string &output, FrameLe
     int totalFrames = 0;
     std::vector<StackFrame> stackFrames;
     
-    IfFailRet(m_sharedDebugger->GetStackTrace(threadId, lowFrame, int(highFrame) - int(lowFrame), stackFrames, totalFrames));
+    IfFailRet(m_sharedDebugger->GetStackTrace(threadId, lowFrame, int(highFrame) - int(lowFrame), stackFrames, totalFrames, false, m_commandToken));
 
     if (stackFrames.size() == 0)
     {
@@ -798,6 +873,7 @@ void CLIProtocol::Cleanup()
 void CLIProtocol::EmitStoppedEvent(const StoppedEvent &event)
 {
     LogFuncEntry();
+    Timeline::Instant("StoppedEvent", "event");
 
     // call repaint() at function exit
     std::unique_ptr<void, std::function<void(void*)> >
@@ -1682,6 +1758,177 @@ HRESULT CLIProtocol::doCommand<CommandTag::InfoThreads>(const std::string &, con
 }
 
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoTasks>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    {
+      lock_guard lock(m_mutex);
+
+      if (m_processStatus == NotStarted || m_processStatus == Exited)
+      {
+          output = "No process.";
+          return E_FAIL;
+      }
+    }
+
+    std::vector<AsyncTaskGroup> taskGroups;
+    if (FAILED(m_sharedDebugger->GetAsyncTasks(taskGroups)))
+    {
+        output = "Can't get async tasks.";
+        return E_FAIL;
+    }
+    if (taskGroups.empty())
+    {
+        output = "No async tasks.";
+        return S_OK;
+    }
+    std::ostringstream ss;
+
+    ss << "Async tasks:";
+
+    int number = 1;
+    for (const AsyncTaskGroup &group : taskGroups)
+    {
+        ss << "\n" << number << ": count=\"" << group.count << "\"";
+        for (const AsyncTask &task : group.tasks)
+        {
+            ss << "\n    task " << ProtocolUtils::AddrToString(std::uintptr_t(task.address)) << " " << task.status;
+            if (task.awaitedTask != 0)
+                ss << ", await " << ProtocolUtils::AddrToString(std::uintptr_t(task.awaitedTask));
+        }
+        if (group.tasks.size() < group.count)
+            ss << "\n    ...";
+
+        int currentFrame = 0;
+        for (const StackFrame &stackFrame : group.stackFrames)
+        {
+            ss << "\n    #" << currentFrame << ":";
+            if (!stackFrame.moduleOrLibName.empty())
+                ss << " " << stackFrame.moduleOrLibName << "`";
+
+            std::string frameLocation;
+            PrintFrameLocation(stackFrame, frameLocation);
+            ss << " " << frameLocation;
+            currentFrame++;
+        }
+        number++;
+    }
+    output = ss.str();
+    return S_OK;
+}
+
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoGCRoots>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    FrameId frameId;
+    {
+      lock_guard lock(m_mutex);
+
+      if (m_processStatus == NotStarted || m_processStatus == Exited)
+      {
+          output = "No process.";
+          return E_FAIL;
+      }
+
+      frameId = FrameId(m_sharedDebugger->GetLastStoppedThreadId(), FrameLevel{m_frameIdx});
+    }
+
+    if (args.empty())
+    {
+        output = "Expression required.";
+        return E_INVALIDARG;
+    }
+
+    std::string expression;
+    for (const std::string &arg : args)
+    {
+        if (!expression.empty())
+            expression += " ";
+        expression += arg;
+    }
+
+    HRESULT Status;
+    Variable variable(0);
+    IfFailRet(m_sharedDebugger->Evaluate(frameId, expression, variable, output));
+    if (variable.variablesReference == 0)
+    {
+        output = "Expression result is not heap object.";
+        return E_FAIL;
+    }
+
+    std::vector<GCRootPath> paths;
+    if (FAILED(m_sharedDebugger->GetGCRootPaths(variable.variablesReference, 10, paths)) || paths.empty())
+    {
+        output = "No GC root paths found.";
+        return E_FAIL;
+    }
+
+    std::ostringstream ss;
+    ss << "GC root paths:";
+    int number = 1;
+    for (const GCRootPath &path : paths)
+    {
+        ss << "\n" << number << ": " << path.rootKind;
+        for (const GCRootPathObject &object : path.objects)
+        {
+            ss << "\n    -> " << ProtocolUtils::AddrToString(std::uintptr_t(object.address)) << " " << object.typeName;
+        }
+        number++;
+    }
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoHeap>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    {
+      lock_guard lock(m_mutex);
+
+      if (m_processStatus == NotStarted || m_processStatus == Exited)
+      {
+          output = "No process.";
+          return E_FAIL;
+      }
+    }
+
+    int baseSnapshotId = 0;
+    if (!args.empty())
+    {
+        bool ok;
+        baseSnapshotId = ProtocolUtils::ParseInt(args[0], ok);
+        if (!ok || baseSnapshotId <= 0)
+            return E_INVALIDARG;
+    }
+
+    HeapStats heapStats;
+    if (FAILED(m_sharedDebugger->GetHeapStats(uint32_t(baseSnapshotId), heapStats)))
+    {
+        output = "Can't collect heap statistics.";
+        return E_FAIL;
+    }
+
+    // Show only biggest types, full list could have thousands of types.
+    const size_t MaxTypes = 30;
+    std::ostringstream ss;
+    ss << "Heap snapshot " << heapStats.snapshotId << ": " << heapStats.totalCount << " objects, " << heapStats.totalSize << " bytes";
+    if (heapStats.baseSnapshotId != 0)
+        ss << " (compared with snapshot " << heapStats.baseSnapshotId << ")";
+
+    for (size_t i = 0; i < heapStats.types.size() && i < MaxTypes; i++)
+    {
+        const HeapTypeStats &typeStats = heapStats.types[i];
+        ss << "\n" << std::setw(12) << typeStats.size << " " << std::setw(10) << typeStats.count;
+        if (heapStats.baseSnapshotId != 0)
+            ss << " " << std::showpos << std::setw(12) << typeStats.sizeDiff << " " << std::setw(10) << typeStats.countDiff << std::noshowpos;
+        ss << "  " << typeStats.typeName;
+    }
+    output = ss.str();
+    return S_OK;
+}
+
+
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::InfoBreakpoints>(const std::string &, const std::vector<std::string>& args, std::string& output)
 {
@@ -1930,7 +2177,7 @@ HRESULT CLIProtocol::PrintVariable(const Variable &v, std::ostringstream &ss, bo
         else
             ss << v.name << " = " << v.value << ": {";
 
-        m_sharedDebugger->GetVariables(v.variablesReference, VariablesBoth, 0, v.namedVariables, children);
+        m_sharedDebugger->GetVariables(v.variablesReference, VariablesBoth, 0, v.namedVariables, children, m_commandToken);
         for (auto &child : children)
         {
             bool stm = (child.name == "Static members") ? true : false;
@@ -2218,6 +2465,220 @@ HRESULT CLIProtocol::doCommand<CommandTag::SaveHelp>(const std::string &, const
 }
 
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::Profile>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    printf("Argument(s) required: see 'help profile' for details.\n");
+    return S_FALSE;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::ProfileStart>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    {
+      lock_guard lock(m_mutex);
+
+      if (m_processStatus == NotStarted || m_processStatus == Exited)
+      {
+          output = "No process.";
+          return E_FAIL;
+      }
+    }
+
+    int intervalMs = 0;
+    if (!args.empty())
+    {
+        bool ok;
+        intervalMs = ProtocolUtils::ParseInt(args[0], ok);
+        if (!ok || intervalMs <= 0)
+            return E_INVALIDARG;
+    }
+
+    if (FAILED(m_sharedDebugger->StartSampling(unsigned(intervalMs))))
+    {
+        output = "Can't start sampling.";
+        return E_FAIL;
+    }
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::ProfileStop>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    SamplingResult result;
+    if (FAILED(m_sharedDebugger->StopSampling(result)))
+    {
+        output = "Sampling was not started.";
+        return E_FAIL;
+    }
+
+    std::ostringstream ss;
+    ss << result.samples << " samples (" << result.skippedSamples << " skipped), pause avg "
+       << (result.samples != 0 ? result.totalPauseUs / result.samples : 0) << " us, max " << result.maxPauseUs << " us";
+
+    if (!args.empty())
+    {
+        if (FAILED(ProtocolUtils::WriteFoldedStacks(args[0], result.stacks)))
+        {
+            output = "Can't write file '" + args[0] + "'.";
+            return E_FAIL;
+        }
+        output = ss.str();
+        return S_OK;
+    }
+
+    // Show only most frequent stacks, full list could be saved into file.
+    const size_t MaxStacks = 10;
+    for (size_t i = 0; i < result.stacks.size() && i < MaxStacks; i++)
+    {
+        ss << "\n" << std::setw(8) << result.stacks[i].count << "  " << result.stacks[i].frames;
+    }
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::ProfileHelp>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    printHelp(CommandsList::profile_commands, args.empty() ? string_view{} : string_view{args[0]});
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::Trace>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    printf("Argument(s) required: see 'help trace' for details.\n");
+    return S_FALSE;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::TraceAdd>(const std::string &input, const std::vector<std::string> &args, std::string &output)
+{
+    if (args.size() < 2)
+    {
+        output = "Command usage: trace add <file:line> <expr>[; <expr>...]";
+        return E_INVALIDARG;
+    }
+
+    const std::string::size_type delimiter = args[0].rfind(':');
+    bool ok = false;
+    const int linenum = delimiter == std::string::npos ? 0 : ProtocolUtils::ParseInt(args[0].substr(delimiter + 1), ok);
+    if (!ok || linenum <= 0)
+    {
+        output = "Unknown tracepoint location format";
+        return E_INVALIDARG;
+    }
+
+    // Expressions are taken from initial input, since expression could have spaces inside.
+    std::vector<std::string> traceExpressions;
+    std::string expressions = input.substr(input.find(args[0]) + args[0].size());
+    for (std::string::size_type start = 0; start < expressions.size();)
+    {
+        std::string::size_type end = expressions.find(';', start);
+        if (end == std::string::npos)
+            end = expressions.size();
+
+        std::string expression = expressions.substr(start, end - start);
+        expression.erase(0, expression.find_first_not_of(" \t"));
+        expression.erase(expression.find_last_not_of(" \t") + 1);
+        if (!expression.empty())
+            traceExpressions.emplace_back(std::move(expression));
+
+        start = end + 1;
+    }
+    if (traceExpressions.empty())
+        return E_INVALIDARG;
+
+    LineBreakpoint lineBreakpoint(std::string(), linenum);
+    lineBreakpoint.traceExpressions = std::move(traceExpressions);
+
+    Breakpoint breakpoint;
+    HRESULT Status;
+    IfFailRet(m_breakpointsHandle.SetLineBreakpoint(m_sharedDebugger, args[0].substr(0, delimiter), lineBreakpoint, breakpoint));
+    PrintBreakpoint(breakpoint, output);
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::TraceStart>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    if (args.size() != 1)
+        return E_INVALIDARG;
+
+    if (FAILED(m_sharedDebugger->StartTraceRecording(args[0])))
+    {
+        output = "Can't start trace recording to '" + args[0] + "'.";
+        return E_FAIL;
+    }
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::TraceStop>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    TraceRecordingStats stats;
+    if (FAILED(m_sharedDebugger->StopTraceRecording(stats)))
+    {
+        output = "Trace recording was not started.";
+        return E_FAIL;
+    }
+
+    std::ostringstream ss;
+    ss << stats.records << " records (" << stats.lostRecords << " lost), " << stats.bytes << " bytes, "
+       << (stats.durationUs != 0 ? stats.records * 1000000 / stats.durationUs : 0) << " records/s";
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::TraceRead>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    if (args.empty() || args.size() > 3)
+        return E_INVALIDARG;
+
+    bool ok = true;
+    const int tracepointId = args.size() > 1 ? ProtocolUtils::ParseInt(args[1], ok) : 0;
+    if (!ok || tracepointId < 0)
+        return E_INVALIDARG;
+
+    const int count = args.size() > 2 ? ProtocolUtils::ParseInt(args[2], ok) : 20;
+    if (!ok || count < 0)
+        return E_INVALIDARG;
+
+    TraceSummary summary;
+    if (FAILED(m_sharedDebugger->ReadTrace(args[0], uint32_t(tracepointId), unsigned(count), summary)))
+    {
+        output = "Can't read trace file '" + args[0] + "'.";
+        return E_FAIL;
+    }
+
+    std::ostringstream ss;
+    ss << summary.hits << " hits";
+    for (const auto &tracepoint : summary.tracepoints)
+    {
+        ss << "\n#" << tracepoint.id << " " << tracepoint.location << ": " << tracepoint.hits << " hits, "
+           << tracepoint.threads << " threads, " << tracepoint.firstTimeUs << "-" << tracepoint.lastTimeUs << " us";
+    }
+    for (const auto &record : summary.records)
+    {
+        ss << "\n" << std::setw(12) << record.timeUs << " us  #" << record.tracepointId << " thread " << record.threadId << ":";
+        for (const auto &value : record.values)
+        {
+            ss << " " << value;
+        }
+    }
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::TraceHelp>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    printHelp(CommandsList::trace_commands, args.empty() ? string_view{} : string_view{args[0]});
+    return S_OK;
+}
+
+
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::SetArgs>(const std::string &, const std::vector<std::string> &args, std::string &output)
 {
@@ -2246,6 +2707,35 @@ HRESULT CLIProtocol::doCommand<CommandTag::SetStepFiltering>(const std::string &
     return S_OK;
 }
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::SetAsyncCallStack>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    if (args.empty() || (args[0] != "0" && args[0] != "1"))
+        return E_INVALIDARG;
+
+    m_sharedDebugger->SetAsyncCallStack(args[0] == "1");
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::SetCollapseExternalCode>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    if (args.empty() || (args[0] != "0" && args[0] != "1"))
+        return E_INVALIDARG;
+
+    m_sharedDebugger->SetCollapseExternalCode(args[0] == "1");
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::SetCoverageOutput>(const std::string &, const std::vector<std::string> &args, std::string &output)
+{
+    if (args.size() != 1)
+        return E_INVALIDARG;
+
+    return m_sharedDebugger->SetCodeCoverage(args[0]);
+}
+
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::SetHelp>(const std::string &, const std::vector<std::string> &args, std::string &output)
 {
@@ -2271,6 +2761,18 @@ HRESULT CLIProtocol::doCommand<CommandTag::HelpSave>(const std::string &input, c
     return doCommand<CommandTag::SaveHelp>(input, args, output);
 }
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::HelpProfile>(const std::string &input, const std::vector<std::string> &args, std::string &output)
+{
+    return doCommand<CommandTag::ProfileHelp>(input, args, output);
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::HelpTrace>(const std::string &input, const std::vector<std::string> &args, std::string &output)
+{
+    return doCommand<CommandTag::TraceHelp>(input, args, output);
+}
+
 
 // This function tries to complete command `str`, where the cursor position is `cursor`:
 // functor `func` will be called for each possible completion variant.
@@ -2606,8 +3108,14 @@ HRESULT CLIProtocol::execCommands(LineReader&& lr, bool printCommands)
             while (tokenizer.Next(result))
                args.push_back(result);
 
+            {
+                std::lock_guard<std::mutex> lock(g_console_mutex);
+                m_commandToken = CancellationToken::Create();
+            }
             hr = (this->*func)(str, args, output);
             have_result = true;
+            if (FAILED(hr) && output.empty() && m_commandToken.IsCanceled())
+                output = "The operation was canceled.";
         };
 
         LOGD("executing: '%.*s'", int(input.size()), input.data());
@@ -2780,7 +3288,11 @@ void CLIProtocol::interruptHandler()
 {
     std::lock_guard<std::mutex> lock(g_console_mutex);
     if (g_console_owner)
+    {
+        // Cancel long command (stack trace or variables output), in case it executed now.
+        g_console_owner->m_commandToken.Cancel();
         g_console_owner->Pause();
+    }
 }
 
 void CLIProtocol::removeInterruptHandler()
@@ -18,6 +18,7 @@
 #include "utils/string_view.h"
 #include "utils/streams.h"
 #include "utils/span.h"
+#include "utils/cancellation.h"
 #include "sourcestorage.h"
 
 namespace netcoredbg
@@ -230,7 +231,10 @@ private:
 
     // CLIProtocol instance currently owning console
     static CLIProtocol* g_console_owner;
-    static std::mutex g_console_mutex; // mutex which protect g_console_owner
+    static std::mutex g_console_mutex; // mutex which protect g_console_owner and m_commandToken
+
+    // Token of executed command, canceled by Ctrl-C (long stack trace or variables output).
+    CancellationToken m_commandToken;
 
     // process Ctrl-C events
     static void interruptHandler();
@@ -16,6 +16,7 @@
 #include <iomanip>
 
 #include "utils/logger.h"
+#include "utils/timeline.h"
 
 namespace netcoredbg
 {
@@ -23,7 +24,22 @@ namespace netcoredbg
 extern template class EscapedString<MIProtocol::MIProtocolChars>;
 extern template std::ostream& operator<<(std::ostream&, const EscapedString<MIProtocol::MIProtocolChars>&);
 
+namespace
+{
+    // Session data for command handlers. Note, commands map is static and shared by all sessions (multi-session server),
+    // so, handlers must not capture session data.
+    struct CommandContext
+    {
+        std::shared_ptr<IDebugger> &sharedDebugger;
+        BreakpointsHandle &breakpointsHandle;
+        MIProtocol::VariablesHandle &variablesHandle;
+        std::string &fileExec;
+        std::vector<std::string> &execArgs;
+    };
+} // unnamed namespace
+
 typedef std::function<HRESULT(
+    CommandContext &ctx,
     const std::vector<std::string> &args,
     std::string &output)> CommandCallback;
 
@@ -292,6 +308,56 @@ HRESULT MIProtocol::VariablesHandle::CreateVar(std::shared_ptr<IDebugger> &share
     return PrintNewVar(varobjName, variable, threadId, level, print_values, output);
 }
 
+// Create var objects for all expressions, evaluated for same frame in one call.
+// Var objects names are generated, each failed expression provide `error` field instead of var object data.
+HRESULT MIProtocol::VariablesHandle::CreateVars(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, FrameLevel level,
+                                                int evalFlags, const std::vector<std::string> &expressions, std::string &output)
+{
+    HRESULT Status;
+
+    FrameId frameId(threadId, level);
+    std::vector<IDebugger::EvaluateBatchResult> results;
+    IfFailRet(sharedDebugger->EvaluateBatch(frameId, evalFlags, expressions, results));
+
+    std::ostringstream ss;
+    ss << "vars=[";
+    const char *sep = "";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        IDebugger::EvaluateBatchResult &result = results[i];
+        ss << sep << "{";
+        sep = ",";
+
+        std::string varout;
+        // Note, var object creation failure is reported as expression error, since some var objects already created.
+        int print_values = 1;
+        if (SUCCEEDED(result.status))
+            result.status = PrintNewVar("-", result.variable, threadId, level, print_values, varout);
+
+        if (SUCCEEDED(result.status))
+            ss << varout;
+        else
+        {
+            if (result.output.empty())
+            {
+                char buf[16];
+                snprintf(buf, sizeof(buf), "0x%08x", unsigned(result.status));
+                varout = buf;
+            }
+            else
+                varout = result.output;
+
+            ss << "exp=\"" << MIProtocol::EscapeMIValue(expressions[i]) << "\",";
+            ss << "error=\"" << MIProtocol::EscapeMIValue(varout) << "\"";
+        }
+        ss << "}";
+    }
+    ss << "]";
+    output = ss.str();
+
+    return S_OK;
+}
+
 HRESULT MIProtocol::VariablesHandle::DeleteVar(const std::string &varobjName)
 {
     // Note:
@@ -400,6 +466,7 @@ static void ParseBreakpointIndexes(const std::vector<std::string> &args, std::fu
 void MIProtocol::EmitStoppedEvent(const StoppedEvent &event)
 {
     LogFuncEntry();
+    Timeline::Instant("StoppedEvent", "event");
 
     std::string frameLocation;
     PrintFrameLocation(event.frame, frameLocation);
@@ -542,11 +609,11 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
                              std::string &fileExec, std::vector<std::string> &execArgs, const std::string& command, const std::vector<std::string> &args, std::string &output)
 {
     static std::unordered_map<std::string, CommandCallback> commands {
-    { "thread-info", [&](const std::vector<std::string> &, std::string &output){
+    { "thread-info", [](CommandContext &ctx, const std::vector<std::string> &, std::string &output){
         HRESULT Status = S_OK;
 
         std::vector<Thread> threads;
-        IfFailRet(sharedDebugger->GetThreads(threads));
+        IfFailRet(ctx.sharedDebugger->GetThreads(threads));
 
         std::ostringstream ss;
 
@@ -565,20 +632,20 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         output = ss.str();
         return S_OK;
     } },
-    { "exec-continue", [&](const std::vector<std::string> &, std::string &output){
+    { "exec-continue", [](CommandContext &ctx, const std::vector<std::string> &, std::string &output){
         HRESULT Status;
-        IfFailRet(sharedDebugger->Continue(ThreadId::AllThreads));
-        variablesHandle.Cleanup(); // Important, must be sync with ManagedDebugger m_sharedVariables->Clear()
+        IfFailRet(ctx.sharedDebugger->Continue(ThreadId::AllThreads));
+        ctx.variablesHandle.Cleanup(); // Important, must be sync with ManagedDebugger m_sharedVariables->Clear()
         output = "^running";
         return S_OK;
     } },
-    { "exec-interrupt", [&](const std::vector<std::string> &, std::string &output){
+    { "exec-interrupt", [](CommandContext &ctx, const std::vector<std::string> &, std::string &output){
         HRESULT Status;
-        IfFailRet(sharedDebugger->Pause(ThreadId::AllThreads, EventFormat::Default));
+        IfFailRet(ctx.sharedDebugger->Pause(ThreadId::AllThreads, EventFormat::Default));
         output = "^done";
         return S_OK;
     } },
-    { "break-update-line", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "break-update-line", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         // Custom MI protocol command for line breakpoint update.
         // Command format:
         //    break-update-line ID NEW_LINE
@@ -607,7 +674,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         }
 
         Breakpoint breakpoint;
-        if (SUCCEEDED(breakpointsHandle.UpdateLineBreakpoint(sharedDebugger, id, linenum, breakpoint)))
+        if (SUCCEEDED(ctx.breakpointsHandle.UpdateLineBreakpoint(ctx.sharedDebugger, id, linenum, breakpoint)))
         {
             PrintBreakpoint(breakpoint, output);
             return S_OK;
@@ -616,11 +683,50 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         output = "Unknown breakpoint location, breakpoint was not updated";
         return E_FAIL;
     } },
-    { "break-insert", [&](const std::vector<std::string> &unmutable_args, std::string &output) -> HRESULT {
+    { "break-insert", [](CommandContext &ctx, const std::vector<std::string> &unmutable_args, std::string &output) -> HRESULT {
         HRESULT Status = E_FAIL;
         Breakpoint breakpoint;
         std::vector<std::string> args = unmutable_args;
 
+        // Tracepoint (line breakpoint only), expressions provided by `--trace <expression>` options, could be used few times.
+        std::vector<std::string> traceExpressions;
+        for (auto it = std::find(args.begin(), args.end(), "--trace"); it != args.end() && it + 1 != args.end();
+             it = std::find(args.begin(), args.end(), "--trace"))
+        {
+            traceExpressions.emplace_back(*(it + 1));
+            args.erase(it, it + 2);
+        }
+
+        // Breakpoint filters: `-i <ignore-count>` - skip first hits (line breakpoint only), `-p <thread-id>`,
+        // `--thread-name <name>` - break only in this threads, `--caller-module <module>` - break only in case
+        // method called from this modules. Thread and module options could be used few times.
+        std::string hitCondition;
+        BreakpointFilters filters;
+        for (auto it = args.begin(); it != args.end() && it + 1 != args.end();)
+        {
+            bool ok = true;
+            if (*it == "-i")
+                hitCondition = ">" + std::to_string(ProtocolUtils::ParseInt(*(it + 1), ok));
+            else if (*it == "-p")
+                filters.threadIds.push_back(ProtocolUtils::ParseInt(*(it + 1), ok));
+            else if (*it == "--thread-name")
+                filters.threadNames.push_back(*(it + 1));
+            else if (*it == "--caller-module")
+                filters.callerModules.push_back(*(it + 1));
+            else
+            {
+                ++it;
+                continue;
+            }
+
+            if (!ok)
+            {
+                output = "Wrong " + *it + " option value";
+                return E_INVALIDARG;
+            }
+            it = args.erase(it, it + 2);
+        }
+
         ProtocolUtils::StripArgs(args);
 
         BreakType bt = ProtocolUtils::GetBreakpointType(args);
@@ -635,17 +741,27 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         {
             struct LineBreak lb;
 
-            if (ProtocolUtils::ParseBreakpoint(args, lb)
-                && SUCCEEDED(breakpointsHandle.SetLineBreakpoint(sharedDebugger, lb.module, lb.filename, lb.linenum, lb.condition, breakpoint)))
-                Status = S_OK;
+            if (ProtocolUtils::ParseBreakpoint(args, lb))
+            {
+                LineBreakpoint lineBreakpoint(lb.module, lb.linenum, lb.condition);
+                lineBreakpoint.traceExpressions = traceExpressions;
+                lineBreakpoint.hitCondition = hitCondition;
+                lineBreakpoint.filters = filters;
+                if (SUCCEEDED(ctx.breakpointsHandle.SetLineBreakpoint(ctx.sharedDebugger, lb.filename, lineBreakpoint, breakpoint)))
+                    Status = S_OK;
+            }
         }
         else if (bt == BreakType::FuncBreak)
         {
             struct FuncBreak fb;
 
-            if (ProtocolUtils::ParseBreakpoint(args, fb)
-                && SUCCEEDED(breakpointsHandle.SetFuncBreakpoint(sharedDebugger, fb.module, fb.funcname, fb.params, fb.condition, breakpoint)))
-                Status = S_OK;
+            if (ProtocolUtils::ParseBreakpoint(args, fb))
+            {
+                FuncBreakpoint funcBreakpoint(fb.module, fb.funcname, fb.params, fb.condition);
+                funcBreakpoint.filters = filters;
+                if (SUCCEEDED(ctx.breakpointsHandle.SetFuncBreakpoint(ctx.sharedDebugger, funcBreakpoint, breakpoint)))
+                    Status = S_OK;
+            }
         }
 
         if (Status == S_OK)
@@ -655,7 +771,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
 
         return Status;
     } },
-    { "break-exception-insert", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "break-exception-insert", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.size() < 2)
         {
             output = "Command usage: -break-exception-insert [--mda] <unhandled|user-unhandled|throw|throw+user-unhandled> *|<Exception names>";
@@ -705,28 +821,28 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         std::vector<Breakpoint> breakpoints;
         // `breakpoints` will return all configured exception breakpoints, not only configured by this command.
         // Note, exceptionBreakpoints data will be invalidated by this call.
-        IfFailRet(breakpointsHandle.SetExceptionBreakpoints(sharedDebugger, exceptionBreakpoints, breakpoints));
+        IfFailRet(ctx.breakpointsHandle.SetExceptionBreakpoints(ctx.sharedDebugger, exceptionBreakpoints, breakpoints));
         // Print only breakpoints configured by this command (last newBpCount entries).
         IfFailRet(PrintExceptionBreakpoints(breakpoints, newBpCount, output));
 
         return S_OK;
     }},
-    { "break-delete", [&](const std::vector<std::string> &args, std::string &) -> HRESULT {
+    { "break-delete", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &) -> HRESULT {
         ParseBreakpointIndexes(args, [&](const std::unordered_set<uint32_t> &ids)
         {
-            breakpointsHandle.DeleteLineBreakpoints(sharedDebugger, ids);
-            breakpointsHandle.DeleteFuncBreakpoints(sharedDebugger, ids);
+            ctx.breakpointsHandle.DeleteLineBreakpoints(ctx.sharedDebugger, ids);
+            ctx.breakpointsHandle.DeleteFuncBreakpoints(ctx.sharedDebugger, ids);
         });
         return S_OK;
     } },
-    { "break-exception-delete", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "break-exception-delete", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         ParseBreakpointIndexes(args, [&](const std::unordered_set<uint32_t> &ids)
         {
-            breakpointsHandle.DeleteExceptionBreakpoints(sharedDebugger, ids);
+            ctx.breakpointsHandle.DeleteExceptionBreakpoints(ctx.sharedDebugger, ids);
         });
         return S_OK;
     }},
-    { "break-condition", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "break-condition", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.size() < 2)
         {
             output = "Command requires at least 2 arguments";
@@ -741,26 +857,26 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
             return E_FAIL;
         }
 
-        HRESULT Status = breakpointsHandle.SetLineBreakpointCondition(sharedDebugger, id, args.at(1));
+        HRESULT Status = ctx.breakpointsHandle.SetLineBreakpointCondition(ctx.sharedDebugger, id, args.at(1));
         if (SUCCEEDED(Status))
             return Status;
 
-        return breakpointsHandle.SetFuncBreakpointCondition(sharedDebugger, id, args.at(1));
+        return ctx.breakpointsHandle.SetFuncBreakpointCondition(ctx.sharedDebugger, id, args.at(1));
     } },
-    { "exec-step", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
-        return StepCommand(sharedDebugger, variablesHandle, args, IDebugger::StepType::STEP_IN, output);
+    { "exec-step", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        return StepCommand(ctx.sharedDebugger, ctx.variablesHandle, args, IDebugger::StepType::STEP_IN, output);
     }},
-    { "exec-next", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
-        return StepCommand(sharedDebugger, variablesHandle, args, IDebugger::StepType::STEP_OVER, output);
+    { "exec-next", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        return StepCommand(ctx.sharedDebugger, ctx.variablesHandle, args, IDebugger::StepType::STEP_OVER, output);
     }},
-    { "exec-finish", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
-        return StepCommand(sharedDebugger, variablesHandle, args, IDebugger::StepType::STEP_OUT, output);
+    { "exec-finish", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        return StepCommand(ctx.sharedDebugger, ctx.variablesHandle, args, IDebugger::StepType::STEP_OUT, output);
     }},
-    { "exec-abort", [&](const std::vector<std::string> &, std::string &output) -> HRESULT {
-        sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectTerminate);
+    { "exec-abort", [](CommandContext &ctx, const std::vector<std::string> &, std::string &output) -> HRESULT {
+        ctx.sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectTerminate);
         return S_OK;
     }},
-    { "target-attach", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "target-attach", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
         if (args.size() != 1)
         {
@@ -771,51 +887,286 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         int pid = ProtocolUtils::ParseInt(args.at(0), ok);
         if (!ok) return E_INVALIDARG;
 
-        sharedDebugger->Initialize();
-        IfFailRet(sharedDebugger->Attach(pid));
-        IfFailRet(sharedDebugger->ConfigurationDone());
+        ctx.sharedDebugger->Initialize();
+        IfFailRet(ctx.sharedDebugger->Attach(pid));
+        IfFailRet(ctx.sharedDebugger->ConfigurationDone());
         // TODO: print successful result
         return S_OK;
     }},
-    { "target-detach", [&](const std::vector<std::string> &, std::string &output) -> HRESULT {
-        sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectDetach);
+    { "target-detach", [](CommandContext &ctx, const std::vector<std::string> &, std::string &output) -> HRESULT {
+        ctx.sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectDetach);
         return S_OK;
     }},
-    { "stack-list-frames", [&](const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+    { "stack-list-frames", [](CommandContext &ctx, const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
         std::vector<std::string> args = args_orig;
-        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(sharedDebugger->GetLastStoppedThreadId())) };
+        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(ctx.sharedDebugger->GetLastStoppedThreadId())) };
         bool hotReloadAwareCaller = ProtocolUtils::FindAndEraseArg(args, "--hot-reload");
         int lowFrame = 0;
         int highFrame = FrameLevel::MaxFrameLevel;
         ProtocolUtils::StripArgs(args);
         ProtocolUtils::GetIndices(args, lowFrame, highFrame);
-        return PrintFrames(sharedDebugger, threadId, output, FrameLevel{lowFrame}, FrameLevel{highFrame}, hotReloadAwareCaller);
+        return PrintFrames(ctx.sharedDebugger, threadId, output, FrameLevel{lowFrame}, FrameLevel{highFrame}, hotReloadAwareCaller);
+    }},
+    { "gc-root-paths", [](CommandContext &ctx, const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+        HRESULT Status;
+        std::vector<std::string> args = args_orig;
+        const int maxPaths = ProtocolUtils::GetIntArg(args, "--max-paths", 10);
+        ProtocolUtils::StripArgs(args);
+        if (args.size() != 1 || maxPaths <= 0)
+        {
+            output = "Command usage: -gc-root-paths [--max-paths <count>] <variable-object-name>";
+            return E_FAIL;
+        }
+
+        MIProtocol::MIVariable miVariable;
+        IfFailRet(ctx.variablesHandle.FindVar(args.at(0), miVariable));
+        if (miVariable.variable.variablesReference == 0)
+        {
+            output = "Variable object is not heap object";
+            return E_FAIL;
+        }
+
+        std::vector<GCRootPath> paths;
+        IfFailRet(ctx.sharedDebugger->GetGCRootPaths(miVariable.variable.variablesReference, unsigned(maxPaths), paths));
+
+        std::ostringstream ss;
+        ss << "paths=[";
+        const char *pathSep = "";
+        for (const auto &path : paths)
+        {
+            ss << pathSep << "path={root-kind=\"" << path.rootKind << "\",objects=[";
+            const char *objectSep = "";
+            for (const auto &object : path.objects)
+            {
+                ss << objectSep << "object={addr=\"" << ProtocolUtils::AddrToString(std::uintptr_t(object.address))
+                   << "\",type=\"" << MIProtocol::EscapeMIValue(object.typeName) << "\"}";
+                objectSep = ",";
+            }
+            ss << "]}";
+            pathSep = ",";
+        }
+        ss << "]";
+
+        output = ss.str();
+        return S_OK;
+    }},
+    { "profile-start", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        const int intervalMs = ProtocolUtils::GetIntArg(args, "--interval", 0);
+        if (intervalMs < 0)
+            return E_INVALIDARG;
+
+        return ctx.sharedDebugger->StartSampling(unsigned(intervalMs));
     }},
-    { "stack-list-variables", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "profile-stop", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
+        SamplingResult result;
+        IfFailRet(ctx.sharedDebugger->StopSampling(result));
+
+        std::ostringstream ss;
+        ss << "samples=\"" << result.samples << "\",skipped-samples=\"" << result.skippedSamples
+           << "\",avg-pause-us=\"" << (result.samples != 0 ? result.totalPauseUs / result.samples : 0)
+           << "\",max-pause-us=\"" << result.maxPauseUs << "\"";
+
+        // Folded stacks could be written directly into file for flame graph tools, since result could be big.
+        if (!args.empty())
+        {
+            if (FAILED(Status = ProtocolUtils::WriteFoldedStacks(args.at(0), result.stacks)))
+            {
+                output = "Can't write file '" + args.at(0) + "'";
+                return Status;
+            }
+            output = ss.str();
+            return S_OK;
+        }
 
-        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(sharedDebugger->GetLastStoppedThreadId())) };
+        ss << ",stacks=[";
+        const char *sep = "";
+        for (const auto &stack : result.stacks)
+        {
+            ss << sep << "stack={frames=\"" << MIProtocol::EscapeMIValue(stack.frames) << "\",count=\"" << stack.count << "\"}";
+            sep = ",";
+        }
+        ss << "]";
+
+        output = ss.str();
+        return S_OK;
+    }},
+    { "trace-start", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        if (args.size() != 1)
+        {
+            output = "Command usage: -trace-start <file>";
+            return E_INVALIDARG;
+        }
+
+        return ctx.sharedDebugger->StartTraceRecording(args.at(0));
+    }},
+    { "trace-stop", [](CommandContext &ctx, const std::vector<std::string> &, std::string &output) -> HRESULT {
+        HRESULT Status;
+        TraceRecordingStats stats;
+        IfFailRet(ctx.sharedDebugger->StopTraceRecording(stats));
+
+        std::ostringstream ss;
+        ss << "records=\"" << stats.records << "\",lost-records=\"" << stats.lostRecords << "\",bytes=\"" << stats.bytes
+           << "\",duration-us=\"" << stats.durationUs << "\",records-per-second=\""
+           << (stats.durationUs != 0 ? stats.records * 1000000 / stats.durationUs : 0) << "\"";
+        output = ss.str();
+        return S_OK;
+    }},
+    { "trace-read", [](CommandContext &ctx, const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+        HRESULT Status;
+        std::vector<std::string> args = args_orig;
+        const int tracepointId = ProtocolUtils::GetIntArg(args, "--tracepoint", 0);
+        const int maxRecords = ProtocolUtils::GetIntArg(args, "--max-records", 100);
+        ProtocolUtils::StripArgs(args);
+        if (args.size() != 1 || tracepointId < 0 || maxRecords < 0)
+        {
+            output = "Command usage: -trace-read [--tracepoint id] [--max-records count] <file>";
+            return E_INVALIDARG;
+        }
+
+        TraceSummary summary;
+        IfFailRet(ctx.sharedDebugger->ReadTrace(args.at(0), uint32_t(tracepointId), unsigned(maxRecords), summary));
+
+        std::ostringstream ss;
+        ss << "start-time-us=\"" << summary.startTimeUs << "\",hits=\"" << summary.hits << "\",tracepoints=[";
+        const char *sep = "";
+        for (const auto &tracepoint : summary.tracepoints)
+        {
+            ss << sep << "tracepoint={id=\"" << tracepoint.id << "\",location=\"" << MIProtocol::EscapeMIValue(tracepoint.location)
+               << "\",expressions=[";
+            const char *exprSep = "";
+            for (const auto &expression : tracepoint.expressions)
+            {
+                ss << exprSep << "\"" << MIProtocol::EscapeMIValue(expression) << "\"";
+                exprSep = ",";
+            }
+            ss << "],hits=\"" << tracepoint.hits << "\",first-time-us=\"" << tracepoint.firstTimeUs << "\",last-time-us=\""
+               << tracepoint.lastTimeUs << "\",threads=\"" << tracepoint.threads << "\"}";
+            sep = ",";
+        }
+        ss << "],records=[";
+        sep = "";
+        for (const auto &record : summary.records)
+        {
+            ss << sep << "record={tracepoint=\"" << record.tracepointId << "\",time-us=\"" << record.timeUs
+               << "\",thread=\"" << record.threadId << "\",values=[";
+            const char *valueSep = "";
+            for (const auto &value : record.values)
+            {
+                ss << valueSep << "\"" << MIProtocol::EscapeMIValue(value) << "\"";
+                valueSep = ",";
+            }
+            ss << "]}";
+            sep = ",";
+        }
+        ss << "]";
+
+        output = ss.str();
+        return S_OK;
+    }},
+    { "heap-stats", [](CommandContext &ctx, const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+        HRESULT Status;
+        std::vector<std::string> args = args_orig;
+        const int baseSnapshotId = ProtocolUtils::GetIntArg(args, "--base", 0);
+        const int maxTypes = ProtocolUtils::GetIntArg(args, "--max-types", 0);
+        if (baseSnapshotId < 0 || maxTypes < 0)
+            return E_INVALIDARG;
+
+        HeapStats heapStats;
+        IfFailRet(ctx.sharedDebugger->GetHeapStats(uint32_t(baseSnapshotId), heapStats));
+
+        std::ostringstream ss;
+        ss << "snapshot-id=\"" << heapStats.snapshotId << "\",";
+        if (heapStats.baseSnapshotId != 0)
+            ss << "base-snapshot-id=\"" << heapStats.baseSnapshotId << "\",";
+        ss << "total-count=\"" << heapStats.totalCount << "\",total-size=\"" << heapStats.totalSize << "\",types=[";
+
+        const char *sep = "";
+        int typesCount = 0;
+        for (const auto &typeStats : heapStats.types)
+        {
+            if (maxTypes != 0 && typesCount == maxTypes)
+                break;
+
+            ss << sep << "type={name=\"" << MIProtocol::EscapeMIValue(typeStats.typeName) << "\",count=\"" << typeStats.count
+               << "\",size=\"" << typeStats.size << "\"";
+            if (heapStats.baseSnapshotId != 0)
+                ss << ",count-diff=\"" << typeStats.countDiff << "\",size-diff=\"" << typeStats.sizeDiff << "\"";
+            ss << "}";
+            sep = ",";
+            typesCount++;
+        }
+        ss << "]";
+
+        output = ss.str();
+        return S_OK;
+    }},
+    { "async-tasks", [](CommandContext &ctx, const std::vector<std::string> &, std::string &output) -> HRESULT {
+        HRESULT Status;
+        std::vector<AsyncTaskGroup> taskGroups;
+        IfFailRet(ctx.sharedDebugger->GetAsyncTasks(taskGroups));
+
+        std::ostringstream ss;
+        ss << "groups=[";
+        const char *groupSep = "";
+        for (const auto &group : taskGroups)
+        {
+            ss << groupSep << "group={count=\"" << group.count << "\",tasks=[";
+            groupSep = ",";
+
+            const char *sep = "";
+            for (const auto &task : group.tasks)
+            {
+                ss << sep << "task={addr=\"" << ProtocolUtils::AddrToString(std::uintptr_t(task.address)) << "\",status=\"" << task.status << "\"";
+                if (task.awaitedTask != 0)
+                    ss << ",awaited-task=\"" << ProtocolUtils::AddrToString(std::uintptr_t(task.awaitedTask)) << "\"";
+                ss << "}";
+                sep = ",";
+            }
+
+            ss << "],stack=[";
+            sep = "";
+            int level = 0;
+            for (const auto &stackFrame : group.stackFrames)
+            {
+                std::string frameLocation;
+                PrintFrameLocation(stackFrame, frameLocation);
+                ss << sep << "frame={level=\"" << level << "\"," << frameLocation << "}";
+                sep = ",";
+                level++;
+            }
+            ss << "]}";
+        }
+        ss << "]";
+
+        output = ss.str();
+        return S_OK;
+    }},
+    { "stack-list-variables", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        HRESULT Status;
+
+        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(ctx.sharedDebugger->GetLastStoppedThreadId())) };
         StackFrame stackFrame(threadId, FrameLevel{ProtocolUtils::GetIntArg(args, "--frame", 0)}, "");
         std::vector<Scope> scopes;
         std::vector<Variable> variables;
-        IfFailRet(sharedDebugger->GetScopes(stackFrame.id, scopes));
+        IfFailRet(ctx.sharedDebugger->GetScopes(stackFrame.id, scopes));
         if (!scopes.empty() && scopes[0].variablesReference != 0)
         {
-            IfFailRet(sharedDebugger->GetVariables(scopes[0].variablesReference, VariablesNamed, 0, 0, variables));
+            IfFailRet(ctx.sharedDebugger->GetVariables(scopes[0].variablesReference, VariablesNamed, 0, 0, variables));
         }
 
         PrintVariables(variables, output);
 
         return S_OK;
     }},
-    { "var-create", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "var-create", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.size() < 2)
         {
             output = "Command requires at least 2 arguments";
             return E_FAIL;
         }
 
-        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(sharedDebugger->GetLastStoppedThreadId())) };
+        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(ctx.sharedDebugger->GetLastStoppedThreadId())) };
         FrameLevel level { ProtocolUtils::GetIntArg(args, "--frame", 0) };
         int evalFlags = ProtocolUtils::GetIntArg(args, "--evalFlags", 0);
 
@@ -824,9 +1175,25 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         if (varExpr == "*" && args.size() >= 3)
             varExpr = args.at(2);
 
-        return variablesHandle.CreateVar(sharedDebugger, threadId, level, evalFlags, varName, varExpr, output);
+        return ctx.variablesHandle.CreateVar(ctx.sharedDebugger, threadId, level, evalFlags, varName, varExpr, output);
+    }},
+    { "var-create-batch", [](CommandContext &ctx, const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+        std::vector<std::string> args = args_orig;
+
+        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(ctx.sharedDebugger->GetLastStoppedThreadId())) };
+        FrameLevel level { ProtocolUtils::GetIntArg(args, "--frame", 0) };
+        int evalFlags = ProtocolUtils::GetIntArg(args, "--evalFlags", 0);
+        ProtocolUtils::StripArgs(args);
+
+        if (args.empty())
+        {
+            output = "Command requires at least 1 argument";
+            return E_FAIL;
+        }
+
+        return ctx.variablesHandle.CreateVars(ctx.sharedDebugger, threadId, level, evalFlags, args, output);
     }},
-    { "var-list-children", [&](const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+    { "var-list-children", [](CommandContext &ctx, const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
         std::vector<std::string> args = args_orig;
 
         int print_values = 0;
@@ -858,95 +1225,105 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         std::string varName = args.at(0);
         HRESULT Status;
         MIProtocol::MIVariable miVariable;
-        IfFailRet(variablesHandle.FindVar(varName, miVariable));
+        IfFailRet(ctx.variablesHandle.FindVar(varName, miVariable));
 
-        return variablesHandle.ListChildren(sharedDebugger, childStart, childEnd, miVariable, print_values, output);
+        return ctx.variablesHandle.ListChildren(ctx.sharedDebugger, childStart, childEnd, miVariable, print_values, output);
     }},
-    { "var-delete", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "var-delete", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.size() < 1)
         {
             output = "Command requires at least 1 argument";
             return E_FAIL;
         }
-        return variablesHandle.DeleteVar(args.at(0));
+        return ctx.variablesHandle.DeleteVar(args.at(0));
     }},
-    { "gdb-exit", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
-        sharedDebugger->Disconnect(); // Terminate debuggee process if debugger ran this process and detach in case debugger was attached to it.
+    { "gdb-exit", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        ctx.sharedDebugger->Disconnect(); // Terminate debuggee process if debugger ran this process and detach in case debugger was attached to it.
         return S_OK;
     }},
-    { "file-exec-and-symbols", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "file-exec-and-symbols", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.empty())
             return E_INVALIDARG;
-        fileExec = args.at(0);
+        ctx.fileExec = args.at(0);
         return S_OK;
     }},
-    { "exec-arguments", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
-        execArgs = args;
+    { "exec-arguments", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        ctx.execArgs = args;
         return S_OK;
     }},
-    { "exec-run", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "exec-run", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
-        sharedDebugger->Initialize();
+        ctx.sharedDebugger->Initialize();
         // Note, in case of MI protocol, we enable stop at entry point all the time from debugger side,
         // MIEngine will continue debuggee process at entry point stop event if IDE configured to ignore it.
-        IfFailRet(sharedDebugger->Launch(fileExec, execArgs, {}, "", true));
-        Status = sharedDebugger->ConfigurationDone();
+        IfFailRet(ctx.sharedDebugger->Launch(ctx.fileExec, ctx.execArgs, {}, "", true));
+        Status = ctx.sharedDebugger->ConfigurationDone();
         if (SUCCEEDED(Status))
             output = "^running";
         return Status;
     }},
-    { "environment-cd", [](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "environment-cd", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.empty())
             return E_INVALIDARG;
         return SetWorkDir(args.at(0)) ? S_OK : E_FAIL;
     }},
-    { "handshake", [](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "handshake", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (!args.empty() && args.at(0) == "init")
             output = "request=\"AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=\"";
 
         return S_OK;
     }},
-    { "gdb-set", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "gdb-set", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.size() != 2)
             return E_FAIL;
 
         if (args.at(0) == "just-my-code")
-            sharedDebugger->SetJustMyCode(args.at(1) == "1");
+            ctx.sharedDebugger->SetJustMyCode(args.at(1) == "1");
         else if (args.at(0) == "enable-step-filtering")
-            sharedDebugger->SetStepFiltering(args.at(1) == "1");
+            ctx.sharedDebugger->SetStepFiltering(args.at(1) == "1");
         else if (args.at(0) == "enable-hot-reload")
-            return sharedDebugger->SetHotReload(args.at(1) == "1");
+            return ctx.sharedDebugger->SetHotReload(args.at(1) == "1");
+        else if (args.at(0) == "async-call-stack")
+            ctx.sharedDebugger->SetAsyncCallStack(args.at(1) == "1");
+        else if (args.at(0) == "collapse-external-code")
+            ctx.sharedDebugger->SetCollapseExternalCode(args.at(1) == "1");
+        else if (args.at(0) == "coverage-output")
+            return ctx.sharedDebugger->SetCodeCoverage(args.at(1));
         else
             return E_FAIL;
 
         return S_OK;
     }},
-    { "gdb-show", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "gdb-show", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.size() != 1)
             return E_FAIL;
 
         std::ostringstream ss;
 
         if (args.at(0) == "just-my-code")
-            ss << "value=\"" << (sharedDebugger->IsJustMyCode() ? "1" : "0") << "\"";
+            ss << "value=\"" << (ctx.sharedDebugger->IsJustMyCode() ? "1" : "0") << "\"";
         else if (args.at(0) == "enable-step-filtering")
-            ss << "value=\"" << (sharedDebugger->IsStepFiltering() ? "1" : "0") << "\"";
+            ss << "value=\"" << (ctx.sharedDebugger->IsStepFiltering() ? "1" : "0") << "\"";
+        else if (args.at(0) == "async-call-stack")
+            ss << "value=\"" << (ctx.sharedDebugger->IsAsyncCallStack() ? "1" : "0") << "\"";
+        else if (args.at(0) == "collapse-external-code")
+            ss << "value=\"" << (ctx.sharedDebugger->IsCollapseExternalCode() ? "1" : "0") << "\"";
         else
             return E_FAIL;
 
         output = ss.str();
         return S_OK;
     }},
-    { "interpreter-exec", [](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "interpreter-exec", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         return S_OK;
     }},
-    { "var-show-attributes", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "var-show-attributes", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
         MIProtocol::MIVariable miVariable;
         std::string varName = args.at(0);
         std::string attributes;
 
-        IfFailRet(variablesHandle.FindVar(varName, miVariable));
+        IfFailRet(ctx.variablesHandle.FindVar(varName, miVariable));
         if (miVariable.variable.editable)
             attributes = "editable";
         else
@@ -955,7 +1332,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         output = "status=\"" + attributes + "\"";
         return S_OK;
     }},
-    { "var-assign", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "var-assign", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
 
         if (args.size() < 2)
@@ -971,16 +1348,16 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
             varExpr = varExpr.substr(1, varExpr.size() - 2);
 
         MIProtocol::MIVariable miVariable;
-        IfFailRet(variablesHandle.FindVar(varName, miVariable));
+        IfFailRet(ctx.variablesHandle.FindVar(varName, miVariable));
 
         FrameId frameId(miVariable.threadId, miVariable.level);
-        IfFailRet(sharedDebugger->SetExpression(frameId, miVariable.variable.evaluateName, miVariable.variable.evalFlags, varExpr, output));
+        IfFailRet(ctx.sharedDebugger->SetExpression(frameId, miVariable.variable.evaluateName, miVariable.variable.evalFlags, varExpr, output));
 
         output = "value=\"" + MIProtocol::EscapeMIValue(output) + "\"";
 
         return S_OK;
     }},
-    { "var-evaluate-expression", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "var-evaluate-expression", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
 
         if (args.size() != 1)
@@ -992,15 +1369,15 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         std::string varName = args.at(0);
 
         MIProtocol::MIVariable miVariable;
-        IfFailRet(variablesHandle.FindVar(varName, miVariable));
+        IfFailRet(ctx.variablesHandle.FindVar(varName, miVariable));
         FrameId frameId(miVariable.threadId, miVariable.level);
         Variable variable(miVariable.variable.evalFlags);
-        IfFailRet(sharedDebugger->Evaluate(frameId, miVariable.variable.evaluateName, variable, output));
+        IfFailRet(ctx.sharedDebugger->Evaluate(frameId, miVariable.variable.evaluateName, variable, output));
 
         output = "value=\"" + MIProtocol::EscapeMIValue(variable.value) + "\"";
         return S_OK;
     }},
-    { "apply-deltas", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+    { "apply-deltas", [](CommandContext &ctx, const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
 
         if (args.size() != 5)
@@ -1015,7 +1392,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         std::string deltaPDB = args.at(3);
         std::string lineUpdates = args.at(4);
 
-        IfFailRet(sharedDebugger->HotReloadApplyDeltas(dllFileName, deltaMD, deltaIL, deltaPDB, lineUpdates));
+        IfFailRet(ctx.sharedDebugger->HotReloadApplyDeltas(dllFileName, deltaMD, deltaIL, deltaPDB, lineUpdates));
 
         return S_OK;
     }},
@@ -1029,7 +1406,8 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         return E_FAIL;
     }
 
-    return command_it->second(args, output);
+    CommandContext ctx{sharedDebugger, breakpointsHandle, variablesHandle, fileExec, execArgs};
+    return command_it->second(ctx, args, output);
 }
 
 static bool ParseLine(const std::string &str, std::string &token, std::string &cmd, std::vector<std::string> &args)
@@ -1103,7 +1481,11 @@ void MIProtocol::CommandLoop()
             m_exit = true;
 
         std::string output;
-        HRESULT hr = HandleCommand(m_sharedDebugger, m_breakpointsHandle, m_variablesHandle, m_fileExec, m_execArgs, command, args, output);
+        HRESULT hr;
+        {
+            Timeline::Scope timelineScope(command.c_str(), "request");
+            hr = HandleCommand(m_sharedDebugger, m_breakpointsHandle, m_variablesHandle, m_fileExec, m_execArgs, command, args, output);
+        }
 
         if (m_exit)
             break;
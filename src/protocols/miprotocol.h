@@ -63,6 +63,8 @@ public:
     public:
         HRESULT CreateVar(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, FrameLevel level, int evalFlags,
                           const std::string &varobjName, const std::string &expression, std::string &output);
+        HRESULT CreateVars(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, FrameLevel level, int evalFlags,
+                           const std::vector<std::string> &expressions, std::string &output);
         HRESULT DeleteVar(const std::string &varobjName);
         HRESULT FindVar(const std::string &varobjName, MIVariable &variable);
         HRESULT PrintChildren(std::vector<Variable> &children, ThreadId threadId, FrameLevel level, int print_values, bool has_more, std::string &output);
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
+#include <fstream>
 #include <unordered_map>
 #include "protocol_utils.h"
 #include "interfaces/idebugger.h"
@@ -52,6 +53,12 @@ HRESULT BreakpointsHandle::UpdateLineBreakpoint(std::shared_ptr<IDebugger> &shar
 HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger,
                                              const std::string &module, const std::string &filename, int linenum,
                                              const std::string &condition, Breakpoint &breakpoint)
+{
+    return SetLineBreakpoint(sharedDebugger, filename, LineBreakpoint(module, linenum, condition), breakpoint);
+}
+
+HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &filename,
+                                             const LineBreakpoint &lineBreakpoint, Breakpoint &breakpoint)
 {
     HRESULT Status;
 
@@ -61,7 +68,7 @@ HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedD
     for (auto it : breakpointsInSource)
         lineBreakpoints.push_back(it.second);
 
-    lineBreakpoints.emplace_back(module, linenum, condition);
+    lineBreakpoints.push_back(lineBreakpoint);
 
     std::vector<Breakpoint> breakpoints;
     IfFailRet(sharedDebugger->SetLineBreakpoints(filename, lineBreakpoints, breakpoints));
@@ -75,6 +82,11 @@ HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedD
 HRESULT BreakpointsHandle::SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger,
                                              const std::string &module, const std::string &funcname, const std::string &params,
                                              const std::string &condition, Breakpoint &breakpoint)
+{
+    return SetFuncBreakpoint(sharedDebugger, FuncBreakpoint(module, funcname, params, condition), breakpoint);
+}
+
+HRESULT BreakpointsHandle::SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const FuncBreakpoint &funcBreakpoint, Breakpoint &breakpoint)
 {
     HRESULT Status;
 
@@ -83,7 +95,7 @@ HRESULT BreakpointsHandle::SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedD
     for (const auto &it : m_funcBreakpoints)
         funcBreakpoints.push_back(it.second);
 
-    funcBreakpoints.emplace_back(module, funcname, params, condition);
+    funcBreakpoints.push_back(funcBreakpoint);
 
     std::vector<Breakpoint> breakpoints;
     IfFailRet(sharedDebugger->SetFuncBreakpoints(funcBreakpoints, breakpoints));
@@ -455,6 +467,21 @@ std::string AddrToString(std::uintptr_t addr)
     return ss.str();
 }
 
+HRESULT WriteFoldedStacks(const std::string &path, const std::vector<SampledStack> &stacks)
+{
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out)
+        return E_FAIL;
+
+    for (const auto &stack : stacks)
+    {
+        out << stack.frames << " " << stack.count << "\n";
+    }
+
+    out.close();
+    return out ? S_OK : E_FAIL;
+}
+
 } // namespace ProtocolUtils
 
 } // namespace netcoredbg
@@ -45,8 +45,12 @@ public:
     HRESULT UpdateLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, int id, int linenum, Breakpoint &breakpoint);
     HRESULT SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &module, const std::string &filename,
                               int linenum, const std::string &condition, Breakpoint &breakpoints);
+    // Line breakpoint with all options (tracepoint, hit condition, thread filter) provided by caller.
+    HRESULT SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &filename,
+                              const LineBreakpoint &lineBreakpoint, Breakpoint &breakpoint);
     HRESULT SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &module, const std::string &funcname,
                               const std::string &params, const std::string &condition, Breakpoint &breakpoint);
+    HRESULT SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const FuncBreakpoint &funcBreakpoint, Breakpoint &breakpoint);
     HRESULT SetExceptionBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, std::vector<ExceptionBreakpoint> &excBreakpoints,
                                     std::vector<Breakpoint> &breakpoints);
     HRESULT SetLineBreakpointCondition(std::shared_ptr<IDebugger> &sharedDebugger, uint32_t id, const std::string &condition);
@@ -69,6 +73,8 @@ namespace ProtocolUtils
     bool ParseBreakpoint(std::vector<std::string> &args, struct LineBreak &lb);
     bool ParseBreakpoint(std::vector<std::string> &args, struct FuncBreak &fb);
     std::string AddrToString(std::uintptr_t addr);
+    // Write stacks in folded format ("frame;frame;frame count" lines), that could be used by flame graph tools.
+    HRESULT WriteFoldedStacks(const std::string &path, const std::vector<SampledStack> &stacks);
 
 } // namespace ProtocolUtils
 
@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <algorithm>
+#include "protocols/protocolwriter.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+ProtocolWriter::ProtocolWriter(std::ostream &output, size_t queueLimit) :
+    m_output(output),
+    m_queueLimit(queueLimit),
+    m_queuedBytes(0),
+    m_writing(false),
+    m_stop(false)
+{
+    m_writerThread = std::thread(&ProtocolWriter::WriterWorker, this);
+}
+
+ProtocolWriter::~ProtocolWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_writerCV.notify_one();
+    if (m_writerThread.joinable())
+        m_writerThread.join();
+
+    LOGI("Protocol writer: %llu messages, %llu batches, %llu bytes, max queue depth %u (%llu bytes), %llu blocked writes, "
+         "write avg %llu us, max %llu us, max latency %llu us",
+         (unsigned long long)m_stats.messages, (unsigned long long)m_stats.batches, (unsigned long long)m_stats.bytes,
+         (unsigned)m_stats.maxQueueDepth, (unsigned long long)m_stats.maxQueuedBytes, (unsigned long long)m_stats.blockedWrites,
+         (unsigned long long)(m_stats.batches ? m_stats.totalWriteUs / m_stats.batches : 0),
+         (unsigned long long)m_stats.maxWriteUs, (unsigned long long)m_stats.maxLatencyUs);
+}
+
+void ProtocolWriter::Write(std::string &&message)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto queueHaveSpace = [&]{ return m_stop || m_queuedBytes == 0 || m_queuedBytes + message.size() <= m_queueLimit; };
+    if (!queueHaveSpace())
+    {
+        if (m_stats.blockedWrites == 0)
+            LOGW("Protocol output queue limit reached, client can't keep up");
+        m_stats.blockedWrites++;
+        m_flushCV.wait(lock, queueHaveSpace);
+    }
+
+    if (m_queue.empty())
+        m_firstQueuedTime = Clock::now();
+
+    m_queuedBytes += message.size();
+    m_queue.emplace_back(std::move(message));
+    m_stats.maxQueueDepth = std::max(m_stats.maxQueueDepth, m_queue.size());
+    m_stats.maxQueuedBytes = std::max(m_stats.maxQueuedBytes, m_queuedBytes);
+    const bool notify = m_queue.size() == 1;
+    lock.unlock();
+
+    if (notify)
+        m_writerCV.notify_one();
+}
+
+void ProtocolWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_flushCV.wait(lock, [this]{ return m_queue.empty() && !m_writing; });
+}
+
+void ProtocolWriter::WriterWorker()
+{
+    std::vector<std::string> messages;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_writerCV.wait(lock, [this]{ return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) // stop requested and all messages written
+            break;
+
+        // Swap queues, so, message producers are not blocked by stream write.
+        messages.swap(m_queue);
+        const Clock::time_point firstQueuedTime = m_firstQueuedTime;
+        m_writing = true;
+        lock.unlock();
+
+        // Note, messages are not concatenated (output event could be huge), stream buffer collect them
+        // and only one flush is performed for whole batch.
+        uint64_t batchSize = 0;
+        const Clock::time_point startTime = Clock::now();
+        for (const auto &message : messages)
+        {
+            m_output.write(message.data(), message.size());
+            batchSize += message.size();
+        }
+        m_output.flush();
+        const Clock::time_point endTime = Clock::now();
+        if (!m_output.good())
+            LOGE("Protocol output write failed");
+
+        lock.lock();
+        const uint64_t writeUs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+        const uint64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - firstQueuedTime).count();
+        m_stats.messages += messages.size();
+        m_stats.batches++;
+        m_stats.bytes += batchSize;
+        m_stats.totalWriteUs += writeUs;
+        m_stats.maxWriteUs = std::max(m_stats.maxWriteUs, writeUs);
+        m_stats.maxLatencyUs = std::max(m_stats.maxLatencyUs, latencyUs);
+        m_queuedBytes -= batchSize;
+        m_writing = false;
+        messages.clear();
+        m_flushCV.notify_all();
+    }
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace netcoredbg
+{
+
+struct ProtocolWriterStats
+{
+    uint64_t messages = 0;
+    uint64_t batches = 0;
+    uint64_t bytes = 0;
+    size_t maxQueueDepth = 0; // messages
+    size_t maxQueuedBytes = 0;
+    uint64_t blockedWrites = 0; // Write() calls blocked by queue limit
+    uint64_t totalWriteUs = 0; // time spent in stream write and flush
+    uint64_t maxWriteUs = 0;
+    uint64_t maxLatencyUs = 0; // from message enqueue to write finish
+};
+
+// Write already framed protocol messages into output stream by dedicated thread, so, slow client don't block
+// debugger threads (callbacks worker, commands worker, etc.). All messages queued since last write are written
+// as one batch with one stream flush. Messages are written in Write() calls order, so, caller that assign "seq"
+// must call Write() under same lock. In case client don't read output and queued data (including batch in progress)
+// reach limit, Write() block caller until writer thread write enough data. Message bigger than limit is accepted
+// only into empty queue.
+class ProtocolWriter
+{
+public:
+
+    typedef std::chrono::steady_clock Clock;
+
+    static const size_t DefaultQueueLimit = size_t(64) * 1024 * 1024;
+
+    ProtocolWriter(std::ostream &output, size_t queueLimit = DefaultQueueLimit);
+    // Write all queued messages and stop writer thread.
+    ~ProtocolWriter();
+
+    void Write(std::string &&message);
+    // Wait until all queued messages are written.
+    void Flush();
+
+private:
+
+    std::ostream &m_output;
+    const size_t m_queueLimit;
+
+    std::mutex m_mutex;
+    std::condition_variable m_writerCV; // new message or stop
+    std::condition_variable m_flushCV; // batch written
+    std::vector<std::string> m_queue;
+    size_t m_queuedBytes; // m_queue and batch in progress size
+    Clock::time_point m_firstQueuedTime; // enqueue time of oldest message in m_queue
+    bool m_writing; // writer thread have batch in progress
+    bool m_stop;
+    ProtocolWriterStats m_stats;
+
+    std::thread m_writerThread;
+
+    void WriterWorker();
+};
+
+} // namespace netcoredbg
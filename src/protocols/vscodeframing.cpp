@@ -0,0 +1,212 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include "protocols/vscodeframing.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    const std::string CONTENT_LENGTH("Content-Length: ");
+    // Protect from endless header line in case of broken input.
+    const size_t MaxHeaderLineSize = 1024;
+
+    using json = nlohmann::json;
+
+    // SAX handler, that forward "arguments" events to DOM parser and extract top level fields only.
+    class RequestSAX
+    {
+    public:
+
+        RequestSAX(VSCodeRequest &request) :
+            m_request(request),
+            m_argumentsParser(request.arguments),
+            m_depth(0),
+            m_inArguments(false)
+        {}
+
+        bool null() { return m_inArguments ? m_argumentsParser.null() : SetField(json(nullptr)); }
+        bool boolean(bool val) { return m_inArguments ? m_argumentsParser.boolean(val) : SetField(json(val)); }
+        bool number_integer(json::number_integer_t val) { return m_inArguments ? m_argumentsParser.number_integer(val) : SetField(json(val)); }
+        bool number_unsigned(json::number_unsigned_t val) { return m_inArguments ? m_argumentsParser.number_unsigned(val) : SetField(json(val)); }
+        bool number_float(json::number_float_t val, const json::string_t &s) { return m_inArguments ? m_argumentsParser.number_float(val, s) : SetField(json(val)); }
+        bool string(json::string_t &val) { return m_inArguments ? m_argumentsParser.string(val) : SetField(json(std::move(val))); }
+        bool binary(json::binary_t &val) { return m_inArguments ? m_argumentsParser.binary(val) : true; }
+
+        bool key(json::string_t &val)
+        {
+            if (m_inArguments)
+                return m_argumentsParser.key(val);
+
+            if (m_depth == 1)
+                m_key = std::move(val);
+
+            return true;
+        }
+
+        bool start_object(std::size_t len)
+        {
+            StartArgumentsIfNeeded();
+            m_depth++;
+            return m_inArguments ? m_argumentsParser.start_object(len) : true;
+        }
+
+        bool end_object()
+        {
+            m_depth--;
+            return m_inArguments ? EndArgumentsIfNeeded(m_argumentsParser.end_object()) : true;
+        }
+
+        bool start_array(std::size_t len)
+        {
+            StartArgumentsIfNeeded();
+            m_depth++;
+            return m_inArguments ? m_argumentsParser.start_array(len) : true;
+        }
+
+        bool end_array()
+        {
+            m_depth--;
+            return m_inArguments ? EndArgumentsIfNeeded(m_argumentsParser.end_array()) : true;
+        }
+
+        bool parse_error(std::size_t position, const std::string &last_token, const nlohmann::detail::exception &ex)
+        {
+            // Note, DOM parser throw exception with proper type (parse_error, out_of_range, etc).
+            return m_argumentsParser.parse_error(position, last_token, ex);
+        }
+
+    private:
+
+        VSCodeRequest &m_request;
+        nlohmann::detail::json_sax_dom_parser<json> m_argumentsParser;
+        std::string m_key; // current key at request object level
+        unsigned m_depth;
+        bool m_inArguments;
+
+        void StartArgumentsIfNeeded()
+        {
+            if (!m_inArguments && m_depth == 1 && m_key == "arguments")
+                m_inArguments = true;
+        }
+
+        bool EndArgumentsIfNeeded(bool result)
+        {
+            if (m_depth == 1)
+                m_inArguments = false;
+
+            return result;
+        }
+
+        // Note, nested objects and arrays (except "arguments") are skipped.
+        bool SetField(json &&value)
+        {
+            if (m_depth != 1)
+                return true;
+
+            if (m_key == "seq")
+                m_request.seq = std::move(value);
+            else if (m_key == "type" && value.is_string())
+                m_request.type = value.get<std::string>();
+            else if (m_key == "command" && value.is_string())
+                m_request.command = value.get<std::string>();
+            else if (m_key == "arguments")
+                m_request.arguments = std::move(value);
+
+            return true;
+        }
+    };
+
+} // unnamed namespace
+
+VSCodeFrameReader::Status VSCodeFrameReader::Read(std::string &message)
+{
+    typedef std::streambuf::traits_type traits_type;
+
+    // parse header (only content len) until empty line
+    long content_len = -1;
+    while (true)
+    {
+        m_line.clear();
+        while (true)
+        {
+            const traits_type::int_type c = m_pStreamBuf->sbumpc();
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                LOGI("EOF");
+                return Status::Eof;
+            }
+            if (traits_type::to_char_type(c) == '\n')
+                break;
+
+            if (m_line.size() >= MaxHeaderLineSize)
+            {
+                LOGE("protocol error: header line is too long");
+                return Status::Error;
+            }
+            m_line.push_back(traits_type::to_char_type(c));
+        }
+
+        if (!m_line.empty() && m_line.back() == '\r')
+            m_line.pop_back();
+
+        if (m_line.empty())
+        {
+            if (content_len < 0)
+            {
+                LOGE("protocol error: no 'Content Length:' field!");
+                return Status::Error;
+            }
+            break;         // header and content delimiter
+        }
+
+        LOGD("header: '%s'", m_line.c_str());
+
+        if (m_line.size() > CONTENT_LENGTH.size() && m_line.compare(0, CONTENT_LENGTH.size(), CONTENT_LENGTH) == 0)
+        {
+            if (content_len >= 0)
+                LOGW("protocol violation: duplicate '%s'", m_line.c_str());
+
+            char *p;
+            errno = 0;
+            content_len = strtol(&m_line[CONTENT_LENGTH.size()], &p, 10);
+            if (errno == ERANGE || content_len < 0 || !(*p == 0 || isspace(*p)))
+            {
+                LOGE("protocol violation: '%s'", m_line.c_str());
+                return Status::Error;
+            }
+        }
+    }
+
+    message.resize(content_len);
+    if (content_len > 0 && m_pStreamBuf->sgetn(&message[0], content_len) != content_len)
+    {
+        LOGE("Unexpected EOF!");
+        return Status::Error;
+    }
+
+    return Status::Ok;
+}
+
+void ParseVSCodeRequest(const std::string &message, VSCodeRequest &request)
+{
+    request.seq = nullptr;
+    request.type.clear();
+    request.command.clear();
+    request.arguments = nullptr;
+
+    RequestSAX sax(request);
+    json::sax_parse(message, &sax);
+
+    if (request.arguments.is_null())
+        request.arguments = json::object();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,55 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <streambuf>
+#include <string>
+
+#pragma warning (disable:4068)  // Visual Studio should ignore GCC pragmas
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wtautological-overlap-compare"
+#include "json/json.hpp"
+#pragma GCC diagnostic pop
+
+namespace netcoredbg
+{
+
+// Reader for "Content-Length" framed messages. Header is parsed directly from stream buffer (no std::istream
+// sentry and getline() overhead), message body is read by one sgetn() call into caller's string, so, string
+// capacity is reused for all messages.
+class VSCodeFrameReader
+{
+public:
+
+    enum class Status
+    {
+        Ok,
+        Eof,
+        Error
+    };
+
+    VSCodeFrameReader(std::streambuf *pStreamBuf) : m_pStreamBuf(pStreamBuf) {}
+
+    Status Read(std::string &message);
+
+private:
+
+    std::streambuf *m_pStreamBuf;
+    std::string m_line; // header line, reused
+};
+
+struct VSCodeRequest
+{
+    nlohmann::json seq; // null in case request have no "seq"
+    std::string type;
+    std::string command; // empty in case request have no "command"
+    nlohmann::json arguments; // empty object in case request have no "arguments"
+};
+
+// Parse request by SAX parser in one pass. DOM is not created for whole request, only "arguments" DOM is created
+// (directly, without copy from request DOM), all other fields are extracted by key at top level.
+// Throws nlohmann::detail::exception in case of parse error.
+void ParseVSCodeRequest(const std::string &message, VSCodeRequest &request);
+
+} // namespace netcoredbg
@@ -23,7 +23,12 @@
 #include "utils/torelease.h"
 #include "utils/utf.h"
 #include "utils/logger.h"
+#include "utils/timeline.h"
 #include "protocols/escaped_string.h"
+#include "protocols/protocol_utils.h"
+#include "protocols/vscodeframing.h"
+#include "protocols/vscodeserializers.h"
+#include "protocols/vscodewriter.h"
 
 // for convenience
 using json = nlohmann::json;
@@ -54,13 +59,42 @@ namespace
     // Don't cancel commands related to debugger configuration. For example, breakpoint setup could be done in any time (even if process don't attached at all).
     const std::unordered_set<std::string> g_debuggerSetupCommandSet{
         "initialize", "setExceptionBreakpoints", "configurationDone", "setBreakpoints", "launch", "disconnect", "terminate", "attach", "setFunctionBreakpoints"};
+    // Commands with managed heap walk, that could take long time for big heap. Have progress events and could be canceled by client.
+    const std::unordered_set<std::string> g_noTimeoutCommandSet{
+        "asyncTasks", "gcRootPaths"};
+    // Commands with managed heap walk, walk cancel state is reset at request acceptance.
+    const std::unordered_set<std::string> g_heapWalkCommandSet{
+        "asyncTasks", "heapStats", "gcRootPaths"};
+    // Hot commands (executed at each stop), response body is serialized directly into string without JSON DOM creation.
+    const std::unordered_set<std::string> g_streamedResponseCommandSet{
+        "threads", "stackTrace", "variables"};
+    // Read-only commands without evaluation, could be executed concurrently with commands queue (for example, during
+    // long evaluation). Note, debugger methods for these commands hold m_debugProcessRWLock reader lock only and don't
+    // wait for running evaluation end (stack trace skip exception stack trace analysis, that need func-eval).
+    const std::unordered_set<std::string> g_concurrentCommandSet{
+        "threads", "stackTrace"};
+    const unsigned ConcurrentCommandsWorkers = 2;
+    // Long read-only commands (heap walk without evaluation), started in commands queue order, but executed by own
+    // worker and responded at finish. Note, debugger holds evaluation start during execution. All heap walk commands
+    // are here, since they share heap walker and must not be executed in parallel.
+    const std::unordered_set<std::string> g_backgroundCommandSet{
+        "asyncTasks", "heapStats", "gcRootPaths"};
+    // Commands, that could be canceled by client during execution (walk cycles check cancellation token,
+    // evaluation is aborted by CancelEvalRunning()).
+    const std::unordered_set<std::string> g_cancelableCommandSet{
+        "stackTrace", "variables", "evaluate"};
+
+    // Not standard extension, breakpoint hit filters (see BreakpointFilters).
+    BreakpointFilters GetBreakpointFilters(const json &breakpoint)
+    {
+        BreakpointFilters filters;
+        filters.threadIds = breakpoint.value("threadIds", std::vector<int>());
+        filters.threadNames = breakpoint.value("threadNames", std::vector<std::string>());
+        filters.callerModules = breakpoint.value("callerModules", std::vector<std::string>());
+        return filters;
+    }
 } // unnamed namespace
 
-void to_json(json &j, const Source &s) {
-    j = json{{"name", s.name},
-             {"path", s.path}};
-}
-
 void to_json(json &j, const Breakpoint &b) {
     j = json{
         {"id",       b.id},
@@ -75,25 +109,6 @@ void to_json(json &j, const Breakpoint &b) {
     }
 }
 
-void to_json(json &j, const StackFrame &f) {
-    j = json{
-        {"id",        int(f.id)},
-        {"name",      f.methodName},
-        {"line",      f.line},
-        {"column",    f.column},
-        {"endLine",   f.endLine},
-        {"endColumn", f.endColumn},
-        {"moduleId",  f.moduleId}};
-    if (!f.source.IsNull())
-        j["source"] = f.source;
-}
-
-void to_json(json &j, const Thread &t) {
-    j = json{{"id",   int(t.id)},
-             {"name", t.name}};
-          // {"running", t.running}
-}
-
 void to_json(json &j, const Scope &s) {
     j = json{
         {"name",               s.name},
@@ -107,21 +122,6 @@ void to_json(json &j, const Scope &s) {
     }
 }
 
-void to_json(json &j, const Variable &v) {
-    j = json{
-        {"name",               v.name},
-        {"value",              v.value},
-        {"type",               v.type},
-        {"evaluateName",       v.evaluateName},
-        {"variablesReference", v.variablesReference}};
-
-    if (v.variablesReference > 0)
-    {
-        j["namedVariables"] = v.namedVariables;
-        // j["indexedVariables"] = v.indexedVariables;
-    }
-}
-
 static json FormJsonForExceptionDetails(const ExceptionDetails &details)
 {
     json result{{"typeName",             details.typeName},
@@ -129,7 +129,8 @@ static json FormJsonForExceptionDetails(const ExceptionDetails &details)
                 {"evaluateName",         details.evaluateName},
                 {"stackTrace",           details.stackTrace},
                 {"formattedDescription", details.formattedDescription},
-                {"source",               details.source}};
+                {"source",               details.source},
+                {"hResult",              details.hResult}};
 
     if (!details.message.empty())
         result["message"] = details.message;
@@ -146,6 +147,34 @@ static json FormJsonForExceptionDetails(const ExceptionDetails &details)
     return result;
 }
 
+void VSCodeProtocol::EmitProgressEvent(const ProgressEvent &event)
+{
+    LogFuncEntry();
+
+    if (!m_progressReporting)
+        return;
+
+    json body;
+    body["progressId"] = event.progressId;
+
+    switch(event.reason)
+    {
+        case ProgressStart:
+            body["title"] = event.title;
+            body["cancellable"] = true;
+            body["percentage"] = event.percentage;
+            EmitEvent("progressStart", body);
+            break;
+        case ProgressUpdate:
+            body["percentage"] = event.percentage;
+            EmitEvent("progressUpdate", body);
+            break;
+        case ProgressEnd:
+            EmitEvent("progressEnd", body);
+            break;
+    }
+}
+
 void VSCodeProtocol::EmitContinuedEvent(ThreadId threadId)
 {
     LogFuncEntry();
@@ -162,6 +191,7 @@ void VSCodeProtocol::EmitContinuedEvent(ThreadId threadId)
 void VSCodeProtocol::EmitStoppedEvent(const StoppedEvent &event)
 {
     LogFuncEntry();
+    Timeline::Instant("StoppedEvent", "event");
 
     json body;
 
@@ -282,28 +312,6 @@ void VSCodeProtocol::EmitModuleEvent(const ModuleEvent &event)
 
 namespace
 {
-    // Rules to escape characters in strings, in JSON.
-    struct JSON_escape_rules
-    {
-       static const char forbidden_chars[];
-       static const string_view subst_chars[];
-       constexpr static const char escape_char = '\\';
-    };
-
-    // Allocate static memory for strings declared above.
-    const char JSON_escape_rules::forbidden_chars[] =
-    "\"\\"
-    "\000\001\002\003\004\005\006\007\010\011\012\013\014\015\016\017"
-    "\020\021\022\023\024\025\026\027\030\031\032\033\034\035\036\037";
-
-    const string_view JSON_escape_rules::subst_chars[] = {
-        "\\\"", "\\\\",
-        "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
-        "\\b", "\\t", "\\n", "\\u000b", "\\f", "\\r", "\\u000e", "\\u000f",
-        "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
-        "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f"
-    };
-
     // This function serializes "OutputEvent" to specified output stream and used for two
     // purposes: to compute output size, and to perform the output directly.
     template <typename T1>
@@ -364,8 +372,10 @@ void VSCodeProtocol::EmitOutputEvent(OutputCategory category, string_view output
     auto const total_size = count.size() + escaped_text.size();
 
     // perform output
-    cout << CONTENT_LENGTH << total_size << TWO_CRLF;
-    serialize_output(cout, m_seqCounter, name, escaped_text, source);
+    std::ostringstream message;
+    message << CONTENT_LENGTH << total_size << TWO_CRLF;
+    serialize_output(message, m_seqCounter, name, escaped_text, source);
+    m_writer.Write(message.str());
 
     ++m_seqCounter;
 }
@@ -416,6 +426,7 @@ static void AddCapabilitiesTo(json &capabilities)
     capabilities["supportsConfigurationDoneRequest"] = true;
     capabilities["supportsFunctionBreakpoints"] = true;
     capabilities["supportsConditionalBreakpoints"] = true;
+    capabilities["supportsHitConditionalBreakpoints"] = true;
     capabilities["supportTerminateDebuggee"] = true;
     capabilities["supportsSetVariable"] = true;
     capabilities["supportsSetExpression"] = true;
@@ -460,8 +471,7 @@ void VSCodeProtocol::EmitMessage(nlohmann::json &message, std::string &output)
     message["seq"] = std::to_string(m_seqCounter);
     ++m_seqCounter;
     output = message.dump();
-    cout << CONTENT_LENGTH << output.size() << TWO_CRLF << output;
-    cout.flush();
+    m_writer.Write(CONTENT_LENGTH + std::to_string(output.size()) + TWO_CRLF + output);
 }
 
 void VSCodeProtocol::EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message)
@@ -472,6 +482,31 @@ void VSCodeProtocol::EmitMessageWithLog(const std::string &message_prefix, nlohm
     Log(message_prefix, output);
 }
 
+void VSCodeProtocol::EmitResponseWithRawBody(nlohmann::json &response, const std::string &rawBody)
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    response["seq"] = std::to_string(m_seqCounter);
+    ++m_seqCounter;
+    response["body"] = nullptr; // placeholder, so, envelope keys are iterated in dump() order
+
+    m_outputBuffer.clear();
+    m_outputBuffer.reserve(rawBody.size() + 128);
+    VSCodeJSONWriter writer(m_outputBuffer);
+    writer.StartObject();
+    for (auto it = response.begin(); it != response.end(); ++it)
+    {
+        writer.Key(it.key());
+        if (it.key() == "body")
+            writer.Raw(rawBody);
+        else
+            writer.Raw(it.value().dump());
+    }
+    writer.EndObject();
+
+    m_writer.Write(CONTENT_LENGTH + std::to_string(m_outputBuffer.size()) + TWO_CRLF + m_outputBuffer);
+    Log(LOG_RESPONSE, m_outputBuffer);
+}
+
 void VSCodeProtocol::EmitEvent(const std::string &name, const nlohmann::json &body)
 {
     json message;
@@ -481,19 +516,31 @@ void VSCodeProtocol::EmitEvent(const std::string &name, const nlohmann::json &bo
     EmitMessageWithLog(LOG_EVENT, message);
 }
 
+namespace
+{
+    // Session data for command handlers. Note, commands map is static and shared by all sessions (multi-session server),
+    // so, handlers must not capture session data.
+    struct CommandContext
+    {
+        std::shared_ptr<IDebugger> &sharedDebugger;
+        std::string &fileExec;
+        std::vector<std::string> &execArgs;
+    };
+} // unnamed namespace
+
 static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::string &fileExec, std::vector<std::string> &execArgs,
                              const std::string &command, const json &arguments, json &body)
 {
-    typedef std::function<HRESULT(const json &arguments, json &body)> CommandCallback;
+    typedef std::function<HRESULT(CommandContext &ctx, const json &arguments, json &body)> CommandCallback;
     static std::unordered_map<std::string, CommandCallback> commands {
-    { "initialize", [&](const json &arguments, json &body){
-        sharedDebugger->Initialize();
+    { "initialize", [](CommandContext &ctx, const json &arguments, json &body){
+        ctx.sharedDebugger->Initialize();
 
         AddCapabilitiesTo(body);
 
         return S_OK;
     } },
-    { "setExceptionBreakpoints", [&](const json &arguments, json &body) {
+    { "setExceptionBreakpoints", [](CommandContext &ctx, const json &arguments, json &body) {
         std::vector<std::string> filters = arguments.value("filters", std::vector<std::string>());
         std::vector<std::map<std::string, std::string>> filterOptions = arguments.value("filterOptions", std::vector<std::map<std::string, std::string>>());
 
@@ -546,21 +593,24 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         HRESULT Status;
         std::vector<Breakpoint> breakpoints;
-        IfFailRet(sharedDebugger->SetExceptionBreakpoints(exceptionBreakpoints, breakpoints));
+        IfFailRet(ctx.sharedDebugger->SetExceptionBreakpoints(exceptionBreakpoints, breakpoints));
 
         // TODO form body with breakpoints (optional output, MS vsdbg don't provide it for VSCode IDE now)
         // body["breakpoints"] = breakpoints;
 
         return S_OK;
     } },
-    { "configurationDone", [&](const json &arguments, json &body){
-        return sharedDebugger->ConfigurationDone();
+    { "configurationDone", [](CommandContext &ctx, const json &arguments, json &body){
+        return ctx.sharedDebugger->ConfigurationDone();
     } },
-    { "exceptionInfo", [&](const json &arguments, json &body) {
+    { "exceptionInfo", [](CommandContext &ctx, const json &arguments, json &body) {
         HRESULT Status;
         ThreadId threadId{int(arguments.at("threadId"))};
+        // Exception stack trace and source need func-eval, but provided by default, as client expects them in details.
+        // Non-standard "extendedDetails": false argument could be used for fast request with basic details only.
+        const bool extendedDetails = arguments.value("extendedDetails", true);
         ExceptionInfo exceptionInfo;
-        IfFailRet(sharedDebugger->GetExceptionInfo(threadId, exceptionInfo));
+        IfFailRet(ctx.sharedDebugger->GetExceptionInfo(threadId, extendedDetails, exceptionInfo));
 
         body["exceptionId"] = exceptionInfo.exceptionId;
         body["description"] = exceptionInfo.description;
@@ -568,21 +618,28 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         body["details"] = FormJsonForExceptionDetails(exceptionInfo.details);
         return S_OK;
     } },
-    { "setBreakpoints", [&](const json &arguments, json &body){
+    { "setBreakpoints", [](CommandContext &ctx, const json &arguments, json &body){
         HRESULT Status;
 
         std::vector<LineBreakpoint> lineBreakpoints;
         for (auto &b : arguments.at("breakpoints"))
+        {
             lineBreakpoints.emplace_back(std::string(), b.at("line"), b.value("condition", std::string()));
+            // Not standard extension, tracepoint record expressions values into trace file (see "startTraceRecording") instead of stop.
+            lineBreakpoints.back().traceExpressions = b.value("traceExpressions", std::vector<std::string>());
+            lineBreakpoints.back().hitCondition = b.value("hitCondition", std::string());
+            lineBreakpoints.back().filters = GetBreakpointFilters(b);
+        }
 
         std::vector<Breakpoint> breakpoints;
-        IfFailRet(sharedDebugger->SetLineBreakpoints(arguments.at("source").at("path"), lineBreakpoints, breakpoints));
+        IfFailRet(ctx.sharedDebugger->SetLineBreakpoints(arguments.at("source").at("path"), lineBreakpoints, breakpoints));
 
         body["breakpoints"] = breakpoints;
 
         return S_OK;
     } },
-    { "launch", [&](const json &arguments, json &body){
+    { "launch", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
         auto cwdIt = arguments.find("cwd");
         const std::string cwd(cwdIt != arguments.end() ? cwdIt.value().get<std::string>() : std::string{});
         std::map<std::string, std::string> env;
@@ -597,27 +654,22 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
             env.clear();
         }
 
-        sharedDebugger->SetJustMyCode(arguments.value("justMyCode", true)); // MS vsdbg have "justMyCode" enabled by default.
-        sharedDebugger->SetStepFiltering(arguments.value("enableStepFiltering", true)); // MS vsdbg have "enableStepFiltering" enabled by default.
+        ctx.sharedDebugger->SetJustMyCode(arguments.value("justMyCode", true)); // MS vsdbg have "justMyCode" enabled by default.
+        ctx.sharedDebugger->SetStepFiltering(arguments.value("enableStepFiltering", true)); // MS vsdbg have "enableStepFiltering" enabled by default.
+        ctx.sharedDebugger->SetAsyncCallStack(arguments.value("asyncCallStack", false));
+        // Not standard extension, collapse non user code frames into "[External Code]" frame (Just My Code only).
+        ctx.sharedDebugger->SetCollapseExternalCode(arguments.value("collapseExternalCode", false));
+        IfFailRet(ctx.sharedDebugger->SetCodeCoverage(arguments.value("coverageOutput", std::string())));
 
-        if (!fileExec.empty())
-            return sharedDebugger->Launch(fileExec, execArgs, env, cwd, arguments.value("stopAtEntry", false));
+        if (!ctx.fileExec.empty())
+            return ctx.sharedDebugger->Launch(ctx.fileExec, ctx.execArgs, env, cwd, arguments.value("stopAtEntry", false));
 
         std::vector<std::string> args = arguments.value("args", std::vector<std::string>());
         args.insert(args.begin(), arguments.at("program").get<std::string>());
 
-        return sharedDebugger->Launch("dotnet", args, env, cwd, arguments.value("stopAtEntry", false));
+        return ctx.sharedDebugger->Launch("dotnet", args, env, cwd, arguments.value("stopAtEntry", false));
     } },
-    { "threads", [&](const json &arguments, json &body){
-        HRESULT Status;
-        std::vector<Thread> threads;
-        IfFailRet(sharedDebugger->GetThreads(threads));
-
-        body["threads"] = threads;
-
-        return S_OK;
-    } },
-    { "disconnect", [&](const json &arguments, json &body){
+    { "disconnect", [](CommandContext &ctx, const json &arguments, json &body){
         auto terminateArgIter = arguments.find("terminateDebuggee");
         IDebugger::DisconnectAction action;
         if (terminateArgIter == arguments.end())
@@ -625,94 +677,53 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         else
             action = terminateArgIter.value().get<bool>() ? IDebugger::DisconnectAction::DisconnectTerminate : IDebugger::DisconnectAction::DisconnectDetach;
 
-        sharedDebugger->Disconnect(action);
+        ctx.sharedDebugger->Disconnect(action);
 
         return S_OK;
     } },
-    { "terminate", [&](const json &arguments, json &body){
-        sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectTerminate);
-        return S_OK;
-    } },
-    { "stackTrace", [&](const json &arguments, json &body){
-        HRESULT Status;
-
-        int totalFrames = 0;
-        ThreadId threadId{int(arguments.at("threadId"))};
-
-        std::vector<StackFrame> stackFrames;
-        IfFailRet(sharedDebugger->GetStackTrace(
-            threadId,
-            FrameLevel{arguments.value("startFrame", 0)},
-            unsigned(arguments.value("levels", 0)),
-            stackFrames,
-            totalFrames
-            ));
-
-        body["stackFrames"] = stackFrames;
-        body["totalFrames"] = totalFrames;
-
+    { "terminate", [](CommandContext &ctx, const json &arguments, json &body){
+        ctx.sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectTerminate);
         return S_OK;
     } },
-    { "continue", [&](const json &arguments, json &body){
+    { "continue", [](CommandContext &ctx, const json &arguments, json &body){
         body["allThreadsContinued"] = true;
 
         ThreadId threadId{int(arguments.at("threadId"))};
         body["threadId"] = int(threadId);
-        return sharedDebugger->Continue(threadId);
+        return ctx.sharedDebugger->Continue(threadId);
     } },
-    { "pause", [&](const json &arguments, json &body){
+    { "pause", [](CommandContext &ctx, const json &arguments, json &body){
         ThreadId threadId{int(arguments.at("threadId"))};
         body["threadId"] = int(threadId);
-        return sharedDebugger->Pause(threadId, EventFormat::Default);
+        return ctx.sharedDebugger->Pause(threadId, EventFormat::Default);
     } },
-    { "next", [&](const json &arguments, json &body){
-        return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_OVER);
+    { "next", [](CommandContext &ctx, const json &arguments, json &body){
+        return ctx.sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_OVER);
     } },
-    { "stepIn", [&](const json &arguments, json &body){
-        return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_IN);
+    { "stepIn", [](CommandContext &ctx, const json &arguments, json &body){
+        return ctx.sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_IN);
     } },
-    { "stepOut", [&](const json &arguments, json &body){
-        return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_OUT);
+    { "stepOut", [](CommandContext &ctx, const json &arguments, json &body){
+        return ctx.sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_OUT);
     } },
-    { "scopes", [&](const json &arguments, json &body){
+    { "scopes", [](CommandContext &ctx, const json &arguments, json &body){
         HRESULT Status;
         std::vector<Scope> scopes;
         FrameId frameId{int(arguments.at("frameId"))};
-        IfFailRet(sharedDebugger->GetScopes(frameId, scopes));
+        IfFailRet(ctx.sharedDebugger->GetScopes(frameId, scopes));
 
         body["scopes"] = scopes;
 
         return S_OK;
     } },
-    { "variables", [&](const json &arguments, json &body){
-        HRESULT Status;
-        std::string filterName = arguments.value("filter", "");
-        VariablesFilter filter = VariablesBoth;
-        if (filterName == "named")
-            filter = VariablesNamed;
-        else if (filterName == "indexed")
-            filter = VariablesIndexed;
-
-        std::vector<Variable> variables;
-        IfFailRet(sharedDebugger->GetVariables(
-            arguments.at("variablesReference"),
-            filter,
-            arguments.value("start", 0),
-            arguments.value("count", 0),
-            variables));
-
-        body["variables"] = variables;
-
-        return S_OK;
-    } },
-    { "evaluate", [&](const json &arguments, json &body){
+    { "evaluate", [](CommandContext &ctx, const json &arguments, json &body){
         HRESULT Status;
         std::string expression = arguments.at("expression");
         FrameId frameId([&](){
             auto frameIdIter = arguments.find("frameId");
             if (frameIdIter == arguments.end())
             {
-                ThreadId threadId = sharedDebugger->GetLastStoppedThreadId();
+                ThreadId threadId = ctx.sharedDebugger->GetLastStoppedThreadId();
                 return FrameId{threadId, FrameLevel{0}};
             }
             else {
@@ -725,7 +736,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         // https://github.com/OmniSharp/omnisharp-vscode/issues/3173
         Variable variable;
         std::string output;
-        Status = sharedDebugger->Evaluate(frameId, expression, variable, output);
+        Status = ctx.sharedDebugger->Evaluate(frameId, expression, variable, output);
         if (FAILED(Status))
         {
             if (output.empty())
@@ -750,7 +761,228 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         }
         return S_OK;
     } },
-    { "setExpression", [&](const json &arguments, json &body){
+    // Custom request (not part of DAP), evaluate all expressions from `expressions` array for same frame at once.
+    // Response body have `results` array with same order as `expressions`, each entry is `evaluate` response body
+    // with additional `success` field.
+    { "evaluateBatch", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
+        std::vector<std::string> expressions = arguments.at("expressions");
+        FrameId frameId([&](){
+            auto frameIdIter = arguments.find("frameId");
+            if (frameIdIter == arguments.end())
+            {
+                ThreadId threadId = ctx.sharedDebugger->GetLastStoppedThreadId();
+                return FrameId{threadId, FrameLevel{0}};
+            }
+            else {
+                return FrameId{int(frameIdIter.value())};
+            }
+        }());
+
+        std::vector<IDebugger::EvaluateBatchResult> results;
+        IfFailRet(ctx.sharedDebugger->EvaluateBatch(frameId, defaultEvalFlags, expressions, results));
+
+        json jsonResults = json::array();
+        for (const auto &result : results)
+        {
+            json jsonResult;
+            jsonResult["success"] = SUCCEEDED(result.status);
+            if (FAILED(result.status))
+            {
+                if (result.output.empty())
+                {
+                    std::stringstream stream;
+                    stream << "error: 0x" << std::hex << result.status;
+                    jsonResult["message"] = stream.str();
+                }
+                else
+                    jsonResult["message"] = result.output;
+
+                jsonResults.push_back(jsonResult);
+                continue;
+            }
+
+            jsonResult["result"] = result.variable.value;
+            jsonResult["type"] = result.variable.type;
+            jsonResult["variablesReference"] = result.variable.variablesReference;
+            if (result.variable.variablesReference > 0)
+            {
+                jsonResult["namedVariables"] = result.variable.namedVariables;
+                // indexedVariables
+            }
+            jsonResults.push_back(jsonResult);
+        }
+        body["results"] = jsonResults;
+        return S_OK;
+    } },
+    { "asyncTasks", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
+        std::vector<AsyncTaskGroup> taskGroups;
+        IfFailRet(ctx.sharedDebugger->GetAsyncTasks(taskGroups));
+
+        json jsonGroups = json::array();
+        for (const auto &group : taskGroups)
+        {
+            json jsonGroup;
+            jsonGroup["count"] = group.count;
+
+            json jsonTasks = json::array();
+            for (const auto &task : group.tasks)
+            {
+                json jsonTask;
+                jsonTask["address"] = ProtocolUtils::AddrToString(std::uintptr_t(task.address));
+                jsonTask["status"] = task.status;
+                if (task.awaitedTask != 0)
+                    jsonTask["awaitedTask"] = ProtocolUtils::AddrToString(std::uintptr_t(task.awaitedTask));
+                jsonTasks.push_back(jsonTask);
+            }
+            jsonGroup["tasks"] = jsonTasks;
+
+            // Note, logical frames have no frame ID.
+            json jsonFrames = json::array();
+            for (const auto &frame : group.stackFrames)
+            {
+                json jsonFrame{
+                    {"name",      frame.methodName},
+                    {"line",      frame.line},
+                    {"column",    frame.column},
+                    {"endLine",   frame.endLine},
+                    {"endColumn", frame.endColumn},
+                    {"moduleId",  frame.moduleId}};
+                if (!frame.source.IsNull())
+                    jsonFrame["source"] = frame.source;
+                jsonFrames.push_back(jsonFrame);
+            }
+            jsonGroup["stackFrames"] = jsonFrames;
+
+            jsonGroups.push_back(jsonGroup);
+        }
+        body["groups"] = jsonGroups;
+        return S_OK;
+    } },
+    { "gcRootPaths", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
+        std::vector<GCRootPath> paths;
+        const uint32_t variablesReference = arguments.at("variablesReference");
+        IfFailRet(ctx.sharedDebugger->GetGCRootPaths(variablesReference, arguments.value("maxPaths", 10u), paths));
+
+        json jsonPaths = json::array();
+        for (const auto &path : paths)
+        {
+            json jsonObjects = json::array();
+            for (const auto &object : path.objects)
+            {
+                jsonObjects.push_back(json{{"address", ProtocolUtils::AddrToString(std::uintptr_t(object.address))}, {"type", object.typeName}});
+            }
+            jsonPaths.push_back(json{{"rootKind", path.rootKind}, {"objects", jsonObjects}});
+        }
+        body["paths"] = jsonPaths;
+        return S_OK;
+    } },
+    { "startSampling", [](CommandContext &ctx, const json &arguments, json &body){
+        return ctx.sharedDebugger->StartSampling(arguments.value("intervalMs", 0u));
+    } },
+    { "stopSampling", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
+        SamplingResult result;
+        IfFailRet(ctx.sharedDebugger->StopSampling(result));
+
+        body["samples"] = result.samples;
+        body["skippedSamples"] = result.skippedSamples;
+        body["averagePauseUs"] = result.samples != 0 ? result.totalPauseUs / result.samples : 0;
+        body["maxPauseUs"] = result.maxPauseUs;
+
+        // Folded stacks could be written directly into file for flame graph tools, since result could be big.
+        const std::string outputFile = arguments.value("outputFile", std::string());
+        if (!outputFile.empty())
+        {
+            if (FAILED(Status = ProtocolUtils::WriteFoldedStacks(outputFile, result.stacks)))
+                body["message"] = "Can't write file '" + outputFile + "'.";
+            return Status;
+        }
+
+        json jsonStacks = json::array();
+        for (const auto &stack : result.stacks)
+        {
+            jsonStacks.push_back(json{{"frames", stack.frames}, {"count", stack.count}});
+        }
+        body["stacks"] = jsonStacks;
+        return S_OK;
+    } },
+    { "startTraceRecording", [](CommandContext &ctx, const json &arguments, json &body){
+        return ctx.sharedDebugger->StartTraceRecording(arguments.at("outputFile").get<std::string>());
+    } },
+    { "stopTraceRecording", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
+        TraceRecordingStats stats;
+        IfFailRet(ctx.sharedDebugger->StopTraceRecording(stats));
+
+        body["records"] = stats.records;
+        body["lostRecords"] = stats.lostRecords;
+        body["bytes"] = stats.bytes;
+        body["durationUs"] = stats.durationUs;
+        body["recordsPerSecond"] = stats.durationUs != 0 ? stats.records * 1000000 / stats.durationUs : 0;
+        return S_OK;
+    } },
+    { "readTrace", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
+        TraceSummary summary;
+        IfFailRet(ctx.sharedDebugger->ReadTrace(arguments.at("traceFile").get<std::string>(), arguments.value("tracepointId", 0u),
+                                            arguments.value("maxRecords", 100u), summary));
+
+        body["startTimeUs"] = summary.startTimeUs;
+        body["hits"] = summary.hits;
+        json jsonTracepoints = json::array();
+        for (const auto &tracepoint : summary.tracepoints)
+        {
+            jsonTracepoints.push_back(json{{"id", tracepoint.id}, {"location", tracepoint.location}, {"expressions", tracepoint.expressions},
+                                           {"hits", tracepoint.hits}, {"firstTimeUs", tracepoint.firstTimeUs},
+                                           {"lastTimeUs", tracepoint.lastTimeUs}, {"threads", tracepoint.threads}});
+        }
+        body["tracepoints"] = jsonTracepoints;
+        json jsonRecords = json::array();
+        for (const auto &record : summary.records)
+        {
+            jsonRecords.push_back(json{{"tracepointId", record.tracepointId}, {"timeUs", record.timeUs},
+                                       {"threadId", record.threadId}, {"values", record.values}});
+        }
+        body["records"] = jsonRecords;
+        return S_OK;
+    } },
+    { "heapStats", [](CommandContext &ctx, const json &arguments, json &body){
+        HRESULT Status;
+        HeapStats heapStats;
+        IfFailRet(ctx.sharedDebugger->GetHeapStats(arguments.value("baseSnapshotId", 0u), heapStats));
+
+        // Note, heap could have thousands of types, client could request only biggest of them.
+        const size_t maxTypes = arguments.value("maxTypes", size_t(0));
+        json jsonTypes = json::array();
+        for (const auto &typeStats : heapStats.types)
+        {
+            if (maxTypes != 0 && jsonTypes.size() == maxTypes)
+                break;
+
+            json jsonType;
+            jsonType["type"] = typeStats.typeName;
+            jsonType["count"] = typeStats.count;
+            jsonType["size"] = typeStats.size;
+            if (heapStats.baseSnapshotId != 0)
+            {
+                jsonType["countDiff"] = typeStats.countDiff;
+                jsonType["sizeDiff"] = typeStats.sizeDiff;
+            }
+            jsonTypes.push_back(jsonType);
+        }
+
+        body["snapshotId"] = heapStats.snapshotId;
+        if (heapStats.baseSnapshotId != 0)
+            body["baseSnapshotId"] = heapStats.baseSnapshotId;
+        body["totalCount"] = heapStats.totalCount;
+        body["totalSize"] = heapStats.totalSize;
+        body["types"] = jsonTypes;
+        return S_OK;
+    } },
+    { "setExpression", [](CommandContext &ctx, const json &arguments, json &body){
         HRESULT Status;
         std::string expression = arguments.at("expression");
         std::string value = arguments.at("value");
@@ -758,7 +990,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
             auto frameIdIter = arguments.find("frameId");
             if (frameIdIter == arguments.end())
             {
-                ThreadId threadId = sharedDebugger->GetLastStoppedThreadId();
+                ThreadId threadId = ctx.sharedDebugger->GetLastStoppedThreadId();
                 return FrameId{threadId, FrameLevel{0}};
             }
             else {
@@ -770,7 +1002,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         // VSCode don't support evaluation flags, we can't disable implicit function calls during evaluation.
         // https://github.com/OmniSharp/omnisharp-vscode/issues/3173
         std::string output;
-        Status = sharedDebugger->SetExpression(frameId, expression, defaultEvalFlags, value, output);
+        Status = ctx.sharedDebugger->SetExpression(frameId, expression, defaultEvalFlags, value, output);
         if (FAILED(Status))
         {
             if (output.empty())
@@ -788,7 +1020,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         body["value"] = output;
         return S_OK;
     } },
-    { "attach", [&](const json &arguments, json &body){
+    { "attach", [](CommandContext &ctx, const json &arguments, json &body){
         int processId;
 
         const json &processIdArg = arguments.at("processId");
@@ -799,9 +1031,9 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         else
             return E_INVALIDARG;
 
-        return sharedDebugger->Attach(processId);
+        return ctx.sharedDebugger->Attach(processId);
     } },
-    { "setVariable", [&](const json &arguments, json &body) {
+    { "setVariable", [](CommandContext &ctx, const json &arguments, json &body) {
         HRESULT Status;
 
         std::string name = arguments.at("name");
@@ -809,7 +1041,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         int ref = arguments.at("variablesReference");
 
         std::string output;
-        Status = sharedDebugger->SetVariable(name, value, ref, output);
+        Status = ctx.sharedDebugger->SetVariable(name, value, ref, output);
         if (FAILED(Status))
         {
             body["message"] = output;
@@ -820,7 +1052,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         return S_OK;
     } },
-    { "setFunctionBreakpoints", [&](const json &arguments, json &body) {
+    { "setFunctionBreakpoints", [](CommandContext &ctx, const json &arguments, json &body) {
         HRESULT Status = S_OK;
 
         std::vector<FuncBreakpoint> funcBreakpoints;
@@ -848,10 +1080,11 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
             }
 
             funcBreakpoints.emplace_back(module, name, params, b.value("condition", std::string()));
+            funcBreakpoints.back().filters = GetBreakpointFilters(b);
         }
 
         std::vector<Breakpoint> breakpoints;
-        IfFailRet(sharedDebugger->SetFuncBreakpoints(funcBreakpoints, breakpoints));
+        IfFailRet(ctx.sharedDebugger->SetFuncBreakpoints(funcBreakpoints, breakpoints));
 
         body["breakpoints"] = breakpoints;
 
@@ -865,7 +1098,8 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         return E_NOTIMPL;
     }
 
-    return command_it->second(arguments, body);
+    CommandContext ctx{sharedDebugger, fileExec, execArgs};
+    return command_it->second(ctx, arguments, body);
 }
 
 static HRESULT HandleCommandJSON(std::shared_ptr<IDebugger> &sharedDebugger, std::string &fileExec, std::vector<std::string> &execArgs,
@@ -884,67 +1118,177 @@ static HRESULT HandleCommandJSON(std::shared_ptr<IDebugger> &sharedDebugger, std
     return E_FAIL;
 }
 
-static std::string ReadData(std::istream& cin)
+// Commands from g_streamedResponseCommandSet, response body serialized into rawBody.
+static HRESULT HandleStreamedCommand(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &command,
+                                     const json &arguments, const CancellationToken &token, std::string &rawBody)
 {
-    // parse header (only content len) until empty line
-    long content_len = -1;
-    while (true)
+    typedef std::function<HRESULT(std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments, const CancellationToken &token,
+                                  VSCodeJSONWriter &writer)> CommandCallback;
+    static std::unordered_map<std::string, CommandCallback> commands {
+    { "threads", [](std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments, const CancellationToken &token, VSCodeJSONWriter &writer){
+        HRESULT Status;
+        std::vector<Thread> threads;
+        IfFailRet(sharedDebugger->GetThreads(threads));
+
+        writer.StartObject();
+        WriteJSONArray(writer, "threads", threads);
+        writer.EndObject();
+
+        return S_OK;
+    } },
+    { "stackTrace", [](std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments, const CancellationToken &token, VSCodeJSONWriter &writer){
+        HRESULT Status;
+
+        int totalFrames = 0;
+        ThreadId threadId{int(arguments.at("threadId"))};
+
+        std::vector<StackFrame> stackFrames;
+        IfFailRet(sharedDebugger->GetStackTrace(
+            threadId,
+            FrameLevel{arguments.value("startFrame", 0)},
+            unsigned(arguments.value("levels", 0)),
+            stackFrames,
+            totalFrames,
+            false,
+            token
+            ));
+
+        writer.StartObject();
+        WriteJSONArray(writer, "stackFrames", stackFrames);
+        writer.Key("totalFrames");
+        writer.Int(totalFrames);
+        writer.EndObject();
+
+        return S_OK;
+    } },
+    { "variables", [](std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments, const CancellationToken &token, VSCodeJSONWriter &writer){
+        HRESULT Status;
+        std::string filterName = arguments.value("filter", "");
+        VariablesFilter filter = VariablesBoth;
+        if (filterName == "named")
+            filter = VariablesNamed;
+        else if (filterName == "indexed")
+            filter = VariablesIndexed;
+
+        std::vector<Variable> variables;
+        IfFailRet(sharedDebugger->GetVariables(
+            arguments.at("variablesReference"),
+            filter,
+            arguments.value("start", 0),
+            arguments.value("count", 0),
+            variables,
+            token));
+
+        writer.StartObject();
+        WriteJSONArray(writer, "variables", variables);
+        writer.EndObject();
+
+        return S_OK;
+    } } };
+
+    auto command_it = commands.find(command);
+    if (command_it == commands.end())
     {
-        std::string line;
-        std::getline(cin, line);
-        if (!cin.good())
-        {
-            if (cin.eof()) LOGI("EOF");
-            else LOGE("input stream reading error");
-            return {};
-        }
+        return E_NOTIMPL;
+    }
 
-        if (!line.empty() && line.back() == '\r')
-                line.pop_back();
+    VSCodeJSONWriter writer(rawBody);
+    return command_it->second(sharedDebugger, arguments, token, writer);
+}
 
-        if (line.empty())
-        {
-            if (content_len < 0)
-            {
-                LOGE("protocol error: no 'Content Length:' field!");
-                return {};
-            }
-            break;         // header and content delimiter
-        }
+static HRESULT HandleStreamedCommandJSON(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &command,
+                                         const json &arguments, const CancellationToken &token, std::string &rawBody, json &body)
+{
+    try
+    {
+        return HandleStreamedCommand(sharedDebugger, command, arguments, token, rawBody);
+    }
+    catch (nlohmann::detail::exception& ex)
+    {
+        LOGE("JSON error: %s", ex.what());
+        body["message"] = std::string("can't parse: ") + ex.what();
+    }
 
-        LOGD("header: '%s'", line.c_str());
+    return E_FAIL;
+}
 
-        if (line.size() > CONTENT_LENGTH.size()
-            && std::equal(CONTENT_LENGTH.begin(), CONTENT_LENGTH.end(), line.begin()))
-        {
-            if (content_len >= 0)
-                LOGW("protocol violation: duplicate '%s'", line.c_str());
+HRESULT VSCodeProtocol::ExecuteCommand(CommandQueueEntry &c, json &body, std::string &rawBody)
+{
+    Timeline::Scope timelineScope(c.command.c_str(), "request");
+    rawBody.clear();
+    if (g_streamedResponseCommandSet.find(c.command) != g_streamedResponseCommandSet.end())
+        return HandleStreamedCommandJSON(m_sharedDebugger, c.command, c.arguments, c.token, rawBody, body);
 
-            char *p;
-            errno = 0;
-            content_len = strtoul(&line[CONTENT_LENGTH.size()], &p, 10);
-            if (errno == ERANGE || !(*p == 0 || isspace(*p)))
-            {
-                LOGE("protocol violation: '%s'", line.c_str());
-                return {};
-            }
-        }
+    return HandleCommandJSON(m_sharedDebugger, m_fileExec, m_execArgs, c.command, c.arguments, body);
+}
+
+void VSCodeProtocol::EmitCommandResponse(CommandQueueEntry &c, HRESULT Status, json &body, const std::string &rawBody)
+{
+    const bool streamed = g_streamedResponseCommandSet.find(c.command) != g_streamedResponseCommandSet.end();
+    if (SUCCEEDED(Status) && streamed)
+    {
+        c.response["success"] = true;
+        EmitResponseWithRawBody(c.response, rawBody);
+        return;
     }
 
-    std::string result(content_len, 0);
-    if (!cin.read(&result[0], content_len))
+    if (SUCCEEDED(Status))
+    {
+        c.response["success"] = true;
+        c.response["body"] = body;
+    }
+    else if (c.token.IsCanceled())
     {
-        if (cin.eof()) LOGE("Unexpected EOF!");
-        else LOGE("input stream reading error");
-        return {};
+        c.response["message"] = std::string("Error processing '") + c.command + std::string("' request. The operation was canceled.");
+        c.response["success"] = false;
     }
+    else
+    {
+        if (body.find("message") == body.end())
+        {
+            std::ostringstream ss;
+            ss << "Failed command '" << c.command << "' : "
+            << "0x" << std::setw(8) << std::setfill('0') << std::hex << Status;
+            c.response["message"] = ss.str();
+        }
+        else
+            c.response["message"] = body["message"];
 
-    return result;
+        c.response["success"] = false;
+    }
+
+    EmitMessageWithLog(LOG_RESPONSE, c.response);
+}
+
+void VSCodeProtocol::ConcurrentCommandsWorker(std::list<CommandQueueEntry> &queue, std::condition_variable &queueCV)
+{
+    std::string rawBody; // reused for all streamed responses
+    std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
+
+    while (true)
+    {
+        queueCV.wait(lockCommandsMutex, [&]{ return m_concurrentCommandsExit || !queue.empty(); });
+        if (queue.empty()) // exit requested and all commands executed
+            break;
+
+        CommandQueueEntry c = std::move(queue.front());
+        queue.pop_front();
+        auto running = m_runningCommands.insert(m_runningCommands.end(), RunningCommand{c.response["request_seq"], c.command, c.token});
+        lockCommandsMutex.unlock();
+
+        json body = json::object();
+        HRESULT Status = ExecuteCommand(c, body, rawBody);
+        EmitCommandResponse(c, Status, body, rawBody);
+
+        lockCommandsMutex.lock();
+        m_runningCommands.erase(running);
+    }
 }
 
 void VSCodeProtocol::CommandsWorker()
 {
     std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
+    std::string rawBody; // reused for all streamed responses
 
     while (true)
     {
@@ -957,18 +1301,29 @@ void VSCodeProtocol::CommandsWorker()
 
         CommandQueueEntry c = std::move(m_commandsQueue.front());
         m_commandsQueue.pop_front();
-        lockCommandsMutex.unlock();
 
         // Check for ncdbg internal commands.
         if (c.command == "ncdbg_disconnect")
         {
+            lockCommandsMutex.unlock();
             m_sharedDebugger->Disconnect();
             break;
         }
 
+        // All previous commands are done, long command could be executed in parallel with next commands.
+        if (g_backgroundCommandSet.find(c.command) != g_backgroundCommandSet.end())
+        {
+            m_backgroundCommandsQueue.emplace_back(std::move(c));
+            m_backgroundCommandsCV.notify_one(); // notify_one with lock
+            continue;
+        }
+
+        auto running = m_runningCommands.insert(m_runningCommands.end(), RunningCommand{c.response["request_seq"], c.command, c.token});
+        lockCommandsMutex.unlock();
+
         json body = json::object();
         std::future<HRESULT> future = std::async(std::launch::async, [&](){
-            return HandleCommandJSON(m_sharedDebugger, m_fileExec, m_execArgs, c.command, c.arguments, body);
+            return ExecuteCommand(c, body, rawBody);
         });
         HRESULT Status;
         // Note, CommandsWorker() loop should never hangs, but even in case some command execution is timed out,
@@ -986,7 +1341,9 @@ void VSCodeProtocol::CommandsWorker()
         // we use max default timeout (15000), one timeout for all requests.
 
         // TODO add timeout configuration feature
-        std::future_status timeoutStatus = future.wait_for(std::chrono::milliseconds(15000));
+        std::future_status timeoutStatus = std::future_status::ready;
+        if (g_noTimeoutCommandSet.find(c.command) == g_noTimeoutCommandSet.end())
+            timeoutStatus = future.wait_for(std::chrono::milliseconds(15000));
         if (timeoutStatus == std::future_status::timeout)
         {
             body["message"] = "Command execution timed out.";
@@ -995,28 +1352,13 @@ void VSCodeProtocol::CommandsWorker()
         else
             Status = future.get();
 
-        if (SUCCEEDED(Status))
-        {
-            c.response["success"] = true;
-            c.response["body"] = body;
-        }
-        else
-        {
-            if (body.find("message") == body.end())
-            {
-                std::ostringstream ss;
-                ss << "Failed command '" << c.command << "' : "
-                << "0x" << std::setw(8) << std::setfill('0') << std::hex << Status;
-                c.response["message"] = ss.str();
-            }
-            else
-                c.response["message"] = body["message"];
+        EmitCommandResponse(c, Status, body, rawBody);
 
-            c.response["success"] = false;
+        {
+            std::lock_guard<std::mutex> guardCommandsMutex(m_commandsMutex);
+            m_runningCommands.erase(running);
         }
 
-        EmitMessageWithLog(LOG_RESPONSE, c.response);
-
         // Post command action.
         if (g_syncCommandExecutionSet.find(c.command) != g_syncCommandExecutionSet.end())
             m_commandSyncCV.notify_one();
@@ -1035,24 +1377,37 @@ void VSCodeProtocol::CommandsWorker()
 }
 
 // Caller must care about m_commandsMutex.
-std::list<VSCodeProtocol::CommandQueueEntry>::iterator VSCodeProtocol::CancelCommand(const std::list<VSCodeProtocol::CommandQueueEntry>::iterator &iter)
+std::list<VSCodeProtocol::CommandQueueEntry>::iterator VSCodeProtocol::CancelCommand(std::list<CommandQueueEntry> &queue,
+                                                                                    const std::list<CommandQueueEntry>::iterator &iter)
 {
     iter->response["success"] = false;
     iter->response["message"] = std::string("Error processing '") + iter->command + std::string("' request. The operation was canceled.");
     EmitMessageWithLog(LOG_RESPONSE, iter->response);
-    return m_commandsQueue.erase(iter);
+    return queue.erase(iter);
 }
 
 void VSCodeProtocol::CommandLoop()
 {
     std::thread commandsWorker{&VSCodeProtocol::CommandsWorker, this};
+    std::vector<std::thread> concurrentCommandsWorkers;
+    for (unsigned i = 0; i < ConcurrentCommandsWorkers; i++)
+    {
+        concurrentCommandsWorkers.emplace_back(&VSCodeProtocol::ConcurrentCommandsWorker, this,
+                                               std::ref(m_concurrentCommandsQueue), std::ref(m_concurrentCommandsCV));
+    }
+    std::thread backgroundCommandsWorker{&VSCodeProtocol::ConcurrentCommandsWorker, this,
+                                         std::ref(m_backgroundCommandsQueue), std::ref(m_backgroundCommandsCV)};
 
     m_exit = false;
 
+    // Note, request text buffer and parsed request are reused for all requests.
+    VSCodeFrameReader frameReader(cin.rdbuf());
+    std::string requestText;
+    VSCodeRequest request;
+
     while (!m_exit)
     {
-        std::string requestText = ReadData(cin);
-        if (requestText.empty())
+        if (frameReader.Read(requestText) != VSCodeFrameReader::Status::Ok || requestText.empty())
         {
             CommandQueueEntry queueEntry;
             queueEntry.command = "ncdbg_disconnect";
@@ -1076,7 +1431,9 @@ void VSCodeProtocol::CommandLoop()
         CommandQueueEntry queueEntry;
         try
         {
-            json request = json::parse(requestText);
+            ParseVSCodeRequest(requestText, request);
+            if (request.seq.is_null())
+                throw bad_format("no 'seq' field!");
 
             // Variable `resp' is used to construct response and assign it to `response'
             // variable in single step: `response' variable should always be in
@@ -1085,22 +1442,32 @@ void VSCodeProtocol::CommandLoop()
             // in exception handler.
             json resp;
             resp["type"] = "response";
-            resp["request_seq"] = request.at("seq");
+            resp["request_seq"] = request.seq;
             queueEntry.response = resp;
 
-            queueEntry.command = request.at("command");
+            if (request.command.empty())
+                throw bad_format("no 'command' field!");
+
+            queueEntry.command = std::move(request.command);
             resp["command"] = queueEntry.command;
             queueEntry.response = resp;
 
-            if (request["type"] != "request")
+            if (request.type != "request")
                 throw bad_format("wrong request type!");
 
-            auto argIter = request.find("arguments");
-            queueEntry.arguments = (argIter == request.end() ? json::object() : argIter.value());
+            queueEntry.arguments = std::move(request.arguments);
+            if (g_cancelableCommandSet.find(queueEntry.command) != g_cancelableCommandSet.end())
+                queueEntry.token = CancellationToken::Create();
+            // Note, reset is done here (not at walk start), since "cancel" could be received before command execution.
+            if (g_heapWalkCommandSet.find(queueEntry.command) != g_heapWalkCommandSet.end())
+                m_sharedDebugger->ResetHeapWalkCancel();
 
             // Pre command action.
             if (queueEntry.command == "initialize")
+            {
+                m_progressReporting = queueEntry.arguments.value("supportsProgressReporting", false);
                 EmitCapabilitiesEvent();
+            }
             else if (g_cancelCommandQueueSet.find(queueEntry.command) != g_cancelCommandQueueSet.end())
             {
                 std::lock_guard<std::mutex> guardCommandsMutex(m_commandsMutex);
@@ -1111,10 +1478,35 @@ void VSCodeProtocol::CommandLoop()
                     if (g_debuggerSetupCommandSet.find(iter->command) != g_debuggerSetupCommandSet.end())
                         ++iter;
                     else
-                        iter = CancelCommand(iter);
+                        iter = CancelCommand(m_commandsQueue, iter);
+                }
+                for (auto iter = m_concurrentCommandsQueue.begin(); iter != m_concurrentCommandsQueue.end();)
+                {
+                    iter = CancelCommand(m_concurrentCommandsQueue, iter);
+                }
+                for (auto iter = m_backgroundCommandsQueue.begin(); iter != m_backgroundCommandsQueue.end();)
+                {
+                    iter = CancelCommand(m_backgroundCommandsQueue, iter);
+                }
+                for (const auto &running : m_runningCommands)
+                {
+                    if (g_debuggerSetupCommandSet.find(running.command) == g_debuggerSetupCommandSet.end())
+                        running.token.Cancel();
                 }
             }
             // Note, in case "cancel" this is command implementation itself.
+            else if (queueEntry.command == "cancel" && queueEntry.arguments.find("progressId") != queueEntry.arguments.end())
+            {
+                // Running command could be canceled only in case it have progress (heap walk).
+                queueEntry.response["success"] = queueEntry.arguments.at("progressId") == "heapWalk";
+                if (queueEntry.response["success"])
+                    m_sharedDebugger->CancelHeapWalk();
+                else
+                    queueEntry.response["message"] = "CancelRequest is not supported for progressId.";
+
+                EmitMessageWithLog(LOG_RESPONSE, queueEntry.response);
+                continue;
+            }
             else if (queueEntry.command == "cancel")
             {
                 auto requestId = queueEntry.arguments.at("requestId");
@@ -1128,11 +1520,52 @@ void VSCodeProtocol::CommandLoop()
                     if (g_debuggerSetupCommandSet.find(iter->command) != g_debuggerSetupCommandSet.end())
                         break;
 
-                    CancelCommand(iter);
+                    CancelCommand(m_commandsQueue, iter);
+
+                    queueEntry.response["success"] = true;
+                    break;
+                }
+                for (auto iter = m_concurrentCommandsQueue.begin(); iter != m_concurrentCommandsQueue.end() && !queueEntry.response["success"]; ++iter)
+                {
+                    if (requestId != iter->response["request_seq"])
+                        continue;
+
+                    CancelCommand(m_concurrentCommandsQueue, iter);
+
+                    queueEntry.response["success"] = true;
+                    break;
+                }
+                for (auto iter = m_backgroundCommandsQueue.begin(); iter != m_backgroundCommandsQueue.end() && !queueEntry.response["success"]; ++iter)
+                {
+                    if (requestId != iter->response["request_seq"])
+                        continue;
+
+                    CancelCommand(m_backgroundCommandsQueue, iter);
 
                     queueEntry.response["success"] = true;
                     break;
                 }
+                // Command execution already started, stop it in case command support this.
+                for (auto iter = m_runningCommands.begin(); iter != m_runningCommands.end() && !queueEntry.response["success"]; ++iter)
+                {
+                    if (requestId != iter->requestSeq)
+                        continue;
+
+                    if (g_cancelableCommandSet.find(iter->command) != g_cancelableCommandSet.end())
+                    {
+                        iter->token.Cancel();
+                        if (iter->command == "evaluate")
+                            m_sharedDebugger->CancelEvalRunning();
+
+                        queueEntry.response["success"] = true;
+                    }
+                    else if (g_heapWalkCommandSet.find(iter->command) != g_heapWalkCommandSet.end())
+                    {
+                        m_sharedDebugger->CancelHeapWalk();
+                        queueEntry.response["success"] = true;
+                    }
+                    break;
+                }
                 lockCommandsMutex.unlock();
 
                 if (!queueEntry.response["success"])
@@ -1143,6 +1576,15 @@ void VSCodeProtocol::CommandLoop()
             }
 
             std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
+            // Read-only command could overtake running command, but not commands waiting in queue, in order to keep
+            // responses order relative to commands, that could change debuggee state.
+            if (m_commandsQueue.empty() && g_concurrentCommandSet.find(queueEntry.command) != g_concurrentCommandSet.end())
+            {
+                m_concurrentCommandsQueue.emplace_back(std::move(queueEntry));
+                m_concurrentCommandsCV.notify_one(); // notify_one with lock
+                continue;
+            }
+
             bool isCommandNeedSync = g_syncCommandExecutionSet.find(queueEntry.command) != g_syncCommandExecutionSet.end();
             m_commandsQueue.emplace_back(std::move(queueEntry));
             m_commandsCV.notify_one(); // notify_one with lock
@@ -1171,6 +1613,21 @@ void VSCodeProtocol::CommandLoop()
     }
 
     commandsWorker.join();
+
+    {
+        std::lock_guard<std::mutex> lockCommandsMutex(m_commandsMutex);
+        m_concurrentCommandsExit = true;
+    }
+    m_concurrentCommandsCV.notify_all();
+    m_backgroundCommandsCV.notify_all();
+    for (auto &worker : concurrentCommandsWorkers)
+    {
+        worker.join();
+    }
+    backgroundCommandsWorker.join();
+
+    // Deliver last responses and events (disconnect) before session teardown, debugger destruction could take time.
+    m_writer.Flush();
 }
 
 void VSCodeProtocol::EngineLogging(const std::string &path)
@@ -7,6 +7,7 @@
 #include <mutex>
 #include <string>
 #include <list>
+#include <atomic>
 #include <condition_variable>
 
 #pragma warning (disable:4068)  // Visual Studio should ignore GCC pragmas
@@ -16,6 +17,8 @@
 #pragma GCC diagnostic pop
 
 #include "interfaces/iprotocol.h"
+#include "protocols/protocolwriter.h"
+#include "utils/cancellation.h"
 
 namespace netcoredbg
 {
@@ -30,12 +33,16 @@ class VSCodeProtocol : public IProtocol
     } m_engineLogOutput;
     std::ofstream m_engineLog;
     uint64_t m_seqCounter; // Note, this counter must be covered by m_outMutex.
+    std::string m_outputBuffer; // Note, reused for streamed responses, must be covered by m_outMutex.
+    ProtocolWriter m_writer; // Note, messages must be queued under m_outMutex, in "seq" order.
 
     std::string m_fileExec;
     std::vector<std::string> m_execArgs;
+    std::atomic<bool> m_progressReporting; // client support progress events
 
     void EmitMessage(nlohmann::json &message, std::string &output);
     void EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message);
+    void EmitResponseWithRawBody(nlohmann::json &response, const std::string &rawBody);
     void EmitEvent(const std::string &name, const nlohmann::json &body);
 
     void Log(const std::string &prefix, const std::string &text);
@@ -45,20 +52,41 @@ class VSCodeProtocol : public IProtocol
         std::string command;
         nlohmann::json arguments;
         nlohmann::json response;
+        CancellationToken token;
+    };
+
+    // Commands in execution, could be canceled by client with "cancel" request.
+    struct RunningCommand
+    {
+        nlohmann::json requestSeq;
+        std::string command;
+        CancellationToken token;
     };
 
     std::mutex m_commandsMutex;
     std::condition_variable m_commandsCV;
     std::condition_variable m_commandSyncCV;
     std::list<CommandQueueEntry> m_commandsQueue;
+    // Read-only commands (see g_concurrentCommandSet), executed by concurrent workers, covered by m_commandsMutex.
+    std::condition_variable m_concurrentCommandsCV;
+    std::list<CommandQueueEntry> m_concurrentCommandsQueue;
+    // Long commands (see g_backgroundCommandSet), moved here by CommandsWorker() in queue order and executed by own
+    // worker, so, commands queue is not blocked during execution. Covered by m_commandsMutex.
+    std::condition_variable m_backgroundCommandsCV;
+    std::list<CommandQueueEntry> m_backgroundCommandsQueue;
+    bool m_concurrentCommandsExit; // exit for concurrent and background workers
+    std::list<RunningCommand> m_runningCommands; // covered by m_commandsMutex
 
     void CommandsWorker();
-    std::list<CommandQueueEntry>::iterator CancelCommand(const std::list<CommandQueueEntry>::iterator &iter);
+    void ConcurrentCommandsWorker(std::list<CommandQueueEntry> &queue, std::condition_variable &queueCV);
+    HRESULT ExecuteCommand(CommandQueueEntry &c, nlohmann::json &body, std::string &rawBody);
+    void EmitCommandResponse(CommandQueueEntry &c, HRESULT Status, nlohmann::json &body, const std::string &rawBody);
+    std::list<CommandQueueEntry>::iterator CancelCommand(std::list<CommandQueueEntry> &queue, const std::list<CommandQueueEntry>::iterator &iter);
 
 public:
 
     VSCodeProtocol(std::istream& input, std::ostream& output) :
-        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1) {}
+        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1), m_writer(output), m_progressReporting(false), m_concurrentCommandsExit(false) {}
     void EngineLogging(const std::string &path);
     void SetLaunchCommand(const std::string &fileExec, const std::vector<std::string> &args) override
     {
@@ -75,6 +103,7 @@ public:
     void EmitModuleEvent(const ModuleEvent &event) override;
     void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "", DWORD threadId = 0) override;
     void EmitBreakpointEvent(const BreakpointEvent &event) override;
+    void EmitProgressEvent(const ProgressEvent &event) override;
     void Cleanup() override;
     void CommandLoop() override;
 
@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/vscodeserializers.h"
+
+// for convenience
+using json = nlohmann::json;
+
+namespace netcoredbg
+{
+
+void to_json(json &j, const Source &s) {
+    j = json{{"name", s.name},
+             {"path", s.path}};
+}
+
+void to_json(json &j, const StackFrame &f) {
+    j = json{
+        {"id",        int(f.id)},
+        {"name",      f.methodName},
+        {"line",      f.line},
+        {"column",    f.column},
+        {"endLine",   f.endLine},
+        {"endColumn", f.endColumn},
+        {"moduleId",  f.moduleId}};
+    if (!f.source.IsNull())
+        j["source"] = f.source;
+    if (!f.presentationHint.empty())
+        j["presentationHint"] = f.presentationHint;
+}
+
+void to_json(json &j, const Thread &t) {
+    j = json{{"id",   int(t.id)},
+             {"name", t.name}};
+          // {"running", t.running}
+}
+
+void to_json(json &j, const Variable &v) {
+    j = json{
+        {"name",               v.name},
+        {"value",              v.value},
+        {"type",               v.type},
+        {"evaluateName",       v.evaluateName},
+        {"variablesReference", v.variablesReference}};
+
+    if (v.variablesReference > 0)
+    {
+        j["namedVariables"] = v.namedVariables;
+        // j["indexedVariables"] = v.indexedVariables;
+    }
+}
+
+// Note, keys must be written in sorted order (see VSCodeJSONWriter).
+void WriteJSON(VSCodeJSONWriter &writer, const Source &s)
+{
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(s.name);
+    writer.Key("path");
+    writer.String(s.path);
+    writer.EndObject();
+}
+
+void WriteJSON(VSCodeJSONWriter &writer, const StackFrame &f)
+{
+    writer.StartObject();
+    writer.Key("column");
+    writer.Int(f.column);
+    writer.Key("endColumn");
+    writer.Int(f.endColumn);
+    writer.Key("endLine");
+    writer.Int(f.endLine);
+    writer.Key("id");
+    writer.Int(int(f.id));
+    writer.Key("line");
+    writer.Int(f.line);
+    writer.Key("moduleId");
+    writer.String(f.moduleId);
+    writer.Key("name");
+    writer.String(f.methodName);
+    if (!f.presentationHint.empty())
+    {
+        writer.Key("presentationHint");
+        writer.String(f.presentationHint);
+    }
+    if (!f.source.IsNull())
+    {
+        writer.Key("source");
+        WriteJSON(writer, f.source);
+    }
+    writer.EndObject();
+}
+
+void WriteJSON(VSCodeJSONWriter &writer, const Thread &t)
+{
+    writer.StartObject();
+    writer.Key("id");
+    writer.Int(int(t.id));
+    writer.Key("name");
+    writer.String(t.name);
+    writer.EndObject();
+}
+
+void WriteJSON(VSCodeJSONWriter &writer, const Variable &v)
+{
+    writer.StartObject();
+    writer.Key("evaluateName");
+    writer.String(v.evaluateName);
+    writer.Key("name");
+    writer.String(v.name);
+    if (v.variablesReference > 0)
+    {
+        writer.Key("namedVariables");
+        writer.Int(v.namedVariables);
+    }
+    writer.Key("type");
+    writer.String(v.type);
+    writer.Key("value");
+    writer.String(v.value);
+    writer.Key("variablesReference");
+    writer.Unsigned(v.variablesReference);
+    writer.EndObject();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,44 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <vector>
+
+#pragma warning (disable:4068)  // Visual Studio should ignore GCC pragmas
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wtautological-overlap-compare"
+#include "json/json.hpp"
+#pragma GCC diagnostic pop
+
+#include "interfaces/types.h"
+#include "protocols/vscodewriter.h"
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+void to_json(nlohmann::json &j, const Source &s);
+void to_json(nlohmann::json &j, const StackFrame &f);
+void to_json(nlohmann::json &j, const Thread &t);
+void to_json(nlohmann::json &j, const Variable &v);
+
+// Direct serialization for hot responses, must provide same output as to_json() + json::dump() above.
+void WriteJSON(VSCodeJSONWriter &writer, const Source &s);
+void WriteJSON(VSCodeJSONWriter &writer, const StackFrame &f);
+void WriteJSON(VSCodeJSONWriter &writer, const Thread &t);
+void WriteJSON(VSCodeJSONWriter &writer, const Variable &v);
+
+template <class T>
+void WriteJSONArray(VSCodeJSONWriter &writer, Utility::string_view key, const std::vector<T> &values)
+{
+    writer.Key(key);
+    writer.StartArray();
+    for (const auto &value : values)
+    {
+        WriteJSON(writer, value);
+    }
+    writer.EndArray();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/vscodewriter.h"
+#include "protocols/escaped_string.h"
+
+namespace netcoredbg
+{
+
+// Allocate static memory for strings declared in JSON_escape_rules.
+const char JSON_escape_rules::forbidden_chars[35] =
+"\"\\"
+"\000\001\002\003\004\005\006\007\010\011\012\013\014\015\016\017"
+"\020\021\022\023\024\025\026\027\030\031\032\033\034\035\036\037";
+
+const Utility::string_view JSON_escape_rules::subst_chars[34] = {
+    "\\\"", "\\\\",
+    "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+    "\\b", "\\t", "\\n", "\\u000b", "\\f", "\\r", "\\u000e", "\\u000f",
+    "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+    "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f"
+};
+
+void VSCodeJSONWriter::Separator()
+{
+    if (m_afterKey)
+    {
+        m_afterKey = false;
+        return;
+    }
+
+    if (!m_first)
+        m_output.push_back(',');
+
+    m_first = false;
+}
+
+void VSCodeJSONWriter::StartObject()
+{
+    Separator();
+    m_output.push_back('{');
+    m_first = true;
+}
+
+void VSCodeJSONWriter::EndObject()
+{
+    m_output.push_back('}');
+    m_first = false;
+}
+
+void VSCodeJSONWriter::StartArray()
+{
+    Separator();
+    m_output.push_back('[');
+    m_first = true;
+}
+
+void VSCodeJSONWriter::EndArray()
+{
+    m_output.push_back(']');
+    m_first = false;
+}
+
+void VSCodeJSONWriter::Key(Utility::string_view key)
+{
+    String(key);
+    m_output.push_back(':');
+    m_afterKey = true;
+}
+
+void VSCodeJSONWriter::String(Utility::string_view str)
+{
+    Separator();
+    m_output.push_back('"');
+    EscapedString<JSON_escape_rules> escaped(str);
+    escaped([&](Utility::string_view chunk) { m_output.append(chunk.data(), chunk.size()); });
+    m_output.push_back('"');
+}
+
+void VSCodeJSONWriter::Int(int64_t value)
+{
+    if (value >= 0)
+    {
+        Unsigned(uint64_t(value));
+        return;
+    }
+
+    Separator();
+    m_output.push_back('-');
+    m_afterKey = true; // digits are part of same value
+    Unsigned(uint64_t(0) - uint64_t(value));
+}
+
+void VSCodeJSONWriter::Unsigned(uint64_t value)
+{
+    Separator();
+
+    char buf[20];
+    size_t size = 0;
+    do
+    {
+        buf[size++] = char('0' + value % 10);
+        value /= 10;
+    }
+    while (value != 0);
+
+    while (size > 0)
+    {
+        m_output.push_back(buf[--size]);
+    }
+}
+
+void VSCodeJSONWriter::Bool(bool value)
+{
+    Separator();
+    m_output.append(value ? "true" : "false");
+}
+
+void VSCodeJSONWriter::Raw(Utility::string_view json)
+{
+    Separator();
+    m_output.append(json.data(), json.size());
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,52 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Rules to escape characters in strings, in JSON (same escaping as nlohmann::json::dump() have).
+struct JSON_escape_rules
+{
+    // Note, arrays size must be known for EscapedString in all translation units ('"', '\\' and 32 control characters).
+    static const char forbidden_chars[35];
+    static const Utility::string_view subst_chars[34];
+    constexpr static const char escape_char = '\\';
+};
+
+// Streaming JSON writer for hot responses (stackTrace, variables, threads), values are written directly into output
+// buffer without DOM creation. Note, caller must write object keys in sorted order (nlohmann::json object is std::map),
+// so, output is byte-identical to nlohmann::json::dump() output for same data.
+class VSCodeJSONWriter
+{
+public:
+
+    VSCodeJSONWriter(std::string &output) : m_output(output), m_first(true), m_afterKey(false) {}
+
+    void StartObject();
+    void EndObject();
+    void StartArray();
+    void EndArray();
+    void Key(Utility::string_view key);
+    void String(Utility::string_view str);
+    void Int(int64_t value);
+    void Unsigned(uint64_t value);
+    void Bool(bool value);
+    // Already serialized JSON value.
+    void Raw(Utility::string_view json);
+
+private:
+
+    std::string &m_output;
+    bool m_first; // next value is first value in object or array
+    bool m_afterKey; // next value is key's value
+
+    void Separator();
+};
+
+} // namespace netcoredbg
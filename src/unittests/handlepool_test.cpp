@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include "debugger/handlepool.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Minimal handle value, only reference counting and interfaces query are implemented.
+    class FakeValue : public ICorDebugHandleValue
+    {
+    public:
+
+        FakeValue(bool isHandle = true) : m_isHandle(isHandle), m_refCount(1) {}
+
+        ULONG GetRefCount() const { return m_refCount; }
+
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, VOID** ppInterface) override
+        {
+            if (riid == IID_IUnknown || riid == IID_ICorDebugValue || riid == IID_ICorDebugReferenceValue ||
+                (riid == IID_ICorDebugHandleValue && m_isHandle))
+            {
+                *ppInterface = static_cast<ICorDebugHandleValue*>(this);
+                AddRef();
+                return S_OK;
+            }
+            *ppInterface = nullptr;
+            return E_NOINTERFACE;
+        }
+        ULONG STDMETHODCALLTYPE AddRef() override { return ++m_refCount; }
+        ULONG STDMETHODCALLTYPE Release() override { return --m_refCount; } // object is owned by test
+
+        HRESULT STDMETHODCALLTYPE GetType(CorElementType *pType) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetSize(ULONG32 *pSize) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetAddress(CORDB_ADDRESS *pAddress) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE CreateBreakpoint(ICorDebugValueBreakpoint **ppBreakpoint) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE IsNull(BOOL *pbNull) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetValue(CORDB_ADDRESS *pValue) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetValue(CORDB_ADDRESS value) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE Dereference(ICorDebugValue **ppValue) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE DereferenceStrong(ICorDebugValue **ppValue) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetHandleType(CorDebugHandleType *pType) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE Dispose() override { return E_NOTIMPL; }
+
+    private:
+
+        bool m_isHandle;
+        ULONG m_refCount;
+    };
+
+    // Return true in case pool provide expected value, false in case handle was already evicted or released.
+    bool Lookup(HandlePool &pool, HandlePool::HandleId id, ICorDebugValue *pExpected)
+    {
+        ToRelease<ICorDebugValue> iCorValue;
+        const HRESULT Status = pool.Get(id, &iCorValue);
+        REQUIRE(SUCCEEDED(Status));
+        if (Status == S_FALSE)
+        {
+            REQUIRE(iCorValue == nullptr);
+            return false;
+        }
+
+        REQUIRE(iCorValue.GetPtr() == pExpected);
+        return true;
+    }
+}
+
+TEST_CASE("HandlePool::Eviction")
+{
+    FakeValue a, b, c;
+    HandlePool pool(2);
+    HandlePool::HandleId idA, idB, idC;
+
+    REQUIRE(pool.Add(&a, HandlePool::Lifetime::Session, idA) == S_OK);
+    REQUIRE(pool.Add(&b, HandlePool::Lifetime::Session, idB) == S_OK);
+    CHECK(a.GetRefCount() == 2);
+
+    // `a` become most recently used, so, `b` is evicted.
+    CHECK(Lookup(pool, idA, &a));
+    REQUIRE(pool.Add(&c, HandlePool::Lifetime::Session, idC) == S_OK);
+
+    CHECK(!pool.IsAlive(idB));
+    CHECK(!Lookup(pool, idB, &b));
+    CHECK(b.GetRefCount() == 1);
+    CHECK(Lookup(pool, idA, &a));
+    CHECK(Lookup(pool, idC, &c));
+
+    const HandlePool::Counters counters = pool.GetCounters();
+    CHECK(counters.active == 2);
+    CHECK(counters.added == 3);
+    CHECK(counters.evicted == 1);
+    CHECK(counters.misses == 1);
+
+    pool.Clear();
+    CHECK(a.GetRefCount() == 1);
+    CHECK(c.GetRefCount() == 1);
+}
+
+TEST_CASE("HandlePool::PinnedBreakHandles")
+{
+    FakeValue session, x, y, z;
+    HandlePool pool(2);
+    HandlePool::HandleId idSession, idX, idY, idZ;
+
+    REQUIRE(pool.Add(&session, HandlePool::Lifetime::Session, idSession) == S_OK);
+    REQUIRE(pool.Add(&x, HandlePool::Lifetime::Break, idX) == S_OK);
+    // Pool is full, session handle is evicted instead of break handle.
+    REQUIRE(pool.Add(&y, HandlePool::Lifetime::Break, idY) == S_OK);
+    CHECK(!pool.IsAlive(idSession));
+    // Only pinned handles in pool, budget is exceeded.
+    REQUIRE(pool.Add(&z, HandlePool::Lifetime::Break, idZ) == S_OK);
+    CHECK(Lookup(pool, idX, &x));
+    CHECK(Lookup(pool, idY, &y));
+    CHECK(Lookup(pool, idZ, &z));
+
+    HandlePool::Counters counters = pool.GetCounters();
+    CHECK(counters.active == 3);
+    CHECK(counters.peak == 3);
+    CHECK(counters.evicted == 1);
+    CHECK(counters.overBudget == 1);
+
+    REQUIRE(pool.Add(&session, HandlePool::Lifetime::Session, idSession) == S_OK);
+    pool.ReleaseBreakHandles();
+    CHECK(!Lookup(pool, idX, &x));
+    CHECK(!Lookup(pool, idY, &y));
+    CHECK(!Lookup(pool, idZ, &z));
+    CHECK(x.GetRefCount() == 1);
+    CHECK(y.GetRefCount() == 1);
+    CHECK(z.GetRefCount() == 1);
+    CHECK(Lookup(pool, idSession, &session));
+
+    counters = pool.GetCounters();
+    CHECK(counters.active == 1);
+    CHECK(counters.released == 3);
+    CHECK(counters.misses == 3);
+}
+
+TEST_CASE("HandlePool::Misses")
+{
+    FakeValue value, notHandle(false);
+    HandlePool pool;
+    HandlePool::HandleId id = HandlePool::InvalidHandleId;
+
+    CHECK(!HandlePool::IsHandle(nullptr));
+    CHECK(!HandlePool::IsHandle(&notHandle));
+    CHECK(pool.Add(&notHandle, HandlePool::Lifetime::Break, id) == E_INVALIDARG);
+    CHECK(notHandle.GetRefCount() == 1);
+
+    CHECK(!Lookup(pool, HandlePool::InvalidHandleId, nullptr));
+    CHECK(!Lookup(pool, 12345, nullptr));
+
+    REQUIRE(pool.Add(&value, HandlePool::Lifetime::Break, id) == S_OK);
+    CHECK(id != HandlePool::InvalidHandleId);
+    CHECK(Lookup(pool, id, &value));
+    pool.Clear();
+    CHECK(!Lookup(pool, id, &value));
+    CHECK(value.GetRefCount() == 1);
+}
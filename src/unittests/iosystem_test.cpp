@@ -114,6 +114,40 @@ TEST_CASE("IOSystem::pipe")
     IOSystem::close(pipe.first);
 }
 
+#ifndef WIN32
+TEST_CASE("IOSystem::async_wait_file")
+{
+    // regular file can't be waited by epoll, but it is always ready (stdin could be redirected from file)
+    char name[] = "/tmp/iosystem_testXXXXXX";
+    int fd = ::mkstemp(name);
+    REQUIRE(fd != -1);
+    ::unlink(name);
+    IOSystem::FileHandle file{fd};
+
+    auto result = IOSystem::write(file, test_str, sizeof(test_str)-1);
+    CHECK(result.status == IOSystem::IOResult::Success);
+    REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+
+    char buf[sizeof(test_str)];
+    IOSystem::AsyncHandle async_handles[1] = {IOSystem::async_read(file, buf, sizeof(buf))};
+    REQUIRE(async_handles[0]);
+    CHECK(IOSystem::async_wait(async_handles, &async_handles[1], std::chrono::milliseconds(1000)));
+
+    result = IOSystem::async_result(async_handles[0]);
+    CHECK(result.status == IOSystem::IOResult::Success);
+    CHECK(result.size == sizeof(test_str)-1);
+    CHECK(memcmp(buf, test_str, sizeof(test_str)-1) == 0);
+
+    // check, that end of file is reported without blocking
+    async_handles[0] = IOSystem::async_read(file, buf, sizeof(buf));
+    CHECK(IOSystem::async_wait(async_handles, &async_handles[1], std::chrono::milliseconds(1000)));
+    result = IOSystem::async_result(async_handles[0]);
+    CHECK(result.status == IOSystem::IOResult::Eof);
+
+    IOSystem::close(file);
+}
+#endif // WIN32
+
 
 // Function creates TCP socket and connects to specified port on localhost.
 // Return value is empty FileHandle (in case of error) or FileHandle containing connected socket.
@@ -216,6 +250,44 @@ TEST_CASE("IOSystem::socket")
 }
 
 
+// Check, that few connections could be accepted by same listening socket.
+TEST_CASE("IOSystem::server_socket")
+{
+    unsigned port = 0;
+    IOSystem::FileHandle listener;
+
+    srand(unsigned(time(NULL)));
+    for (unsigned retry = 0; retry < 10 && !listener; retry++)
+    {
+        // selecting random port in range 1024..32767
+        port = rand()%32768 + 1024;
+        listener = IOSystem::server_socket(port, 2);
+    }
+    REQUIRE(listener);
+
+    for (int n = 0; n < 2; n++)
+    {
+        IOSystem::FileHandle conn = connect_to(port);
+        REQUIRE(conn);
+        IOSystem::FileHandle sock = IOSystem::accept_socket(listener);
+        REQUIRE(sock);
+
+        auto result = IOSystem::write(conn, test_str, sizeof(test_str)-1);
+        CHECK(result.status == IOSystem::IOResult::Success);
+
+        char buf[1024];
+        result = IOSystem::read(sock, buf, sizeof(buf));
+        CHECK(result.status == IOSystem::IOResult::Success);
+        CHECK(result.size == sizeof(test_str)-1);
+
+        IOSystem::close(conn);
+        IOSystem::close(sock);
+    }
+
+    IOSystem::close(listener);
+}
+
+
 TEST_CASE("IOSystem::StdIOSwap")
 {
     char buf[1024];
@@ -336,3 +408,81 @@ TEST_CASE("IOSystem::select_socket")
     //check_select(socket_pair());
 }
 
+
+// Check, that async_wait() see data in new pipe, which got descriptor numbers of closed one.
+TEST_CASE("IOSystem::async_wait_reused_descriptor")
+{
+    char buf[64];
+    for (int n = 0; n < 3; n++)
+    {
+        auto pipe = IOSystem::unnamed_pipe();
+        REQUIRE(pipe.first);
+        REQUIRE(pipe.second);
+
+        IOSystem::AsyncHandle h = IOSystem::async_read(pipe.first, buf, sizeof(buf));
+        REQUIRE(!!h);
+        CHECK(!IOSystem::async_wait(&h, &h + 1, std::chrono::milliseconds(10)));
+
+        REQUIRE(IOSystem::write(pipe.second, test_str, sizeof(test_str)-1).status == IOSystem::IOResult::Success);
+        CHECK(IOSystem::async_wait(&h, &h + 1, std::chrono::milliseconds(1000)));
+        auto result = IOSystem::async_result(h);
+        CHECK(result.status == IOSystem::IOResult::Success);
+        CHECK(result.size == sizeof(test_str)-1);
+
+        IOSystem::close(pipe.second);
+        IOSystem::close(pipe.first);
+    }
+}
+
+// Throughput of async_wait()/async_read() loop, not run by default (use "[benchmark]" tag).
+TEST_CASE("IOSystem::async_wait_throughput", "[.][benchmark]")
+{
+    auto pipe = IOSystem::unnamed_pipe();
+    REQUIRE(pipe.first);
+    REQUIRE(pipe.second);
+
+    static const size_t total = size_t(256) * 1024 * 1024;
+    std::thread writer {
+        [&]{
+            static char data[64 * 1024];
+            size_t written = 0;
+            while (written < total)
+            {
+                auto result = IOSystem::write(pipe.second, data, sizeof(data));
+                if (result.status != IOSystem::IOResult::Success)
+                    break;
+                written += result.size;
+            }
+            IOSystem::close(pipe.second);
+        }
+    };
+
+    static char buf[64 * 1024];
+    size_t received = 0;
+    unsigned waits = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (true)
+    {
+        IOSystem::AsyncHandle h = IOSystem::async_read(pipe.first, buf, sizeof(buf));
+        REQUIRE(!!h);
+        IOSystem::async_wait(&h, &h + 1, std::chrono::milliseconds(1000));
+        waits++;
+        auto result = IOSystem::async_result(h);
+        if (result.status == IOSystem::IOResult::Pending)
+        {
+            IOSystem::async_cancel(h);
+            continue;
+        }
+        if (result.status != IOSystem::IOResult::Success)
+            break;
+        received += result.size;
+    }
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    writer.join();
+    IOSystem::close(pipe.first);
+
+    CHECK(received == total);
+    printf("async_wait throughput: %zu bytes, %u waits, %.1f MB/s\n",
+           received, waits, usec ? double(received) / double(usec) : 0.0);
+}
@@ -0,0 +1,30 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "metadata/modules_sources_index.h"
+
+using namespace netcoredbg;
+
+TEST_CASE("ModuleSourcesIndex")
+{
+    ModuleSourcesIndex index;
+    CHECK(index.Get(0x10000).empty());
+
+    index.Add(0x10000, 5);
+    index.Add(0x10000, 1);
+    index.Add(0x20000, 1); // same source file in another module
+    index.Add(0x10000, 5); // new methods data for same file (Hot Reload)
+
+    const ModuleSourcesIndex::FullPathIndexes &first = index.Get(0x10000);
+    CHECK(std::vector<unsigned>(first.begin(), first.end()) == std::vector<unsigned>{1, 5});
+
+    const ModuleSourcesIndex::FullPathIndexes &second = index.Get(0x20000);
+    CHECK(std::vector<unsigned>(second.begin(), second.end()) == std::vector<unsigned>{1});
+
+    CHECK(index.Get(0x30000).empty());
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "debugger/outputaggregator.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    struct Emitted
+    {
+        std::mutex mutex;
+        std::vector<std::pair<OutputCategory, std::string>> events;
+
+        OutputAggregator::EmitCallback Callback()
+        {
+            return [this](OutputCategory category, string_view text)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                events.emplace_back(category, std::string(text.data(), text.size()));
+            };
+        }
+
+        size_t Size()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return events.size();
+        }
+    };
+
+    // Long enough window, so, background thread don't emit data during test.
+    const std::chrono::milliseconds LongWindow(60 * 1000);
+}
+
+TEST_CASE("OutputAggregator::Coalesce")
+{
+    Emitted emitted;
+    OutputAggregator aggregator(emitted.Callback(), LongWindow);
+
+    aggregator.Append(OutputStdOut, "a");
+    aggregator.Append(OutputStdOut, "");
+    aggregator.Append(OutputStdOut, "b");
+    aggregator.Append(OutputStdErr, "c");
+    aggregator.Append(OutputStdOut, "d");
+    CHECK(emitted.Size() == 0);
+
+    aggregator.Flush();
+    REQUIRE(emitted.events.size() == 3);
+    CHECK(emitted.events[0] == std::make_pair(OutputStdOut, std::string("ab")));
+    CHECK(emitted.events[1] == std::make_pair(OutputStdErr, std::string("c")));
+    CHECK(emitted.events[2] == std::make_pair(OutputStdOut, std::string("d")));
+
+    const OutputAggregator::Stats stats = aggregator.GetStats();
+    CHECK(stats.emittedBytes == 4);
+    CHECK(stats.droppedBytes == 0);
+    CHECK(stats.droppedChunks == 0);
+
+    // Nothing pending, nothing emitted.
+    aggregator.Flush();
+    CHECK(emitted.Size() == 3);
+}
+
+TEST_CASE("OutputAggregator::FlushSize")
+{
+    Emitted emitted;
+    OutputAggregator aggregator(emitted.Callback(), LongWindow, 4);
+
+    aggregator.Append(OutputStdOut, "123");
+    aggregator.Append(OutputStdOut, "45");
+
+    // Background thread must emit data without waiting for window end.
+    for (int i = 0; i < 500 && emitted.Size() == 0; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(emitted.Size() == 1);
+    CHECK(emitted.events[0] == std::make_pair(OutputStdOut, std::string("12345")));
+}
+
+TEST_CASE("OutputAggregator::Drop")
+{
+    Emitted emitted;
+    OutputAggregator aggregator(emitted.Callback(), LongWindow, OutputAggregator::DefaultFlushSize, 4);
+
+    aggregator.Append(OutputStdOut, "1234");
+    // Limit reached, producer blocked for some time and data dropped.
+    aggregator.Append(OutputStdOut, "5");
+    aggregator.Append(OutputStdErr, "67");
+
+    OutputAggregator::Stats stats = aggregator.GetStats();
+    CHECK(stats.emittedBytes == 0);
+    CHECK(stats.droppedBytes == 3);
+    CHECK(stats.droppedChunks == 2);
+
+    aggregator.Flush();
+    REQUIRE(emitted.events.size() == 2);
+    CHECK(emitted.events[0] == std::make_pair(OutputStdOut, std::string("1234")));
+    CHECK(emitted.events[1].first == OutputConsole);
+    CHECK(emitted.events[1].second.find(" 3 bytes ") != std::string::npos);
+
+    // Space available again.
+    aggregator.Append(OutputStdOut, "8");
+    aggregator.Flush();
+    REQUIRE(emitted.events.size() == 3);
+    CHECK(emitted.events[2] == std::make_pair(OutputStdOut, std::string("8")));
+
+    stats = aggregator.GetStats();
+    CHECK(stats.emittedBytes == 5);
+    CHECK(stats.droppedBytes == 3);
+    CHECK(stats.droppedChunks == 2);
+}
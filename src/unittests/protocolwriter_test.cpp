@@ -0,0 +1,119 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include "protocols/protocolwriter.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Stream buffer that collect output, write could be blocked until Release() call (slow client).
+    class BlockingBuf : public std::streambuf
+    {
+    public:
+
+        BlockingBuf(bool blocked) : m_blocked(blocked) {}
+
+        void Release()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_blocked = false;
+            m_cv.notify_all();
+        }
+
+        std::string Data()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_data;
+        }
+
+    protected:
+
+        std::streamsize xsputn(const char *s, std::streamsize n) override
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]{ return !m_blocked; });
+            m_data.append(s, size_t(n));
+            return n;
+        }
+
+        int_type overflow(int_type ch) override
+        {
+            if (traits_type::eq_int_type(ch, traits_type::eof()))
+                return traits_type::not_eof(ch);
+
+            char c = traits_type::to_char_type(ch);
+            xsputn(&c, 1);
+            return ch;
+        }
+
+    private:
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_blocked;
+        std::string m_data;
+    };
+}
+
+TEST_CASE("ProtocolWriter::Order")
+{
+    BlockingBuf buf(false);
+    std::ostream output(&buf);
+    std::string expected;
+    {
+        ProtocolWriter writer(output);
+        for (int i = 0; i < 1000; i++)
+        {
+            std::string message = "message " + std::to_string(i) + "\n";
+            expected += message;
+            writer.Write(std::move(message));
+        }
+        writer.Flush();
+        CHECK(buf.Data() == expected);
+
+        writer.Write("last\n");
+        expected += "last\n";
+    }
+    // Destructor write all queued messages.
+    CHECK(buf.Data() == expected);
+}
+
+TEST_CASE("ProtocolWriter::QueueLimit")
+{
+    BlockingBuf buf(true);
+    std::ostream output(&buf);
+    ProtocolWriter writer(output, 10);
+
+    // Message bigger than limit is accepted into empty queue.
+    writer.Write(std::string(20, 'a'));
+
+    std::atomic<bool> written(false);
+    std::thread producer([&]{
+        writer.Write("b");
+        written = true;
+    });
+
+    // Producer must be blocked, since client don't read output.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(!written);
+
+    buf.Release();
+    producer.join();
+    CHECK(written);
+
+    writer.Flush();
+    CHECK(buf.Data() == std::string(20, 'a') + "b");
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "json/json.hpp"
+#include "utils/timeline.h"
+
+using namespace netcoredbg;
+using json = nlohmann::json;
+
+TEST_CASE("Timeline::Scope")
+{
+    const std::string traceFile = "timeline_test.json";
+
+    {
+        // Not started timeline, nothing recorded.
+        Timeline::Scope scope("disabled", "test");
+        CHECK(!scope.IsEnabled());
+    }
+
+    REQUIRE(Timeline::Start(traceFile));
+    CHECK(Timeline::IsEnabled());
+    {
+        Timeline::Scope scope("outer", "test");
+        REQUIRE(scope.IsEnabled());
+        scope.SetDetail("path \"C:\\dir\"\n");
+
+        std::thread([]{ Timeline::Scope inner("inner", "test"); }).join();
+        Timeline::Instant("instant", "test");
+    }
+    Timeline::Stop();
+    CHECK(!Timeline::IsEnabled());
+    Timeline::Stop(); // second call ignored
+
+    {
+        Timeline::Scope scope("stopped", "test");
+        CHECK(!scope.IsEnabled());
+    }
+
+    std::ifstream input(traceFile);
+    REQUIRE(input.is_open());
+    std::stringstream content;
+    content << input.rdbuf();
+    input.close();
+    std::remove(traceFile.c_str());
+
+    json events = json::parse(content.str());
+    REQUIRE(events.is_array());
+    REQUIRE(events.size() == 4);
+
+    CHECK(events[0]["ph"] == "M");
+    // Events are written at scope end.
+    CHECK(events[1]["name"] == "inner");
+    CHECK(events[1]["ph"] == "X");
+    CHECK(events[2]["name"] == "instant");
+    CHECK(events[2]["ph"] == "i");
+    CHECK(events[3]["name"] == "outer");
+    CHECK(events[3]["cat"] == "test");
+    CHECK(events[3]["args"]["detail"] == "path \"C:\\dir\"\n");
+    CHECK(events[1]["tid"] != events[3]["tid"]);
+    CHECK(events[3]["ts"].get<unsigned long long>() <= events[1]["ts"].get<unsigned long long>());
+    CHECK(events[3]["ts"].get<unsigned long long>() + events[3]["dur"].get<unsigned long long>() >=
+          events[1]["ts"].get<unsigned long long>() + events[1]["dur"].get<unsigned long long>());
+}
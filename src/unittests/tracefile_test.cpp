@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "utils/tracefile.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    std::string ToString(const std::vector<char> &buffer)
+    {
+        return std::string(buffer.begin(), buffer.end());
+    }
+}
+
+TEST_CASE("TraceFile::RoundTrip")
+{
+    std::vector<char> buffer;
+    TraceFile::AppendHeader(buffer, 123456789);
+    CHECK(buffer.size() == 16);
+
+    const std::vector<std::string> expressions{"i", "obj.Name"};
+    size_t size = buffer.size();
+    TraceFile::AppendDefinition(buffer, 7, "Program.cs:10", expressions);
+    CHECK(buffer.size() - size == TraceFile::DefinitionSize("Program.cs:10", expressions));
+
+    const std::vector<std::string> values{"1", ""};
+    size = buffer.size();
+    TraceFile::AppendHit(buffer, 7, 1000, 42, values);
+    CHECK(buffer.size() - size == TraceFile::HitSize(values));
+
+    std::istringstream input(ToString(buffer));
+    TraceFile::Reader reader(input);
+    uint64_t startTimeUs = 0;
+    REQUIRE(reader.ReadHeader(startTimeUs));
+    CHECK(startTimeUs == 123456789);
+
+    TraceFile::Record record;
+    REQUIRE(reader.ReadRecord(record) == TraceFile::Reader::Ok);
+    CHECK(record.type == TraceFile::DefinitionRecord);
+    CHECK(record.id == 7);
+    CHECK(record.location == "Program.cs:10");
+    CHECK(record.strings == expressions);
+
+    REQUIRE(reader.ReadRecord(record) == TraceFile::Reader::Ok);
+    CHECK(record.type == TraceFile::HitRecord);
+    CHECK(record.id == 7);
+    CHECK(record.timeUs == 1000);
+    CHECK(record.threadId == 42);
+    CHECK(record.strings == values);
+
+    CHECK(reader.ReadRecord(record) == TraceFile::Reader::End);
+}
+
+TEST_CASE("TraceFile::Redefinition")
+{
+    // Tracepoint changed during recording: second definition with same id, reader return both in file order.
+    std::vector<char> buffer;
+    TraceFile::AppendHeader(buffer, 0);
+    TraceFile::AppendDefinition(buffer, 1, "Program.cs:10", {"i"});
+    TraceFile::AppendHit(buffer, 1, 10, 1, {"0"});
+    TraceFile::AppendDefinition(buffer, 1, "Program.cs:10", {"i", "j"});
+    TraceFile::AppendHit(buffer, 1, 20, 1, {"1", "2"});
+
+    std::istringstream input(ToString(buffer));
+    TraceFile::Reader reader(input);
+    uint64_t startTimeUs;
+    REQUIRE(reader.ReadHeader(startTimeUs));
+
+    std::vector<TraceFile::RecordType> types;
+    std::vector<std::vector<std::string>> strings;
+    TraceFile::Record record;
+    while (reader.ReadRecord(record) == TraceFile::Reader::Ok)
+    {
+        types.push_back(record.type);
+        strings.push_back(record.strings);
+    }
+    CHECK(types == std::vector<TraceFile::RecordType>{TraceFile::DefinitionRecord, TraceFile::HitRecord,
+                                                        TraceFile::DefinitionRecord, TraceFile::HitRecord});
+    CHECK(strings[2] == std::vector<std::string>{"i", "j"});
+    CHECK(strings[3] == std::vector<std::string>{"1", "2"});
+}
+
+TEST_CASE("TraceFile::BrokenFile")
+{
+    std::vector<char> buffer;
+    TraceFile::AppendHeader(buffer, 0);
+
+    SECTION("wrong header")
+    {
+        buffer[0] = 'X';
+        std::istringstream input(ToString(buffer));
+        TraceFile::Reader reader(input);
+        uint64_t startTimeUs;
+        CHECK(!reader.ReadHeader(startTimeUs));
+    }
+
+    SECTION("truncated last record")
+    {
+        TraceFile::AppendHit(buffer, 1, 10, 1, {"value"});
+        TraceFile::AppendHit(buffer, 1, 20, 1, {"value"});
+        buffer.resize(buffer.size() - 2);
+
+        std::istringstream input(ToString(buffer));
+        TraceFile::Reader reader(input);
+        uint64_t startTimeUs;
+        REQUIRE(reader.ReadHeader(startTimeUs));
+        TraceFile::Record record;
+        CHECK(reader.ReadRecord(record) == TraceFile::Reader::Ok);
+        CHECK(reader.ReadRecord(record) == TraceFile::Reader::End);
+    }
+
+    SECTION("unknown record type")
+    {
+        buffer.push_back('Z');
+        std::istringstream input(ToString(buffer));
+        TraceFile::Reader reader(input);
+        uint64_t startTimeUs;
+        REQUIRE(reader.ReadHeader(startTimeUs));
+        TraceFile::Record record;
+        CHECK(reader.ReadRecord(record) == TraceFile::Reader::UnknownRecord);
+    }
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "protocols/vscodeframing.h"
+
+using namespace netcoredbg;
+using json = nlohmann::json;
+
+static std::string Frame(const std::string &message)
+{
+    return "Content-Length: " + std::to_string(message.size()) + "\r\n\r\n" + message;
+}
+
+TEST_CASE("VSCodeFraming::Read")
+{
+    std::stringbuf buf(Frame("{\"seq\":1}") + "Content-Length: 2\n\n{}" + Frame(""));
+    VSCodeFrameReader reader(&buf);
+    std::string message;
+
+    CHECK(reader.Read(message) == VSCodeFrameReader::Status::Ok);
+    CHECK(message == "{\"seq\":1}");
+
+    // LF only line endings
+    CHECK(reader.Read(message) == VSCodeFrameReader::Status::Ok);
+    CHECK(message == "{}");
+
+    CHECK(reader.Read(message) == VSCodeFrameReader::Status::Ok);
+    CHECK(message.empty());
+
+    CHECK(reader.Read(message) == VSCodeFrameReader::Status::Eof);
+}
+
+TEST_CASE("VSCodeFraming::ReadErrors")
+{
+    std::string message;
+
+    std::stringbuf noLength("Content-Type: utf-8\r\n\r\n{}");
+    CHECK(VSCodeFrameReader(&noLength).Read(message) == VSCodeFrameReader::Status::Error);
+
+    std::stringbuf badLength("Content-Length: 1x\r\n\r\n{}");
+    CHECK(VSCodeFrameReader(&badLength).Read(message) == VSCodeFrameReader::Status::Error);
+
+    std::stringbuf shortBody("Content-Length: 10\r\n\r\n{}");
+    CHECK(VSCodeFrameReader(&shortBody).Read(message) == VSCodeFrameReader::Status::Error);
+}
+
+TEST_CASE("VSCodeFraming::ParseRequest")
+{
+    VSCodeRequest request;
+    ParseVSCodeRequest(R"({"command":"setBreakpoints","extra":{"seq":5,"command":"x"},"arguments":)"
+                       R"({"source":{"path":"a.cs"},"breakpoints":[{"line":1},{"line":2,"condition":"i > 1"}]},)"
+                       R"("type":"request","seq":3})", request);
+
+    CHECK(request.seq == 3);
+    CHECK(request.type == "request");
+    CHECK(request.command == "setBreakpoints");
+    CHECK(request.arguments.at("source").at("path") == "a.cs");
+    REQUIRE(request.arguments.at("breakpoints").size() == 2);
+    CHECK(request.arguments.at("breakpoints")[1].at("condition") == "i > 1");
+    CHECK(request.arguments == json::parse(R"({"source":{"path":"a.cs"},"breakpoints":[{"line":1},{"line":2,"condition":"i > 1"}]})"));
+
+    ParseVSCodeRequest(R"({"seq":4,"type":"request","command":"threads"})", request);
+    CHECK(request.seq == 4);
+    CHECK(request.command == "threads");
+    CHECK(request.arguments == json::object());
+
+    CHECK_THROWS_AS(ParseVSCodeRequest(R"({"seq":5,"command":)", request), nlohmann::detail::exception);
+}
+
+// Replay requests from engine log (`--engineLogging=<file>`) transcript, provided by NETCOREDBG_DAP_TRANSCRIPT
+// environment variable (synthetic setBreakpoints requests are used otherwise). Run with "[benchmark]" tag.
+TEST_CASE("VSCodeFraming::ReplayBenchmark", "[.][benchmark]")
+{
+    std::vector<std::string> requests;
+    const char *transcript = std::getenv("NETCOREDBG_DAP_TRANSCRIPT");
+    if (transcript != nullptr)
+    {
+        static const std::string commandPrefix("-> (C) ");
+        std::ifstream input(transcript);
+        REQUIRE(input.is_open());
+        std::string line;
+        while (std::getline(input, line))
+        {
+            if (line.compare(0, commandPrefix.size(), commandPrefix) == 0)
+                requests.emplace_back(line.substr(commandPrefix.size()));
+        }
+    }
+    else
+    {
+        std::string breakpoints;
+        for (int i = 1; i <= 500; i++)
+        {
+            breakpoints += (i == 1 ? "" : ",") + std::string("{\"line\":") + std::to_string(i) + ",\"condition\":\"i > " + std::to_string(i) + "\"}";
+        }
+        for (int i = 1; i <= 1000; i++)
+        {
+            requests.emplace_back("{\"seq\":" + std::to_string(i) + ",\"type\":\"request\",\"command\":\"setBreakpoints\",\"arguments\":"
+                                  "{\"source\":{\"path\":\"/home/user/Program.cs\"},\"breakpoints\":[" + breakpoints + "]}}");
+        }
+    }
+    REQUIRE(!requests.empty());
+
+    std::string stream;
+    for (const auto &request : requests)
+    {
+        stream += Frame(request);
+    }
+
+    const unsigned repeat = 10;
+    typedef std::chrono::steady_clock Clock;
+
+    // Previous implementation: getline() header parsing, DOM for whole request, arguments copy.
+    size_t checksum = 0;
+    const auto domStart = Clock::now();
+    for (unsigned i = 0; i < repeat; i++)
+    {
+        std::istringstream input(stream);
+        std::string line;
+        while (std::getline(input, line))
+        {
+            if (line.empty() || line == "\r")
+                continue;
+
+            const size_t size = std::stoul(line.substr(sizeof("Content-Length: ") - 1));
+            std::getline(input, line);
+            std::string text(size, 0);
+            input.read(&text[0], size);
+            json request = json::parse(text);
+            auto argIter = request.find("arguments");
+            json arguments = (argIter == request.end() ? json::object() : argIter.value());
+            checksum += arguments.size();
+        }
+    }
+    const auto domTime = Clock::now() - domStart;
+
+    size_t saxChecksum = 0;
+    const auto saxStart = Clock::now();
+    for (unsigned i = 0; i < repeat; i++)
+    {
+        std::stringbuf buf(stream);
+        VSCodeFrameReader reader(&buf);
+        std::string text;
+        VSCodeRequest request;
+        while (reader.Read(text) == VSCodeFrameReader::Status::Ok && !text.empty())
+        {
+            ParseVSCodeRequest(text, request);
+            json arguments = std::move(request.arguments);
+            saxChecksum += arguments.size();
+        }
+    }
+    const auto saxTime = Clock::now() - saxStart;
+
+    CHECK(checksum == saxChecksum);
+
+    using std::chrono::microseconds;
+    using std::chrono::duration_cast;
+    WARN(requests.size() << " requests x " << repeat << ": DOM " << duration_cast<microseconds>(domTime).count()
+         << " us, framing+SAX " << duration_cast<microseconds>(saxTime).count() << " us");
+}
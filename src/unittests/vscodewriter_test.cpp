@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "json/json.hpp"
+#include "protocols/vscodewriter.h"
+#include "protocols/vscodeserializers.h"
+
+using namespace netcoredbg;
+using json = nlohmann::json;
+
+TEST_CASE("VSCodeJSONWriter::SameAsDump")
+{
+    const std::string str("q\"b\\s\n\t\x01\x1f utf8 \xd0\xbf\xd1\x80\xd0\xb8");
+
+    std::string output;
+    VSCodeJSONWriter writer(output);
+    writer.StartObject();
+    writer.Key("array");
+    writer.StartArray();
+    writer.Int(-2147483648LL);
+    writer.Int(0);
+    writer.Unsigned(4294967295u);
+    writer.StartObject();
+    writer.EndObject();
+    writer.StartArray();
+    writer.EndArray();
+    writer.Bool(true);
+    writer.Bool(false);
+    writer.EndArray();
+    writer.Key("raw");
+    writer.Raw("\"1\"");
+    writer.Key("str");
+    writer.String(str);
+    writer.EndObject();
+
+    json j;
+    j["str"] = str;
+    j["raw"] = "1";
+    j["array"] = json::array({-2147483648LL, 0, 4294967295u, json::object(), json::array(), true, false});
+
+    CHECK(output == j.dump());
+}
+
+namespace
+{
+    template <class T>
+    std::string WriteArray(const std::vector<T> &values)
+    {
+        std::string output;
+        VSCodeJSONWriter writer(output);
+        writer.StartObject();
+        WriteJSONArray(writer, "values", values);
+        writer.EndObject();
+        return output;
+    }
+
+    template <class T>
+    std::string DumpArray(const std::vector<T> &values)
+    {
+        json j;
+        j["values"] = values;
+        return j.dump();
+    }
+}
+
+TEST_CASE("VSCodeJSONWriter::SerializersSameAsDump")
+{
+    SECTION("StackFrame")
+    {
+        std::vector<StackFrame> frames(3);
+        frames[0].id = FrameId(1);
+        frames[0].methodName = "Program.Main(string[] args)";
+        frames[0].source = Source("/path/to/\"Program\".cs");
+        frames[0].line = 10;
+        frames[0].column = 5;
+        frames[0].endLine = 10;
+        frames[0].endColumn = 30;
+        frames[0].moduleId = "0e7fa6c6-4f2e-4e1b-a1e6-5e0b1c3f9a1d";
+        frames[1].id = FrameId(2);
+        frames[1].methodName = "[Native Frames]";
+        frames[1].presentationHint = "label";
+        frames[2].id = FrameId(3);
+        frames[2].methodName = "Program.<Main>d__0.MoveNext()";
+        frames[2].source = Source("/path/to/Program.cs");
+        frames[2].presentationHint = "subtle";
+
+        CHECK(WriteArray(frames) == DumpArray(frames));
+        CHECK(WriteArray(std::vector<StackFrame>()) == DumpArray(std::vector<StackFrame>()));
+    }
+
+    SECTION("Variable")
+    {
+        std::vector<Variable> variables(2);
+        variables[0].name = "str";
+        variables[0].value = "\"q\\\"\n\"";
+        variables[0].type = "string";
+        variables[0].evaluateName = "str";
+        variables[1].name = "list";
+        variables[1].value = "Count = 2";
+        variables[1].type = "System.Collections.Generic.List<int>";
+        variables[1].evaluateName = "list";
+        variables[1].variablesReference = 4294967295u;
+        variables[1].namedVariables = 3;
+
+        CHECK(WriteArray(variables) == DumpArray(variables));
+    }
+
+    SECTION("Thread")
+    {
+        std::vector<Thread> threads;
+        threads.emplace_back(ThreadId(1234), "Main Thread", true);
+        threads.emplace_back(ThreadId(5678), "<No name>", false);
+
+        CHECK(WriteArray(threads) == DumpArray(threads));
+    }
+
+    SECTION("Source")
+    {
+        std::vector<Source> sources{Source("/path/to/Program.cs"), Source("C:\\src\\Program.cs")};
+
+        CHECK(WriteArray(sources) == DumpArray(sources));
+    }
+}
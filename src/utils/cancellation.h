@@ -0,0 +1,44 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace netcoredbg
+{
+
+// Cancellation flag shared between command requester (protocol) and long running debugger operation, that check
+// it in walk cycles. Default constructed token can't be canceled (no allocation for callers without cancellation).
+class CancellationToken
+{
+public:
+
+    CancellationToken() {}
+
+    static CancellationToken Create()
+    {
+        CancellationToken token;
+        token.m_canceled = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    void Cancel() const
+    {
+        if (m_canceled)
+            *m_canceled = true;
+    }
+
+    bool IsCanceled() const
+    {
+        return m_canceled && *m_canceled;
+    }
+
+private:
+
+    std::shared_ptr<std::atomic<bool>> m_canceled;
+};
+
+} // namespace netcoredbg
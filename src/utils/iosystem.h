@@ -147,6 +147,15 @@ template <typename Traits> struct IOSystemImpl
     /// In case of error, empty file handle will be returned.
     static FileHandle listen_socket(unsigned tcp_port) { return Traits::listen_socket(tcp_port); }
 
+    /// Function creates TCP socket listening on given port, with queue for `backlog` pending
+    /// connections. Connections should be accepted by `accept_socket`, listening socket should
+    /// be closed by `close`. In case of error, empty file handle will be returned.
+    static FileHandle server_socket(unsigned tcp_port, int backlog) { return Traits::server_socket(tcp_port, backlog); }
+
+    /// Function waits and accepts single connection on socket, created by `server_socket`.
+    /// In case of error, empty file handle will be returned.
+    static FileHandle accept_socket(FileHandle listener) { return Traits::accept_socket(listener.handle); }
+
     /// Function perform reading from the file: it may read up to `count' bytes to `buf'.
     static IOResult read(FileHandle fh, void *buf, size_t count) { return Traits::read(fh.handle, buf, count); }
 
@@ -17,6 +17,13 @@
 #include <sys/stat.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+#endif
 #include <stdexcept>
 #include <algorithm>
 #include "utils/logger.h"
@@ -40,11 +47,9 @@ namespace
         Class::IOResult operator()()
         {
             // TODO need to optimize code to left only one syscall.
-            fd_set set;
-            FD_ZERO(&set);
-            FD_SET(fd, &set);
-            struct timeval tv = {0, 0};
-            ssize_t result = ::select(fd + 1, &set, NULL, &set, &tv);
+            // Note, poll() used instead of select(), since select() can't work with fd >= FD_SETSIZE.
+            struct pollfd pfd = {fd, POLLIN | POLLPRI, 0};
+            ssize_t result = ::poll(&pfd, 1, 0);
             if (result == 0)
                 return {Class::IOResult::Pending, 0};
 
@@ -59,7 +64,7 @@ namespace
                 // TODO make exception class
                 char buf[1024];
                 char msg[256];
-                snprintf(msg, sizeof(msg), "select: %s", ErrGetStr(errno, buf, sizeof(buf)));
+                snprintf(msg, sizeof(msg), "poll: %s", ErrGetStr(errno, buf, sizeof(buf)));
                 throw std::runtime_error(msg);
             }
 
@@ -72,6 +77,12 @@ namespace
             FD_SET(fd, except);
             return fd;
         }
+
+        int events(short *events) const
+        {
+            *events = POLLIN | POLLPRI;
+            return fd;
+        }
     };
 
     struct AsyncWrite
@@ -84,11 +95,8 @@ namespace
 
         Class::IOResult operator()()
         {
-            fd_set set;
-            FD_ZERO(&set);
-            FD_SET(fd, &set);
-            struct timeval tv = {0, 0};
-            ssize_t result = select(fd + 1, NULL, &set, NULL, &tv);
+            struct pollfd pfd = {fd, POLLOUT, 0};
+            ssize_t result = ::poll(&pfd, 1, 0);
             if (result == 0)
                 return {Class::IOResult::Pending, 0};
 
@@ -102,7 +110,7 @@ namespace
 
                 char buf[1024];
                 char msg[256];
-                snprintf(msg, sizeof(msg), "select: %s", ErrGetStr(errno, buf, sizeof(buf)));
+                snprintf(msg, sizeof(msg), "poll: %s", ErrGetStr(errno, buf, sizeof(buf)));
                 throw std::runtime_error(msg);
             }
 
@@ -115,6 +123,12 @@ namespace
             FD_SET(fd, write);
             return fd;
         }
+
+        int events(short *events) const
+        {
+            *events = POLLOUT;
+            return fd;
+        }
     };
 }
 
@@ -127,6 +141,9 @@ template <typename T> Class::AsyncHandle::Traits  Class::AsyncHandle::TraitsImpl
     [](void *thiz, fd_set* read, fd_set* write, fd_set* except)
         -> int { return reinterpret_cast<T*>(thiz)->poll(read, write, except); },
 
+    [](void *thiz, short *events)
+        -> int { return reinterpret_cast<T*>(thiz)->events(events); },
+
     [](void *src, void *dst)
         -> void { *reinterpret_cast<T*>(dst) = *reinterpret_cast<T*>(src); },
 
@@ -156,13 +173,13 @@ std::pair<Class::FileHandle, Class::FileHandle> Class::unnamed_pipe()
 // Function creates listening TCP socket on given port, waits, accepts single
 // connection, and return file descriptor related to the accepted connection.
 // In case of error, empty file handle will be returned.
-Class::FileHandle Class::listen_socket(unsigned port)
+// Function creates listening socket, sockets are not inherited by child processes
+// (debuggee must not hold connection with debugger client).
+Class::FileHandle Class::server_socket(unsigned port, int backlog)
 {
     assert(port > 0 && port < 65536);
 
-    int newsockfd;
-    socklen_t clilen;
-    struct sockaddr_in serv_addr, cli_addr;
+    struct sockaddr_in serv_addr;
 
     int sockFd = ::socket(AF_INET, SOCK_STREAM, 0);
     if (sockFd < 0)
@@ -191,7 +208,47 @@ Class::FileHandle Class::listen_socket(unsigned port)
         return {};
     }
 
-    ::listen(sockFd, 1);
+    if (::listen(sockFd, backlog) < 0)
+    {
+        ::close(sockFd);
+        perror("can't listen socket");
+        return {};
+    }
+
+    set_inherit(sockFd, false);
+    return sockFd;
+}
+
+Class::FileHandle Class::accept_socket(const FileHandle &fh)
+{
+    int newsockfd;
+    socklen_t clilen;
+    struct sockaddr_in cli_addr;
+
+    do
+    {
+        clilen = sizeof(cli_addr);
+        newsockfd = ::accept(fh.fd, (struct sockaddr *) &cli_addr, &clilen);
+    }
+    while (newsockfd < 0 && errno == EINTR);
+
+    if (newsockfd < 0)
+    {
+        perror("accept");
+        return {};
+    }
+
+    set_inherit(newsockfd, false);
+    return newsockfd;
+}
+
+Class::FileHandle Class::listen_socket(unsigned port)
+{
+    FileHandle listener = server_socket(port, 1);
+    if (!listener)
+        return {};
+
+    int sockFd = listener.fd;
 
 #ifdef DEBUGGER_FOR_TIZEN
     // On Tizen, launch_app won't terminate until stdin, stdout and stderr are closed.
@@ -221,16 +278,9 @@ Class::FileHandle Class::listen_socket(unsigned port)
     //TODO on Tizen redirect stderr/stdout output into dlog
 #endif
 
-    clilen = sizeof(cli_addr);
-    newsockfd = ::accept(sockFd, (struct sockaddr *) &cli_addr, &clilen);
+    FileHandle newsock = accept_socket(listener);
     ::close(sockFd);
-    if (newsockfd < 0)
-    {
-        perror("accept");
-        return {};
-    }
-
-    return newsockfd;
+    return newsock;
 }
 
 // Enable/disable handle inheritance for child processes.
@@ -284,8 +334,160 @@ Class::AsyncHandle Class::async_write(const FileHandle& fh, const void *buf, siz
 }
 
 
+#ifdef __linux__
+namespace
+{
+    // Incremented at each file descriptor close by IOSystem, see EpollSet.
+    std::atomic<unsigned> g_closeGeneration(0);
+
+    // Persistent epoll registrations of thread, that call async_wait(). File descriptors are registered at first wait
+    // and modified or removed only in case handles set changed between waits, so, wait cost don't depend on
+    // descriptors count and descriptors are not limited by FD_SETSIZE.
+    // Note, level-triggered mode is used, since async handles read/write only part of available data and
+    // edge-triggered notification for descriptor, that still have data, could be lost.
+    // Note, kernel remove closed descriptor from epoll set, so, after any close all registrations are revalidated
+    // (descriptor number could be reused for new file with same events).
+    class EpollSet
+    {
+    public:
+
+        EpollSet() : m_epfd(::epoll_create1(EPOLL_CLOEXEC)), m_closeGeneration(g_closeGeneration) {}
+        ~EpollSet() { if (m_epfd != -1) ::close(m_epfd); }
+
+        bool Wait(Class::IOSystem::AsyncHandleIterator begin, Class::IOSystem::AsyncHandleIterator end, std::chrono::milliseconds timeout);
+
+    private:
+
+        int m_epfd;
+        unsigned m_closeGeneration;
+        std::unordered_map<int, uint32_t> m_registered; // fd -> epoll events
+        std::unordered_map<int, uint32_t> m_wanted; // reused for each wait
+        std::vector<struct epoll_event> m_events; // reused for each wait
+
+        static uint32_t EpollEvents(short events)
+        {
+            return ((events & POLLIN) ? uint32_t(EPOLLIN) : 0) |
+                   ((events & POLLPRI) ? uint32_t(EPOLLPRI) : 0) |
+                   ((events & POLLOUT) ? uint32_t(EPOLLOUT) : 0);
+        }
+
+        static void ThrowError(const char *func)
+        {
+            char buf[1024];
+            char msg[256];
+            snprintf(msg, sizeof(msg), "%s: %s", func, ErrGetStr(errno, buf, sizeof(buf)));
+            throw std::runtime_error(msg);
+        }
+
+        // Return false in case descriptor don't support epoll (regular file or /dev/null, for example, stdin
+        // redirected from file), such descriptor is always ready for read and write (same as for poll() and select()).
+        bool Control(int fd, uint32_t events, bool registered)
+        {
+            struct epoll_event ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.events = events;
+            ev.data.fd = fd;
+
+            int op = registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+            if (::epoll_ctl(m_epfd, op, fd, &ev) == 0)
+                return true;
+
+            // Registration is out of sync with kernel (descriptor was closed, or reused for new file).
+            if ((op == EPOLL_CTL_MOD && errno == ENOENT) || (op == EPOLL_CTL_ADD && errno == EEXIST))
+            {
+                op = op == EPOLL_CTL_MOD ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+                if (::epoll_ctl(m_epfd, op, fd, &ev) == 0)
+                    return true;
+            }
+
+            if (op == EPOLL_CTL_ADD && errno == EPERM)
+                return false;
+
+            ThrowError("epoll_ctl");
+            return false;
+        }
+    };
+
+    bool EpollSet::Wait(Class::IOSystem::AsyncHandleIterator begin, Class::IOSystem::AsyncHandleIterator end, std::chrono::milliseconds timeout)
+    {
+        if (m_epfd == -1)
+            ThrowError("epoll_create1");
+
+        m_wanted.clear();
+        for (Class::IOSystem::AsyncHandleIterator it = begin; it != end; ++it)
+        {
+            if (!*it)
+                continue;
+
+            short events = 0;
+            int fd = it->handle.events(&events);
+            m_wanted[fd] |= EpollEvents(events);
+        }
+
+        // Level-triggered descriptor, that is not waited now, must not wake epoll_wait().
+        for (auto it = m_registered.begin(); it != m_registered.end();)
+        {
+            if (m_wanted.find(it->first) != m_wanted.end())
+            {
+                ++it;
+                continue;
+            }
+
+            // Note, error is not fatal here, descriptor could be already closed.
+            ::epoll_ctl(m_epfd, EPOLL_CTL_DEL, it->first, nullptr);
+            it = m_registered.erase(it);
+        }
+
+        const unsigned closeGeneration = g_closeGeneration;
+        const bool revalidate = closeGeneration != m_closeGeneration;
+        m_closeGeneration = closeGeneration;
+
+        bool alwaysReady = false;
+        for (const auto &wanted : m_wanted)
+        {
+            auto find = m_registered.find(wanted.first);
+            if (find == m_registered.end())
+            {
+                if (Control(wanted.first, wanted.second, false))
+                    m_registered.emplace(wanted.first, wanted.second);
+                else
+                    alwaysReady = true;
+            }
+            else if (revalidate || find->second != wanted.second)
+            {
+                if (Control(wanted.first, wanted.second, true))
+                    find->second = wanted.second;
+                else
+                {
+                    m_registered.erase(find);
+                    alwaysReady = true;
+                }
+            }
+        }
+
+        // Note, not registered descriptors are checked again at next wait, descriptor number could be reused.
+        if (alwaysReady)
+            return true;
+
+        m_events.resize(std::max<size_t>(m_wanted.size(), 1));
+        int result;
+        do result = ::epoll_wait(m_epfd, m_events.data(), int(m_events.size()), int(timeout.count()));
+        while (result < 0 && errno == EINTR);
+
+        if (result < 0)
+            ThrowError("epoll_wait");
+
+        return result > 0;
+    }
+}
+#endif // __linux__
+
 bool Class::async_wait(IOSystem::AsyncHandleIterator begin, IOSystem::AsyncHandleIterator end, std::chrono::milliseconds timeout)
 {
+#ifdef __linux__
+    static thread_local EpollSet epollSet;
+    return epollSet.Wait(begin, end, timeout);
+#else
     fd_set read_set, write_set, except_set;
     FD_ZERO(&read_set);
     FD_ZERO(&write_set);
@@ -315,6 +517,7 @@ bool Class::async_wait(IOSystem::AsyncHandleIterator begin, IOSystem::AsyncHandl
     }
 
     return result > 0;
+#endif // __linux__
 }
 
 Class::IOResult Class::async_cancel(Class::AsyncHandle& handle)
@@ -342,6 +545,9 @@ Class::IOResult Class::async_result(Class::AsyncHandle& handle)
 // Function closes the file represented by file handle.
 Class::IOResult Class::close(const FileHandle &fh)
 {
+#ifdef __linux__
+    g_closeGeneration++;
+#endif
     return { (::close(fh.fd) == 0 ? IOResult::Success : IOResult::Error), 0 };
 }
 
@@ -387,6 +593,10 @@ Class::StdIOSwap::StdIOSwap(const StdFiles& files) : m_valid(true)
             throw std::runtime_error(msg);
         }
     }
+
+#ifdef __linux__
+    g_closeGeneration++; // dup2() implicitly close standard files
+#endif
 }
 
 
@@ -406,6 +616,10 @@ Class::StdIOSwap::~StdIOSwap()
         
         ::close(m_orig_fd[n]);
     }
+
+#ifdef __linux__
+    g_closeGeneration++; // dup2() implicitly close standard files
+#endif
 }
 
 #endif  // __unix__
@@ -34,6 +34,7 @@ template <> struct netcoredbg::IOSystemTraits<netcoredbg::UnixPlatformTag>
         {
             IOResult (*oper)(void *thiz);
             int (*poll)(void *thiz, fd_set *, fd_set *, fd_set *);
+            int (*events)(void *thiz, short *);
             void (*move)(void* src, void *dst);
             void (*destr)(void *thiz);
         };
@@ -56,6 +57,13 @@ template <> struct netcoredbg::IOSystemTraits<netcoredbg::UnixPlatformTag>
             return traits->poll(data, read, write, except);
         }
 
+        // Function returns file descriptor and poll(2) events (POLLIN, POLLOUT...) handle waits for.
+        int events(short *events)
+        {
+            assert(*this);
+            return traits->events(data, events);
+        }
+
         AsyncHandle() : traits(nullptr) {}
 
         template <typename InstanceType, typename... Args>
@@ -85,6 +93,8 @@ template <> struct netcoredbg::IOSystemTraits<netcoredbg::UnixPlatformTag>
 
     static std::pair<FileHandle, FileHandle> unnamed_pipe();
     static FileHandle listen_socket(unsigned tcp_port);
+    static FileHandle server_socket(unsigned tcp_port, int backlog);
+    static FileHandle accept_socket(const FileHandle&);
     static IOResult set_inherit(const FileHandle&, bool);
     static IOResult read(const FileHandle&, void *buf, size_t count);
     static IOResult write(const FileHandle&, const void *buf, size_t count);
@@ -231,13 +231,13 @@ std::pair<Class::FileHandle, Class::FileHandle> Class::unnamed_pipe()
 // Function creates listening TCP socket on given port, waits, accepts single
 // connection, and return file descriptor related to the accepted connection.
 // In case of error, empty file handle will be returned.
-Class::FileHandle Class::listen_socket(unsigned port)
+// Function creates listening socket, sockets are not inherited by child processes
+// (debuggee must not hold connection with debugger client).
+Class::FileHandle Class::server_socket(unsigned port, int backlog)
 {
     assert(port > 0 && port < 65536);
 
-    SOCKET newsockfd;
-    int clilen;
-    struct sockaddr_in serv_addr, cli_addr;
+    struct sockaddr_in serv_addr;
 
     SOCKET sockFd = ::socket(AF_INET, SOCK_STREAM, 0);
     if (sockFd == INVALID_SOCKET)
@@ -266,18 +266,43 @@ Class::FileHandle Class::listen_socket(unsigned port)
         return {};
     }
 
-    ::listen(sockFd, 1);
+    if (::listen(sockFd, backlog) == SOCKET_ERROR)
+    {
+        ::closesocket(sockFd);
+        fprintf(stderr, "can't listen socket: %#x\n", WSAGetLastError());
+        return {};
+    }
+
+    FileHandle listener(sockFd);
+    set_inherit(listener, false);
+    return listener;
+}
 
-    clilen = sizeof(cli_addr);
-    newsockfd = ::accept(sockFd, (struct sockaddr*)&cli_addr, &clilen);
-    ::closesocket(sockFd);
+Class::FileHandle Class::accept_socket(const FileHandle &fh)
+{
+    struct sockaddr_in cli_addr;
+    int clilen = sizeof(cli_addr);
+    SOCKET newsockfd = ::accept((SOCKET)fh.handle, (struct sockaddr*)&cli_addr, &clilen);
     if (newsockfd == INVALID_SOCKET)
     {
         fprintf(stderr, "can't accept connection\n");
         return {};
     }
 
-    return FileHandle(newsockfd);
+    FileHandle newsock(newsockfd);
+    set_inherit(newsock, false);
+    return newsock;
+}
+
+Class::FileHandle Class::listen_socket(unsigned port)
+{
+    FileHandle listener = server_socket(port, 1);
+    if (!listener)
+        return {};
+
+    FileHandle newsock = accept_socket(listener);
+    ::closesocket((SOCKET)listener.handle);
+    return newsock;
 }
 
 // Function enables or disables inheritance of file handle for child processes.
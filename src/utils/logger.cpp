@@ -18,17 +18,12 @@
 #include <assert.h>
 #include <mutex>
 #include "utils/limits.h"
+#include "utils/platform.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-#include <sys/types.h>
-#include <unistd.h>
-#include <sys/syscall.h>
-#endif
-
 #include "utils/logger.h"
 
 namespace
@@ -56,30 +51,6 @@ namespace
     }
     #endif
 
-    // Function returns thread identifier.
-    unsigned get_tid()
-    {
-        #ifndef _WIN32
-        static thread_local unsigned thread_id = syscall(SYS_gettid);
-        #else
-        static thread_local unsigned thread_id = unsigned(GetCurrentThreadId());
-        #endif
-
-        return thread_id;
-    }
-
-    // Function returns process identifier.
-    int get_pid()
-    {
-        #ifndef _WIN32
-        static unsigned process_id = ::getpid();
-        #else
-        static unsigned process_id = unsigned(GetCurrentProcessId());
-        #endif
-
-        return process_id;
-    }
-
     // This function opens log file, log file name is determined
     // by contents of environment variable "LOG_OUTPUT".
     FILE* open_log_file()
@@ -144,7 +115,7 @@ extern "C" int dlog_vprint(log_priority prio, const char *tag, const char *fmt,
         return DLOG_ERROR_NOT_PERMITTED;
 
     int len = fprintf(log_file, "%lu.%03u %c/%s(P%4u, T%4u): ",
-                long(ts.tv_sec & 0x7fffff), int(ts.tv_nsec / 1000000), level, tag, get_pid(), get_tid());
+                long(ts.tv_sec & 0x7fffff), int(ts.tv_nsec / 1000000), level, tag, netcoredbg::OSProcessId(), netcoredbg::OSThreadId());
 
     int r = vfprintf(log_file, fmt, ap);
     if (r < 0) {
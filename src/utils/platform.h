@@ -41,4 +41,10 @@ namespace netcoredbg
     /// Function returns list of environment variables (like char **environ).
     char** GetSystemEnvironment();
 
+    /// Function returns identifier of current process (value is cached).
+    unsigned OSProcessId();
+
+    /// Function returns system-wide identifier of current thread (value is cached for each thread).
+    unsigned OSThreadId();
+
 } // ::netcoredbg
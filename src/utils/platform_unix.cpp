@@ -9,6 +9,7 @@
 #include <crt_externs.h>
 #endif
 #include <unistd.h>
+#include <sys/syscall.h>
 #include "utils/platform.h"
 
 extern char** environ;
@@ -41,5 +42,21 @@ char** GetSystemEnvironment()
 #endif  // __APPLE__
 }
 
+
+// Function returns identifier of current process (value is cached).
+unsigned OSProcessId()
+{
+    static unsigned process_id = ::getpid();
+    return process_id;
+}
+
+
+// Function returns system-wide identifier of current thread (value is cached for each thread).
+unsigned OSThreadId()
+{
+    static thread_local unsigned thread_id = syscall(SYS_gettid);
+    return thread_id;
+}
+
 }  // ::netcoredbg
 #endif  // __unix__
@@ -47,5 +47,21 @@ char** GetSystemEnvironment()
     return environ;
 }
 
+
+// Function returns identifier of current process (value is cached).
+unsigned OSProcessId()
+{
+    static unsigned process_id = unsigned(GetCurrentProcessId());
+    return process_id;
+}
+
+
+// Function returns system-wide identifier of current thread (value is cached for each thread).
+unsigned OSThreadId()
+{
+    static thread_local unsigned thread_id = unsigned(GetCurrentThreadId());
+    return thread_id;
+}
+
 }  // ::netcoredbg
 #endif
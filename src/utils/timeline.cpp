@@ -0,0 +1,164 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <fstream>
+#include <mutex>
+#include <stdio.h>
+#include "utils/timeline.h"
+#include "utils/platform.h"
+
+namespace netcoredbg
+{
+
+namespace Timeline
+{
+
+namespace Internal
+{
+    std::atomic<bool> enabled(false);
+}
+
+namespace
+{
+
+    // Buffered events are written into file in case buffer reach this size, or at Stop() call.
+    const size_t FlushSize = 64 * 1024;
+
+    std::mutex timelineMutex;
+    std::ofstream output;
+    std::string buffer;
+    Clock::time_point startTime;
+
+    void AppendEscaped(std::string &out, const char *str)
+    {
+        for (; *str; str++)
+        {
+            const char c = *str;
+            switch (c)
+            {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n";  break;
+                case '\r': out += "\\r";  break;
+                case '\t': out += "\\t";  break;
+                default:
+                    if ((unsigned char)c < 0x20)
+                    {
+                        char tmp[8];
+                        snprintf(tmp, sizeof(tmp), "\\u%04x", (unsigned)c);
+                        out += tmp;
+                    }
+                    else
+                        out += c;
+                    break;
+            }
+        }
+    }
+
+    unsigned long long Microseconds(Clock::time_point time)
+    {
+        return time > startTime ? std::chrono::duration_cast<std::chrono::microseconds>(time - startTime).count() : 0;
+    }
+
+    // Caller must care about timelineMutex.
+    void FlushBuffer()
+    {
+        if (buffer.empty())
+            return;
+
+        output.write(buffer.data(), buffer.size());
+        output.flush();
+        buffer.clear();
+    }
+
+    // Caller must care about timelineMutex.
+    // Note, each event is written with leading separator (first entry is metadata event, see Start()), so, flushed
+    // part of file is valid trace even without closing "]" (trace viewers accept JSON array without closing bracket).
+    void AddEvent(char phase, const char *name, const char *category, Clock::time_point start, Clock::time_point end,
+                  const std::string &detail)
+    {
+        if (!output.is_open())
+            return;
+
+        char tmp[128];
+        buffer += ",\n{\"name\":\"";
+        AppendEscaped(buffer, name);
+        buffer += "\",\"cat\":\"";
+        AppendEscaped(buffer, category);
+        if (phase == 'X')
+            snprintf(tmp, sizeof(tmp), "\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":%u,\"tid\":%u",
+                     Microseconds(start), Microseconds(end) - Microseconds(start), OSProcessId(), OSThreadId());
+        else
+            snprintf(tmp, sizeof(tmp), "\",\"ph\":\"%c\",\"s\":\"t\",\"ts\":%llu,\"pid\":%u,\"tid\":%u",
+                     phase, Microseconds(start), OSProcessId(), OSThreadId());
+        buffer += tmp;
+        if (!detail.empty())
+        {
+            buffer += ",\"args\":{\"detail\":\"";
+            AppendEscaped(buffer, detail.c_str());
+            buffer += "\"}";
+        }
+        buffer += "}";
+
+        if (buffer.size() >= FlushSize)
+            FlushBuffer();
+    }
+
+} // unnamed namespace
+
+void Internal::AddComplete(const char *name, const char *category, Clock::time_point start, Clock::time_point end, const std::string &detail)
+{
+    std::lock_guard<std::mutex> lock(timelineMutex);
+    AddEvent('X', name, category, start, end, detail);
+}
+
+bool Start(const std::string &outputFile)
+{
+    std::lock_guard<std::mutex> lock(timelineMutex);
+
+    if (output.is_open())
+        return false;
+
+    output.open(outputFile, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+        return false;
+
+    startTime = Clock::now();
+    buffer = "[";
+    // Metadata event, process name shown by trace viewer instead of pid.
+    char tmp[128];
+    snprintf(tmp, sizeof(tmp), "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"netcoredbg\"}}", OSProcessId());
+    buffer += tmp;
+    FlushBuffer();
+
+    Internal::enabled = true;
+    return true;
+}
+
+void Stop()
+{
+    std::lock_guard<std::mutex> lock(timelineMutex);
+
+    if (!output.is_open())
+        return;
+
+    Internal::enabled = false;
+    buffer += "\n]\n";
+    FlushBuffer();
+    output.close();
+}
+
+void Instant(const char *name, const char *category, const std::string &detail)
+{
+    if (!IsEnabled())
+        return;
+
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(timelineMutex);
+    AddEvent('i', name, category, now, now, detail);
+}
+
+} // namespace Timeline
+
+} // namespace netcoredbg
@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace netcoredbg
+{
+
+// Debugger's own timeline (startup phases, callbacks, protocol requests) written in Chrome trace event format
+// (JSON array of events), file could be opened by chrome://tracing or https://ui.perfetto.dev.
+// Disabled timeline cost is one relaxed atomic load per scope, no clock calls and no allocations.
+namespace Timeline
+{
+    typedef std::chrono::steady_clock Clock;
+
+    // All definitions in this namespace intendent only for internal usage.
+    namespace Internal
+    {
+        extern std::atomic<bool> enabled;
+
+        void AddComplete(const char *name, const char *category, Clock::time_point start, Clock::time_point end, const std::string &detail);
+    }
+
+    inline bool IsEnabled()
+    {
+        return Internal::enabled.load(std::memory_order_relaxed);
+    }
+
+    // Open trace file and start events recording, return false in case file can't be opened.
+    bool Start(const std::string &outputFile);
+    // Write buffered events and close trace file. Could be called few times, for example, at exit.
+    void Stop();
+
+    // Point in time event, for example, first stop of debuggee process.
+    void Instant(const char *name, const char *category, const std::string &detail = std::string());
+
+    // Duration event from constructor to destructor call. Note, name and category are not copied at construction,
+    // they must live till scope end (string literals or strings owned by caller).
+    class Scope
+    {
+    public:
+
+        Scope(const char *name, const char *category) :
+            m_name(name),
+            m_category(category),
+            m_enabled(Timeline::IsEnabled())
+        {
+            if (m_enabled)
+                m_start = Clock::now();
+        }
+
+        ~Scope()
+        {
+            if (m_enabled)
+                Internal::AddComplete(m_name, m_category, m_start, Clock::now(), m_detail);
+        }
+
+        bool IsEnabled() const { return m_enabled; }
+
+        // Additional event data (shown in "args" of event), should be set only in case IsEnabled() return true,
+        // in order to avoid string creation cost for disabled timeline.
+        void SetDetail(const std::string &detail) { m_detail = detail; }
+
+    private:
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        const char *m_name;
+        const char *m_category;
+        const bool m_enabled;
+        Clock::time_point m_start;
+        std::string m_detail;
+    };
+
+} // namespace Timeline
+
+} // namespace netcoredbg
@@ -0,0 +1,173 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <cstring>
+#include <iterator>
+#include "utils/tracefile.h"
+
+namespace netcoredbg
+{
+
+namespace TraceFile
+{
+
+namespace
+{
+
+    const char TraceMagic[8] = {'N', 'C', 'D', 'B', 'T', 'R', 'C', '1'};
+
+    template <class T>
+    void AppendInt(std::vector<char> &buffer, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            buffer.push_back(char(uint64_t(value) >> (i * 8)));
+        }
+    }
+
+    void AppendString(std::vector<char> &buffer, const std::string &str)
+    {
+        AppendInt<uint32_t>(buffer, uint32_t(str.size()));
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+
+    size_t StringSize(const std::string &str)
+    {
+        return sizeof(uint32_t) + str.size();
+    }
+
+    size_t StringsSize(const std::vector<std::string> &strings)
+    {
+        size_t size = sizeof(uint16_t);
+        for (const auto &str : strings)
+        {
+            size += StringSize(str);
+        }
+        return size;
+    }
+
+    void AppendStrings(std::vector<char> &buffer, const std::vector<std::string> &strings)
+    {
+        AppendInt<uint16_t>(buffer, uint16_t(strings.size()));
+        for (const auto &str : strings)
+        {
+            AppendString(buffer, str);
+        }
+    }
+
+    template <class T>
+    bool ReadInt(std::istream &input, T &value)
+    {
+        unsigned char data[sizeof(T)];
+        if (!input.read((char*)data, sizeof(T)))
+            return false;
+
+        uint64_t result = 0;
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            result |= uint64_t(data[i]) << (i * 8);
+        }
+        value = T(result);
+        return true;
+    }
+
+    bool ReadString(std::istream &input, std::string &str)
+    {
+        // Protect from huge allocation for broken file.
+        static const uint32_t maxStringSize = 64 * 1024 * 1024;
+        uint32_t size;
+        if (!ReadInt(input, size) || size > maxStringSize)
+            return false;
+
+        str.resize(size);
+        return size == 0 || input.read(&str[0], size);
+    }
+
+    bool ReadStrings(std::istream &input, std::vector<std::string> &strings)
+    {
+        uint16_t count;
+        if (!ReadInt(input, count))
+            return false;
+
+        strings.resize(count);
+        for (auto &str : strings)
+        {
+            if (!ReadString(input, str))
+                return false;
+        }
+        return true;
+    }
+
+} // unnamed namespace
+
+void AppendHeader(std::vector<char> &buffer, uint64_t startTimeUs)
+{
+    buffer.insert(buffer.end(), std::begin(TraceMagic), std::end(TraceMagic));
+    AppendInt<uint64_t>(buffer, startTimeUs);
+}
+
+size_t DefinitionSize(const std::string &location, const std::vector<std::string> &expressions)
+{
+    return 1 + sizeof(uint32_t) + StringSize(location) + StringsSize(expressions);
+}
+
+void AppendDefinition(std::vector<char> &buffer, uint32_t id, const std::string &location, const std::vector<std::string> &expressions)
+{
+    buffer.push_back(DefinitionRecord);
+    AppendInt<uint32_t>(buffer, id);
+    AppendString(buffer, location);
+    AppendStrings(buffer, expressions);
+}
+
+size_t HitSize(const std::vector<std::string> &values)
+{
+    return 1 + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t) + StringsSize(values);
+}
+
+void AppendHit(std::vector<char> &buffer, uint32_t id, uint64_t timeUs, uint32_t threadId, const std::vector<std::string> &values)
+{
+    buffer.push_back(HitRecord);
+    AppendInt<uint32_t>(buffer, id);
+    AppendInt<uint64_t>(buffer, timeUs);
+    AppendInt<uint32_t>(buffer, threadId);
+    AppendStrings(buffer, values);
+}
+
+bool Reader::ReadHeader(uint64_t &startTimeUs)
+{
+    char magic[sizeof(TraceMagic)];
+    return m_input.read(magic, sizeof(magic)) && memcmp(magic, TraceMagic, sizeof(TraceMagic)) == 0 &&
+           ReadInt(m_input, startTimeUs);
+}
+
+Reader::Status Reader::ReadRecord(Record &record)
+{
+    char recordType;
+    if (!m_input.get(recordType))
+        return End;
+
+    if (recordType == DefinitionRecord)
+    {
+        record.type = DefinitionRecord;
+        if (!ReadInt(m_input, record.id) || !ReadString(m_input, record.location) || !ReadStrings(m_input, record.strings))
+            return End;
+
+        return Ok;
+    }
+    else if (recordType == HitRecord)
+    {
+        record.type = HitRecord;
+        if (!ReadInt(m_input, record.id) || !ReadInt(m_input, record.timeUs) || !ReadInt(m_input, record.threadId) ||
+            !ReadStrings(m_input, record.strings))
+            return End;
+
+        return Ok;
+    }
+
+    return UnknownRecord;
+}
+
+} // namespace TraceFile
+
+} // namespace netcoredbg
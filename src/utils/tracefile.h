@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Binary trace file format for tracepoints hits recording (all integers are little-endian):
+//   header: "NCDBTRC1", u64 recording start time (microseconds from epoch);
+//   tracepoint definition: u8 'D', u32 tracepoint id, str location, u16 expressions count, str expression...;
+//   hit:                   u8 'H', u32 tracepoint id, u64 time from start (microseconds), u32 thread id, u16 values count, str value...;
+//   str: u32 size, UTF-8 data.
+// Definition is written before first hit of tracepoint and again in case tracepoint was changed, reader use last one.
+namespace TraceFile
+{
+    enum RecordType : char
+    {
+        DefinitionRecord = 'D',
+        HitRecord = 'H'
+    };
+
+    // Serialization into memory buffer, "Size" functions return record size in bytes.
+    void AppendHeader(std::vector<char> &buffer, uint64_t startTimeUs);
+    size_t DefinitionSize(const std::string &location, const std::vector<std::string> &expressions);
+    void AppendDefinition(std::vector<char> &buffer, uint32_t id, const std::string &location, const std::vector<std::string> &expressions);
+    size_t HitSize(const std::vector<std::string> &values);
+    void AppendHit(std::vector<char> &buffer, uint32_t id, uint64_t timeUs, uint32_t threadId, const std::vector<std::string> &values);
+
+    struct Record
+    {
+        RecordType type;
+        uint32_t id;
+        std::string location;             // definition only
+        std::vector<std::string> strings; // definition expressions or hit values
+        uint64_t timeUs;                  // hit only
+        uint32_t threadId;                // hit only
+
+        Record() : type(DefinitionRecord), id(0), timeUs(0), threadId(0) {}
+    };
+
+    class Reader
+    {
+    public:
+
+        enum Status
+        {
+            Ok,
+            End,          // file end or incomplete record at file end (debugger crash during recording)
+            UnknownRecord
+        };
+
+        Reader(std::istream &input) : m_input(input) {}
+
+        // Return false in case of wrong file format.
+        bool ReadHeader(uint64_t &startTimeUs);
+        // Note, record's strings are reused, so, same record object could be provided for all file records.
+        Status ReadRecord(Record &record);
+
+    private:
+
+        std::istream &m_input;
+    };
+
+} // namespace TraceFile
+
+} // namespace netcoredbg
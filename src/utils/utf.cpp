@@ -10,7 +10,8 @@
 namespace netcoredbg
 {
 
-static std::wstring_convert<std::codecvt_utf8_utf16<WCHAR>,WCHAR> convert;
+// Note, std::wstring_convert have internal state and can't be used by few threads (debug sessions) at same time.
+static thread_local std::wstring_convert<std::codecvt_utf8_utf16<WCHAR>,WCHAR> convert;
 
 std::string to_utf8(const WCHAR *wstr)
 {
@@ -112,6 +112,26 @@ namespace NetcoreDbgTest.Script
             Assert.Equal(val, curValue, @"__FILE__:__LINE__"+"\n"+caller_trace);
         }
 
+        public void CreateAndCompareVarBatch(string caller_trace, string[] variables, string[] values)
+        {
+            var res = MIDebugger.Request("-var-create-batch \"" + String.Join("\" \"", variables) + "\"");
+            Assert.Equal(MIResultClass.Done, res.Class, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var vars = (MIList)res["vars"];
+            Assert.Equal(variables.Length, vars.Count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            for (int i = 0; i < variables.Length; i++)
+            {
+                var entry = (MITuple)vars[i];
+                if (values[i] == null)
+                {
+                    Assert.Equal(variables[i], ((MIConst)entry["exp"]).CString, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                    Assert.NotNull(entry["error"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+                    continue;
+                }
+                Assert.Equal(values[i], ((MIConst)entry["value"]).CString, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            }
+        }
+
         public void GetAndCheckChildValue(string caller_trace, string ExpectedResult, string variable,
                                           int childIndex, bool setEvalFlags, enum_EVALFLAGS evalFlags, string expectedAttributes = "editable")
         {
@@ -1279,6 +1299,10 @@ namespace MITestVariables
                 Context.CreateAndCompareVar(@"__FILE__:__LINE__", "test_arg_f", "5");
                 Context.CreateAndCompareVar(@"__FILE__:__LINE__", "test_arg_string", "\\\"test_string\\\"");
 
+                Context.CreateAndCompareVarBatch(@"__FILE__:__LINE__",
+                                                 new string[] {"test_arg_i", "test_arg_unknown", "test_arg_f"},
+                                                 new string[] {"10", null, "5"});
+
                 Context.CreateAndAssignVar(@"__FILE__:__LINE__", "test_arg_i", "20");
                 Context.CreateAndAssignVar(@"__FILE__:__LINE__", "test_arg_f", "50");
                 Context.CreateAndAssignVar(@"__FILE__:__LINE__", "test_arg_string", "\"edited_string\"", true);
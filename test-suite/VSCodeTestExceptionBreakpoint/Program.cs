@@ -686,7 +686,7 @@ namespace VSCodeTestExceptionBreakpoint
 
             // test filter "user-unhandled" with options "System.NullReferenceException" ("user-unhandled" for "System.NullReferenceException" only)
 
-            for (int i = 0; i < 2; ++i)
+            for (int i = 0; i < 3; ++i)
             {
                 outside_user_code_wrapper.call_with_catch(inside_user_code.throw_Exception);
                 outside_user_code_wrapper.call_with_catch(inside_user_code.throw_NullReferenceException);   Label.Breakpoint("bp_test_9");
@@ -707,7 +707,23 @@ namespace VSCodeTestExceptionBreakpoint
 
             // test filter "user-unhandled" with options "!System.Exception" ("user-unhandled" for all except "System.Exception")
 
-            Label.Checkpoint("test_user_unhandled_except_concrete_exception", "test_vscode_1", (Object context) => {
+            Label.Checkpoint("test_user_unhandled_except_concrete_exception", "test_user_unhandled_base_exception", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp_test_9");
+                Context.Continue(@"__FILE__:__LINE__");
+                Context.WasExceptionBreakpointHit(@"__FILE__:__LINE__", "bp4", "CLR", "userUnhandled", "System.NullReferenceException");
+
+                Context.ResetExceptionBreakpoints();
+                Context.AddExceptionBreakpointFilterUserUnhandledWithOptions("System.SystemException");
+                Context.SetExceptionBreakpoints(@"__FILE__:__LINE__");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            // test filter "user-unhandled" with options "System.SystemException" (base type also covers derived "System.NullReferenceException",
+            // but not "System.Exception")
+
+            Label.Checkpoint("test_user_unhandled_base_exception", "test_vscode_1", (Object context) => {
                 Context Context = (Context)context;
                 Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp_test_9");
                 Context.Continue(@"__FILE__:__LINE__");
@@ -0,0 +1,70 @@
+#!/bin/bash
+
+# Run tests in parallel against one multi-session debugger server, each test is own debug session (connection).
+# Usage: run_multi_session_test.sh <netcoredbg> <protocol> <port> <test name>...
+
+NETCOREDBG=$1
+PROTO=$2
+PORT=$3
+shift 3
+
+# Sessions are started at same time, build all first (TestRunner too, it can't be built by parallel `dotnet run`).
+for TEST_NAME in TestRunner "$@"; do
+    dotnet build $TEST_NAME || exit $?
+done
+
+LOG_DIR=$(mktemp -d)
+$NETCOREDBG --server=$PORT --multi-session --interpreter=$PROTO &
+server_pid=$!
+trap "kill $server_pid 2>/dev/null; rm -rf $LOG_DIR" EXIT
+
+# Wait for listening socket. Note, probe connection is closed without any request, server must end this session
+# without influence on other sessions.
+for i in $(seq 100); do
+    if (exec 3<>/dev/tcp/localhost/$PORT) 2>/dev/null; then
+        break
+    fi
+    if ! kill -0 $server_pid 2>/dev/null; then
+        echo "Multi-session server exited before listening on port $PORT" >&2
+        exit 1
+    fi
+    sleep 0.1
+done
+
+declare -A session_pids
+for TEST_NAME in "$@"; do
+    SOURCE_FILES=""
+    for file in `find $TEST_NAME \! -path "$TEST_NAME/obj/*" -type f -name "*.cs"`; do
+        SOURCE_FILES="${SOURCE_FILES}${file};"
+    done
+
+    echo "Multi-session server: $TEST_NAME session started"
+
+    dotnet run --no-build --project TestRunner -- \
+        --tcp localhost $PORT \
+        --proto $PROTO \
+        --test $TEST_NAME \
+        --sources "$SOURCE_FILES" \
+        --assembly $TEST_NAME/bin/Debug/netcoreapp3.1/$TEST_NAME.dll > $LOG_DIR/$TEST_NAME.log 2>&1 &
+    session_pids[$TEST_NAME]=$!
+done
+
+res=0
+for TEST_NAME in "$@"; do
+    wait ${session_pids[$TEST_NAME]}
+    session_res=$?
+
+    echo "Multi-session server: $TEST_NAME session finished, res=$session_res"
+    cat $LOG_DIR/$TEST_NAME.log
+    if [ "$session_res" -ne "0" ]; then
+        res=$session_res
+    fi
+done
+
+# Sessions end must not affect server.
+if ! kill -0 $server_pid 2>/dev/null; then
+    echo "Multi-session server exited after sessions end" >&2
+    exit 1
+fi
+
+exit $res
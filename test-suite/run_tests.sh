@@ -85,6 +85,8 @@ ALL_TEST_NAMES=(
     "VSCodeTestExtensionMethods"
     "VSCodeTestBreakpointWithoutStop"
     "VSCodeTestUnhandledException"
+    "MITestMultiSession"
+    "VSCodeTestMultiSession"
 )
 
 # Skipped tests:
@@ -180,7 +182,40 @@ test_timeout()(
 
 trap "jobs -p | xargs -r -n 1 kill --" EXIT
 
+report_result()
+{
+    local TEST_NAME=$1
+    local res=$2
+
+    if [ "$res" -ne "0" ]; then
+        test_fail=$(($test_fail + 1))
+        test_list="$test_list$TEST_NAME ... failed res=$res\n"
+        test_xml[test_count]="$TEST_NAME\"><failure></failure></testcase>"
+    else
+        test_pass=$(($test_pass + 1))
+        test_list="$test_list$TEST_NAME ... passed\n"
+        test_xml[test_count]="$TEST_NAME\"></testcase>"
+    fi
+    test_count=$(($test_count + 1))
+}
+
 for TEST_NAME in $TEST_NAMES; do
+    # Not a test project, run sessions of existing tests in parallel against one multi-session debugger server
+    # (each session must work with own debugger).
+    if [[ $TEST_NAME == *MultiSession ]] ;
+    then
+        if [[ $TEST_NAME == VSCode* ]] ;
+        then
+            test_timeout $TIMEOUT ./run_multi_session_test.sh "$NETCOREDBG" vscode ${MULTI_SESSION_PORT:-4711} \
+                VSCodeTestBreakpoint VSCodeTestStepping
+        else
+            test_timeout $TIMEOUT ./run_multi_session_test.sh "$NETCOREDBG" mi ${MULTI_SESSION_PORT:-4711} \
+                MITestBreakpoint MITestStepping
+        fi
+        report_result $TEST_NAME $?
+        continue
+    fi
+
     dotnet build $TEST_NAME || {
         echo "$TEST_NAME: build error." >&2
         test_fail=$(($test_fail + 1))
@@ -244,18 +279,7 @@ for TEST_NAME in $TEST_NAMES; do
     fi
 
 
-    res=$?
-
-    if [ "$res" -ne "0" ]; then
-        test_fail=$(($test_fail + 1))
-        test_list="$test_list$TEST_NAME ... failed res=$res\n"
-        test_xml[test_count]="$TEST_NAME\"><failure></failure></testcase>"
-    else
-        test_pass=$(($test_pass + 1))
-        test_list="$test_list$TEST_NAME ... passed\n"
-        test_xml[test_count]="$TEST_NAME\"></testcase>"
-    fi
-    test_count=$(($test_count + 1))
+    report_result $TEST_NAME $?
 done
 
 if [[ $code_coverage_report == true ]]; then